@@ -0,0 +1,108 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <cynq/datamover.hpp>
+#include <cynq/hardware.hpp>
+#include <cynq/memory.hpp>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @example alveo/host-staging.cpp
+ *
+ * Benchmark of the host-to-device throughput against the placement of the
+ * host staging memory (see HostMemoryOptions). It uploads a dual buffer
+ * whose host side is allocated:
+ *
+ * - With the default placement of XRT.
+ * - On the given NUMA node with regular, 2 MiB and 1 GiB pages.
+ *
+ * The placements are strict, so the ones that are not available in the
+ * host (i.e. no huge pages reserved) are reported instead of measured.
+ * Use the NUMA node of the card (/sys/bus/pci/devices/<bdf>/numa_node).
+ *
+ * Running: ./builddir/examples/host-staging-alveo [size MiB] [numa node]
+ * [iterations]
+ */
+
+#if !defined(EXAMPLE_ALVEO_VADD_XCLBIN_LOCATION)
+#error "Missing location macros for example"
+#endif
+
+// Given by the example. Any xclbin works since there are no kernels
+static constexpr char kXclBin[] = EXAMPLE_ALVEO_VADD_XCLBIN_LOCATION;
+
+using namespace cynq;  // NOLINT
+
+struct Placement {
+  std::string name;
+  HostMemoryOptions options;
+};
+
+int main(int argc, char **argv) {
+  const size_t size = (argc > 1 ? std::stoul(argv[1]) : 256) << 20;
+  const int node = argc > 2 ? std::stoi(argv[2]) : 0;
+  const int iterations = argc > 3 ? std::stoi(argv[3]) : 20;
+
+  std::cout << "----- Initialising platform -----" << std::endl;
+  std::shared_ptr<IHardware> platform =
+      IHardware::Create(HardwareArchitecture::Alveo, kXclBin);
+  std::shared_ptr<IDataMover> mover = platform->GetDataMover(0);
+
+  std::vector<Placement> placements(4);
+  placements[0].name = "Default";
+  placements[1].name = "4 KiB pages";
+  placements[2].name = "2 MiB pages";
+  placements[2].options.page_size = HostMemoryOptions::kHugePage2M;
+  placements[3].name = "1 GiB pages";
+  placements[3].options.page_size = HostMemoryOptions::kHugePage1G;
+  for (size_t i = 1; i < placements.size(); ++i) {
+    placements[i].options.numa_node = node;
+    placements[i].options.strict = true;
+  }
+
+  std::cout << "----- Host-to-device throughput: " << (size >> 20)
+            << " MiB, NUMA node " << node << " -----" << std::endl;
+
+  for (const auto &placement : placements) {
+    std::cout << std::setw(14) << placement.name << ": ";
+
+    Status st = mover->SetHostMemoryOptions(placement.options);
+    std::shared_ptr<IMemory> mem;
+    if (Status::OK == st.code) {
+      st = mover->AllocateBuffer(size, mem, 0, MemoryType::Dual);
+    }
+    if (st.code != Status::OK) {
+      std::cout << "unavailable (" << st.msg << ")" << std::endl;
+      continue;
+    }
+
+    auto data = mem->HostSpan<uint8_t>();
+    std::fill(data.begin(), data.end(), 0xA5);
+
+    // Warm-up: the first transfer pins and maps the pages
+    mover->Upload(mem, size, 0, ExecutionType::Sync);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+      mover->Upload(mem, size, 0, ExecutionType::Sync);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> elapsed = end - start;
+    const double bytes = static_cast<double>(size) * iterations;
+    std::cout << bytes / elapsed.count() / 1e9 << " GB/s" << std::endl;
+  }
+
+  return 0;
+}
@@ -11,8 +11,10 @@
 #include <cynq/datamover.hpp>
 #include <cynq/hardware.hpp>
 #include <cynq/memory.hpp>
+#include <cynq/placement.hpp>
 #include <iostream>
 #include <string>
+#include <vector>
 
 /**
  * @example alveo/vadd-host.cpp
@@ -49,15 +51,27 @@ int main(int argc, char **argv) {
   // Get a data mover
   std::shared_ptr<IDataMover> mover = platform->GetDataMover(0);
 
-  // Create buffers for input and output
+  // Create buffers for input and output in the banks connected to the
+  // kernel arguments
   std::cout << "----- Creating memory -----" << std::endl;
   std::size_t vec_size = sizeof(int) * kDataSize;
-  std::shared_ptr<IMemory> bo_0 =
-      mover->GetBuffer(vec_size, accel->GetMemoryBank(0));
-  std::shared_ptr<IMemory> bo_1 =
-      mover->GetBuffer(vec_size, accel->GetMemoryBank(1));
-  std::shared_ptr<IMemory> bo_out =
-      mover->GetBuffer(vec_size, accel->GetMemoryBank(2));
+  PlacementPlanner planner;
+  planner.AddTensor("in0", vec_size, {{accel, 0}});
+  planner.AddTensor("in1", vec_size, {{accel, 1}});
+  planner.AddTensor("out", vec_size, {{accel, 2}});
+
+  std::vector<PlacementBankUsage> usage;
+  planner.Plan(usage);
+  for (const auto &bank : usage) {
+    std::cout << "\tBank " << bank.bank << ": " << bank.tensors
+              << " tensors, " << bank.traffic << " bytes/run" << std::endl;
+  }
+
+  std::vector<std::shared_ptr<IMemory>> buffers;
+  planner.Allocate(mover, buffers);
+  std::shared_ptr<IMemory> bo_0 = buffers[0];
+  std::shared_ptr<IMemory> bo_1 = buffers[1];
+  std::shared_ptr<IMemory> bo_out = buffers[2];
 
   // Get the host pointers for input/outut
   auto bo_0_map = bo_0->HostAddress<int>().get();
@@ -0,0 +1,120 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <cynq/cynq.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+/**
+ * @example structures/buffer-ring.cpp
+ *
+ * Benchmark of a streaming pipeline with single, double and triple
+ * buffering. Each frame goes through three stages of similar cost:
+ *
+ * - Producer: the host fills the input buffer.
+ * - DMA: the execution stream moves the frame (mocked by a sleep, as the
+ *   upload, the accelerator and the download do not use the CPU).
+ * - Consumer: another host thread reads the output buffer.
+ *
+ * The buffers go around a BufferRing. With one slot, the stages are
+ * serialised; with two or more, they overlap and the frame rate is bounded
+ * by the slowest stage.
+ *
+ * Running: ./builddir/examples/buffer-ring [frames]
+ */
+
+// Size of each frame
+static constexpr size_t kFrameSize = 1 << 20;
+// Time spent by the mocked DMA on each frame
+static constexpr auto kTransferTime = std::chrono::milliseconds(2);
+// Time spent by the producer and the consumer on each frame
+static constexpr auto kHostTime = std::chrono::milliseconds(2);
+
+using namespace cynq;  // NOLINT
+
+// Busy wait, as the host stages use the CPU
+static void Work(const std::chrono::steady_clock::duration time) {
+  auto end = std::chrono::steady_clock::now() + time;
+  while (std::chrono::steady_clock::now() < end) {
+  }
+}
+
+int main(int argc, char **argv) {
+  const size_t frames = argc > 1 ? std::stoul(argv[1]) : 200;
+
+  std::cout << "----- Buffer ring: " << frames << " frames -----"
+            << std::endl;
+
+  for (size_t slots = 1; slots <= 3; ++slots) {
+    /* Host buffers: input and output of each slot */
+    std::vector<std::vector<uint8_t>> storage(2 * slots,
+                                              std::vector<uint8_t>(kFrameSize));
+    std::vector<std::vector<std::shared_ptr<IMemory>>> buffers(slots);
+    for (size_t i = 0; i < storage.size(); ++i) {
+      uint8_t *ptr = storage[i].data();
+      buffers[i / 2].push_back(
+          IMemory::Create(IMemory::XRT, kFrameSize, ptr, ptr, nullptr));
+    }
+
+    auto stream =
+        IExecutionGraph::Create(IExecutionGraph::Type::STREAM, nullptr);
+    BufferRing ring{stream, buffers};
+
+    /* Mocked DMA: moves the input into the output */
+    BufferRing::Stage transfer = [](BufferRingSlot &slot) -> Status {
+      std::this_thread::sleep_for(kTransferTime);
+      auto in = slot.buffers[0]->HostSpan<uint8_t>();
+      auto out = slot.buffers[1]->HostSpan<uint8_t>();
+      std::copy(in.begin(), in.end(), out.begin());
+      return Status{};
+    };
+
+    size_t errors = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread consumer([&] {
+      for (size_t frame = 0; frame < frames; ++frame) {
+        BufferRingSlot *slot = nullptr;
+        /* Wait until the producer submits the frame */
+        while (!(slot = ring.AcquireRead())) {
+          std::this_thread::yield();
+        }
+        auto out = slot->buffers[1]->HostSpan<uint8_t>();
+        if (slot->result.code != Status::OK ||
+            out[0] != static_cast<uint8_t>(slot->sequence)) {
+          errors++;
+        }
+        Work(kHostTime);
+        ring.Release(slot);
+      }
+    });
+
+    for (size_t frame = 0; frame < frames; ++frame) {
+      BufferRingSlot *slot = ring.AcquireWrite();
+      auto in = slot->buffers[0]->HostSpan<uint8_t>();
+      std::fill(in.begin(), in.end(), static_cast<uint8_t>(frame));
+      Work(kHostTime);
+      ring.Submit(slot, transfer);
+    }
+
+    consumer.join();
+    auto end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> elapsed = end - start;
+    std::cout << "Slots: " << slots << " Time (s): " << elapsed.count()
+              << " Frames/s: " << frames / elapsed.count()
+              << " Errors: " << errors << std::endl;
+  }
+
+  return 0;
+}
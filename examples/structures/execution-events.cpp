@@ -0,0 +1,72 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <atomic>  // NOLINT
+#include <chrono>  // NOLINT
+#include <cynq/cynq.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+
+/**
+ * @example structures/execution-events.cpp
+
+ * This is a sample use case of the execution events. A producer stream runs
+ * three tasks of 100 ms and records an event after the first and the last
+ * ones. A consumer stream waits for the last event before running its task.
+ * The host only schedules the work: it does not block until the final
+ * synchronisation. The elapsed time between both events is reported.
+ */
+
+volatile std::atomic_int num{0};
+
+cynq::IExecutionGraph::Function task(const std::string &name) {
+  return [name]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::cout << "task: " << name << " num: " << num.load() << std::endl;
+    num++;
+    return cynq::Status{};
+  };
+}
+
+int main(int, char **) {
+  auto type = cynq::IExecutionGraph::Type::STREAM;
+  auto producer = cynq::IExecutionGraph::Create(type, nullptr);
+  auto consumer = cynq::IExecutionGraph::Create(type, nullptr);
+
+  auto start = cynq::ExecutionEvent::Create();
+  auto end = cynq::ExecutionEvent::Create();
+
+  auto host_start = std::chrono::steady_clock::now();
+
+  producer->Add(task("P0"));
+  producer->RecordEvent(start);
+  producer->Add(task("P1"));
+  producer->Add(task("P2"));
+  producer->RecordEvent(end);
+
+  consumer->WaitEvent(end);
+  consumer->Add(task("C0"));
+
+  std::chrono::duration<double, std::milli> host_time =
+      std::chrono::steady_clock::now() - host_start;
+  std::cout << "Scheduling time in host (ms): " << host_time.count()
+            << std::endl;
+  std::cout << "End event pending: "
+            << (end->Query().code == cynq::Status::RESOURCE_BUSY)
+            << std::endl;
+
+  consumer->Sync();
+  std::cout << "Synchronised w.r.t. the consumer" << std::endl;
+
+  float elapsed = 0.f;
+  cynq::ExecutionEvent::ElapsedTime(start, end, elapsed);
+  std::cout << "Elapsed time between events (ms): " << elapsed << std::endl;
+
+  return 0;
+}
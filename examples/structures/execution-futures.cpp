@@ -0,0 +1,114 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cynq/cynq.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+/**
+ * @example structures/execution-futures.cpp
+ *
+ * Proof-of-concept of the futures of the asynchronous operations. A server
+ * receives many requests at once. Each request performs a mocked upload,
+ * execution and download on the same stream. The requests do not block any
+ * thread while waiting for their operations:
+ *
+ * - In C++20, each request is a coroutine that awaits the futures.
+ * - In C++17, each request chains the operations through callbacks.
+ *
+ * In both cases, the host thread only submits the requests, and the worker
+ * of the stream resumes them as the operations complete.
+ *
+ * Running: ./builddir/examples/execution-futures [requests]
+ */
+
+using namespace cynq;  // NOLINT
+
+/* Mock of an operation of the device */
+static Status operation() {
+  std::this_thread::sleep_for(std::chrono::microseconds(10));
+  return Status{};
+}
+
+/* Number of completed requests */
+static std::atomic<int> completed{0};
+
+#ifdef CYNQ_HAS_COROUTINES
+/* Fire-and-forget coroutine */
+struct Request {
+  struct promise_type {
+    Request get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+static Request serve(std::shared_ptr<IExecutionGraph> stream) {
+  Status st = co_await ExecutionFuture::Submit(stream, operation);
+  if (st.code == Status::OK) {
+    st = co_await ExecutionFuture::Submit(stream, operation);
+  }
+  if (st.code == Status::OK) {
+    st = co_await ExecutionFuture::Submit(stream, operation);
+  }
+  completed++;
+}
+#else
+/* Runs the stages of the request one after the other */
+static void serve(std::shared_ptr<IExecutionGraph> stream,
+                  const int stage = 0) {
+  if (stage == 3) {
+    completed++;
+    return;
+  }
+  ExecutionFuture future = ExecutionFuture::Submit(stream, operation);
+  auto next = [stream, stage]() { serve(stream, stage + 1); };
+  if (!future.OnCompletion(next)) {
+    next();
+  }
+}
+#endif
+
+int main(int argc, char **argv) {
+  const int num_requests = argc > 1 ? std::stoi(argv[1]) : 1000;
+
+#ifdef CYNQ_HAS_COROUTINES
+  std::cout << "----- Futures: coroutines -----" << std::endl;
+#else
+  std::cout << "----- Futures: callbacks -----" << std::endl;
+#endif
+
+  auto stream = IExecutionGraph::Create(IExecutionGraph::Type::STREAM, nullptr);
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_requests; ++i) {
+    serve(stream);
+  }
+  /* The requests add nodes from the worker, so a single Sync() is not
+     enough to wait for all of them */
+  while (completed.load() < num_requests) {
+    stream->Sync();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  std::chrono::duration<double, std::milli> elapsed = end - start;
+  std::cout << "Requests: " << completed.load()
+            << " Time (ms): " << elapsed.count() << std::endl;
+
+  /* Blocking usage */
+  ExecutionFuture future = ExecutionFuture::Submit(stream, operation);
+  std::cout << "Node: " << future.Node()
+            << " Result: " << future.Get().code << std::endl;
+  return 0;
+}
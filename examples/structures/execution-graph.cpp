@@ -0,0 +1,63 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <atomic>  // NOLINT
+#include <chrono>  // NOLINT
+#include <cynq/cynq.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+
+/**
+ * @example structures/execution-graph.cpp
+
+ * This is a sample use case of the dependency graph. Two independent chains
+ * of three nodes (A0 -> A1 -> A2 and B0 -> B1 -> B2) are added to the same
+ * graph, followed by a node that joins both. The chains overlap, so the
+ * execution takes about four seconds instead of seven.
+ */
+
+volatile std::atomic_int num{0};
+
+cynq::IExecutionGraph::Function dummy_function(const std::string &name) {
+  return [name]() {
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    std::cout << "node: " << name << " num: " << num.load() << std::endl;
+    num++;
+    return cynq::Status{};
+  };
+}
+
+int main(int, char **) {
+  auto type = cynq::IExecutionGraph::Type::GRAPH;
+  auto params = std::make_shared<cynq::ExecutionGraphParameters>();
+  params->workers = 2;
+  auto graph = cynq::IExecutionGraph::Create(type, params);
+
+  auto start = std::chrono::steady_clock::now();
+
+  auto a0 = graph->Add(dummy_function("A0"));
+  auto b0 = graph->Add(dummy_function("B0"));
+  auto a1 = graph->Add(dummy_function("A1"), {a0});
+  auto b1 = graph->Add(dummy_function("B1"), {b0});
+  auto a2 = graph->Add(dummy_function("A2"), {a1});
+  auto b2 = graph->Add(dummy_function("B2"), {b1});
+
+  graph->Sync(a1);
+  std::cout << "Synchronised w.r.t. A1" << std::endl;
+
+  graph->Add(dummy_function("Join"), {a2, b2});
+  graph->Sync();
+  std::cout << "Synchronised w.r.t. the last" << std::endl;
+
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::cout << "Elapsed time (s): " << elapsed.count() << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <chrono>  // NOLINT
+#include <cynq/cynq.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+/**
+ * @example structures/execution-trace.cpp
+ *
+ * Proof-of-concept of the execution tracer. Two named streams run a mocked
+ * upload -> compute -> download pipeline each. The nodes are labelled and
+ * the execution is dumped as a Chrome trace, which can be opened in
+ * chrome://tracing or https://ui.perfetto.dev. The trace shows the overlap
+ * between both streams and the time each node waits in its queue.
+ *
+ * Running: ./builddir/examples/execution-trace [trace.json]
+ */
+
+using namespace cynq;  // NOLINT
+
+/* Mock of an operation of the device */
+static Status operation(const int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+  return Status{};
+}
+
+/* Adds an iteration of the pipeline to the stream */
+static void pipeline(std::shared_ptr<IExecutionGraph> stream) {
+  {
+    ExecutionTrace::Label label{"Upload"};
+    stream->Add([]() { return operation(50); });
+  }
+  {
+    ExecutionTrace::Label label{"Compute"};
+    stream->Add([]() { return operation(200); });
+  }
+  {
+    ExecutionTrace::Label label{"Download"};
+    stream->Add([]() { return operation(50); });
+  }
+}
+
+int main(int argc, char **argv) {
+  const std::string filename = argc > 1 ? argv[1] : "trace.json";
+  const int iterations = 20;
+
+  std::cout << "----- Execution trace -----" << std::endl;
+
+  ExecutionTrace::Enable();
+
+  auto params_a = std::make_shared<ExecutionGraphParameters>();
+  params_a->name = "camera";
+  auto params_b = std::make_shared<ExecutionGraphParameters>();
+  params_b->name = "inference";
+  auto stream_a =
+      IExecutionGraph::Create(IExecutionGraph::Type::STREAM, params_a);
+  auto stream_b =
+      IExecutionGraph::Create(IExecutionGraph::Type::STREAM, params_b);
+
+  for (int i = 0; i < iterations; ++i) {
+    pipeline(stream_a);
+    pipeline(stream_b);
+  }
+  stream_a->Sync();
+  stream_b->Sync();
+
+  ExecutionTrace::Disable();
+  Status st = ExecutionTrace::Dump(filename);
+  if (st.code != Status::OK) {
+    std::cerr << "ERROR: " << st.msg << std::endl;
+    return -1;
+  }
+  std::cout << "Trace written to: " << filename << std::endl;
+  return 0;
+}
@@ -0,0 +1,129 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <cstdint>
+#include <cynq/cynq.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <third-party/timer.hpp>
+#include <vector>
+
+/**
+ * @example structures/graph-replay.cpp
+ *
+ * Benchmark of the capture and replay of execution graphs. It mimics the
+ * per-frame sequence of an inference pipeline (write arguments, attach
+ * buffers, upload, start, wait and download) with host-only operations.
+ * The sequence is either rebuilt every frame through Add() or captured once
+ * and replayed through Launch(). Between replays, the scalar argument is
+ * patched through its pointer and the buffer binding through Update().
+ *
+ * Running: ./builddir/examples/graph-replay [frames]
+ */
+
+using namespace cynq;  // NOLINT
+
+/* Mock of a device buffer */
+using Buffer = std::shared_ptr<std::vector<uint8_t>>;
+
+/* Mock of an accelerator: it keeps the arguments written by the nodes */
+struct MockAccelerator {
+  int rows = 0;
+  uint8_t *bound = nullptr;
+  uint64_t checksum = 0;
+};
+
+/* Adds the frame sequence to the graph and returns the Attach node */
+static IExecutionGraph::NodeID add_frame(std::shared_ptr<IExecutionGraph> graph,
+                                         MockAccelerator *accel,
+                                         const int *rows, Buffer input,
+                                         Buffer output) {
+  const size_t size = input->size();
+  graph->Add([accel, rows]() -> Status {
+    accel->rows = *rows;
+    return Status{};
+  });
+  IExecutionGraph::NodeID attach =
+      graph->Add([accel, input]() -> Status {
+        accel->bound = input->data();
+        return Status{};
+      });
+  graph->Add([accel, size]() -> Status {
+    accel->bound[0] = static_cast<uint8_t>(size);
+    return Status{};
+  });
+  graph->Add([accel]() -> Status {
+    accel->checksum += accel->rows + accel->bound[0];
+    return Status{};
+  });
+  graph->Add([accel]() -> Status {
+    return accel->bound ? Status{}
+                        : Status{Status::EXECUTION_FAILED, "Not attached"};
+  });
+  graph->Add([accel, output, size]() -> Status {
+    (*output)[0] = static_cast<uint8_t>(accel->checksum);
+    return Status{};
+  });
+  return attach;
+}
+
+int main(int argc, char **argv) {
+  INIT_PROFILER(cynq_profiler)
+  const size_t frames = argc > 1 ? std::stoul(argv[1]) : 10000;
+
+  MockAccelerator accel{};
+  int rows = 1;
+  Buffer input_a = std::make_shared<std::vector<uint8_t>>(64, 1);
+  Buffer input_b = std::make_shared<std::vector<uint8_t>>(64, 2);
+  Buffer output = std::make_shared<std::vector<uint8_t>>(64, 0);
+
+  auto stream = IExecutionGraph::Create(IExecutionGraph::Type::STREAM,
+                                        nullptr);
+
+  std::cout << "----- Graph replay: " << frames << " frames -----"
+            << std::endl;
+
+  /* Rebuild the sequence every frame */
+  START_PROFILE(rebuild_per_frame, cynq_profiler, frames)
+  add_frame(stream, &accel, &rows, input_a, output);
+  stream->Sync();
+  END_PROFILE(rebuild_per_frame)
+  const uint64_t rebuild_checksum = accel.checksum;
+
+  /* Capture once and replay */
+  accel.checksum = 0;
+  stream->BeginCapture();
+  IExecutionGraph::NodeID attach =
+      add_frame(stream, &accel, &rows, input_a, output);
+  std::shared_ptr<ExecutableGraph> frame = stream->EndCapture();
+
+  START_PROFILE(capture_replay, cynq_profiler, frames)
+  stream->Launch(frame);
+  stream->Sync();
+  END_PROFILE(capture_replay)
+
+  std::cout << "Captured nodes: " << frame->Size()
+            << " Checksum (rebuild/replay): " << rebuild_checksum << "/"
+            << accel.checksum << std::endl;
+
+  /* Patch the scalar argument and the buffer binding */
+  rows = 10;
+  MockAccelerator *accel_ptr = &accel;
+  frame->Update(attach, [accel_ptr, input_b]() -> Status {
+    accel_ptr->bound = input_b->data();
+    return Status{};
+  });
+  accel.checksum = 0;
+  stream->Launch(frame);
+  stream->Sync();
+  std::cout << "Patched replay checksum (expected " << 10 + 64 << "): "
+            << accel.checksum << std::endl;
+
+  std::cout << cynq_profiler << std::endl;
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <chrono>  // NOLINT
+#include <cynq/cynq.hpp>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+/**
+ * @example structures/stream-pool.cpp
+ *
+ * Benchmark of many streams in the same process. Each stream receives no-op
+ * nodes from its own producer. The streams with a dedicated thread
+ * (Type::STREAM) are compared against the streams that share the
+ * process-wide work-stealing pool (Type::SHARED_STREAM). It reports the
+ * throughput and the number of threads of the process.
+ *
+ * Running: ./builddir/examples/stream-pool [streams] [nodes per stream]
+ */
+
+using namespace cynq;  // NOLINT
+
+static Status noop() { return Status{}; }
+
+/* Number of threads of the current process (Linux only) */
+static std::string count_threads() {
+  std::ifstream status{"/proc/self/status"};
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.rfind("Threads:", 0) == 0) {
+      return line.substr(line.find_first_not_of(" \t", 8));
+    }
+  }
+  return "unknown";
+}
+
+static void run(const IExecutionGraph::Type type, const std::string &name,
+                const size_t num_streams, const size_t num_nodes) {
+  IExecutionGraph::Function func = noop;
+  std::vector<std::shared_ptr<IExecutionGraph>> streams;
+  for (size_t i = 0; i < num_streams; ++i) {
+    streams.push_back(IExecutionGraph::Create(type, nullptr));
+  }
+  const std::string threads = count_threads();
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (size_t i = 0; i < num_streams; ++i) {
+    producers.emplace_back([&, i] {
+      for (size_t n = 0; n < num_nodes; ++n) {
+        streams[i]->Add(func);
+      }
+      streams[i]->Sync();
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  std::chrono::duration<double> elapsed = end - start;
+  const double nodes = num_streams * num_nodes;
+  std::cout << name << ": Threads (idle): " << threads
+            << " Time (s): " << elapsed.count()
+            << " Throughput (Mnodes/s): " << nodes / elapsed.count() / 1e6
+            << std::endl;
+}
+
+int main(int argc, char **argv) {
+  const size_t num_streams = argc > 1 ? std::stoul(argv[1]) : 16;
+  const size_t num_nodes = argc > 2 ? std::stoul(argv[2]) : 100000;
+
+  std::cout << "----- Stream pool: " << num_streams << " streams, "
+            << num_nodes << " nodes per stream -----" << std::endl;
+  std::cout << "Pool workers: " << ExecutionPool::Default()->Workers()
+            << std::endl;
+
+  run(IExecutionGraph::Type::STREAM, "Dedicated threads", num_streams,
+      num_nodes);
+  run(IExecutionGraph::Type::SHARED_STREAM, "Shared pool", num_streams,
+      num_nodes);
+
+  return 0;
+}
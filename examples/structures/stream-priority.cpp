@@ -0,0 +1,103 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <cynq/cynq.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+/**
+ * @example structures/stream-priority.cpp
+ *
+ * Benchmark of the stream priorities. Many background streams flood a small
+ * shared pool while a latency-critical stream submits one frame per
+ * millisecond with a deadline. The queueing delay and the deadline misses
+ * of the latency-critical stream are reported when it has the same priority
+ * as the background streams and when it has a higher priority. With a
+ * higher priority, the background streams yield the workers between nodes.
+ * The priority orders the dispatch of the pool only: it does not arbitrate
+ * the devices shared by the streams.
+ *
+ * Running: ./builddir/examples/stream-priority [frames] [background streams]
+ */
+
+using namespace cynq;  // NOLINT
+using Clock = IExecutionGraph::Clock;
+
+/* Busy wait to mimic the dispatch of an operation */
+static Status spin(const int us) {
+  auto end = Clock::now() + std::chrono::microseconds(us);
+  while (Clock::now() < end) {
+  }
+  return Status{};
+}
+
+static void run(const int priority, const int num_frames,
+                const int num_background) {
+  auto pool = ExecutionPool::Create(2);
+  const int background_nodes = num_frames * 40;
+
+  /* Background work: every stream is flooded from the beginning */
+  std::vector<std::shared_ptr<IExecutionGraph>> background;
+  for (int i = 0; i < num_background; ++i) {
+    auto params = std::make_shared<ExecutionGraphParameters>();
+    params->pool = pool;
+    params->priority = 0;
+    params->capacity = background_nodes;
+    background.push_back(
+        IExecutionGraph::Create(IExecutionGraph::Type::STREAM, params));
+  }
+  IExecutionGraph::Function background_func = [] { return spin(20); };
+  for (int n = 0; n < background_nodes; ++n) {
+    for (auto &stream : background) {
+      stream->Add(background_func);
+    }
+  }
+
+  /* Latency-critical frames */
+  auto params = std::make_shared<ExecutionGraphParameters>();
+  params->pool = pool;
+  params->priority = priority;
+  params->statistics = true;
+  auto frames = IExecutionGraph::Create(IExecutionGraph::Type::STREAM, params);
+  IExecutionGraph::Function frame_func = [] { return spin(50); };
+  for (int f = 0; f < num_frames; ++f) {
+    auto deadline = Clock::now() + std::chrono::microseconds(500);
+    frames->Add(frame_func, {}, deadline);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  frames->Sync();
+
+  ExecutionGraphStatistics stats;
+  frames->GetStatistics(stats);
+  const double average =
+      stats.total_queue_delay / 1e3 / std::max<uint64_t>(stats.nodes, 1);
+  std::cout << "Frame priority " << priority << ": Frames: " << stats.nodes
+            << " Avg delay (us): " << average
+            << " Max delay (us): " << stats.max_queue_delay / 1e3
+            << " Deadline misses: " << stats.deadline_misses << std::endl;
+
+  /* The background streams are destroyed with pending work */
+}
+
+int main(int argc, char **argv) {
+  const int num_frames = argc > 1 ? std::stoi(argv[1]) : 200;
+  const int num_background = argc > 2 ? std::stoi(argv[2]) : 8;
+
+  std::cout << "----- Stream priorities: " << num_frames << " frames, "
+            << num_background << " background streams, 2 workers -----"
+            << std::endl;
+
+  run(0, num_frames, num_background);
+  run(1, num_frames, num_background);
+  return 0;
+}
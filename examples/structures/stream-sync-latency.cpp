@@ -0,0 +1,134 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cynq/cynq.hpp>
+#include <iostream>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <queue>
+#include <string>
+#include <thread>  // NOLINT
+#include <third-party/timer.hpp>
+
+/**
+ * @example structures/stream-sync-latency.cpp
+ *
+ * Benchmark of the ExecutionStream::Sync(node) latency. It enqueues a no-op
+ * node and synchronises on it, measuring the round trip. The event-driven
+ * stream is compared against a reference that reproduces the former timed
+ * polling synchronisation (wake-ups every ExecutionGraphParameters::timeout).
+ *
+ * Running: ./builddir/examples/stream-sync-latency [iterations]
+ */
+
+using namespace cynq;  // NOLINT
+
+/**
+ * Reference implementation of the former polling stream. It is only used
+ * for comparison purposes
+ */
+class PollingStream {
+ public:
+  explicit PollingStream(const uint64_t timeout) : timeout_{timeout} {
+    worker_ = std::thread([this] { this->Worker(); });
+  }
+
+  IExecutionGraph::NodeID Add(const IExecutionGraph::Function &function) {
+    IExecutionGraph::NodeID id;
+    {
+      std::scoped_lock lock(mutex_);
+      id = current_id_++;
+      queue_.push({id, function});
+    }
+    condition_.notify_one();
+    return id;
+  }
+
+  void Sync(const IExecutionGraph::NodeID node) {
+    IExecutionGraph::NodeID executing = -1;
+    while (executing < node) {
+      std::unique_lock<std::mutex> lk(sync_mutex_);
+      sync_condition_.wait_for(lk, std::chrono::microseconds(timeout_));
+      std::scoped_lock lock(mutex_);
+      executing = queue_.empty() ? current_id_ - 1 : queue_.front().id - 1;
+    }
+  }
+
+  ~PollingStream() {
+    {
+      std::scoped_lock lock(mutex_);
+      terminate_ = true;
+    }
+    worker_.join();
+  }
+
+ private:
+  void Worker() {
+    bool finish = false;
+    while (!finish) {
+      IExecutionGraph::Node node{};
+      node.id = -1;
+      {
+        std::unique_lock<std::mutex> lk(mutex_);
+        if (queue_.empty()) {
+          condition_.wait_for(lk, std::chrono::microseconds(timeout_));
+        } else {
+          node = queue_.front();
+        }
+      }
+      if (node.id != -1) {
+        node.function();
+        std::scoped_lock lock(mutex_);
+        queue_.pop();
+      }
+      {
+        std::scoped_lock lock(mutex_);
+        finish = terminate_;
+      }
+      sync_condition_.notify_one();
+    }
+  }
+
+  uint64_t timeout_;
+  std::queue<IExecutionGraph::Node> queue_;
+  std::mutex mutex_;
+  std::mutex sync_mutex_;
+  std::condition_variable condition_;
+  std::condition_variable sync_condition_;
+  IExecutionGraph::NodeID current_id_ = 0;
+  bool terminate_ = false;
+  std::thread worker_;
+};
+
+static Status noop() { return Status{}; }
+
+int main(int argc, char **argv) {
+  INIT_PROFILER(cynq_profiler)
+  const size_t iterations = argc > 1 ? std::stoul(argv[1]) : 10000;
+  IExecutionGraph::Function func = noop;
+
+  std::cout << "----- Sync(node) latency: " << iterations
+            << " iterations -----" << std::endl;
+
+  /* Event-driven stream */
+  auto params = std::make_shared<ExecutionGraphParameters>();
+  auto stream = IExecutionGraph::Create(IExecutionGraph::Type::STREAM, params);
+  START_PROFILE(event_driven_sync, cynq_profiler, iterations)
+  stream->Sync(stream->Add(func));
+  END_PROFILE(event_driven_sync)
+
+  /* Former polling stream */
+  PollingStream polling{params->timeout};
+  START_PROFILE(polling_sync, cynq_profiler, iterations)
+  polling.Sync(polling.Add(func));
+  END_PROFILE(polling_sync)
+
+  std::cout << cynq_profiler << std::endl;
+  return 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <chrono>  // NOLINT
+#include <cynq/cynq.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+/**
+ * @example structures/stream-throughput.cpp
+ *
+ * Benchmark of the ExecutionStream enqueue throughput. It enqueues millions
+ * of no-op nodes from 1, 2, 4 and 8 producer threads into a single stream
+ * and reports the number of nodes per second, including the execution by
+ * the stream worker.
+ *
+ * Running: ./builddir/examples/stream-throughput [nodes]
+ */
+
+using namespace cynq;  // NOLINT
+
+static Status noop() { return Status{}; }
+
+int main(int argc, char **argv) {
+  const size_t total_nodes = argc > 1 ? std::stoul(argv[1]) : 4000000;
+  const std::vector<size_t> producers = {1, 2, 4, 8};
+  IExecutionGraph::Function func = noop;
+
+  std::cout << "----- Stream throughput: " << total_nodes
+            << " nodes -----" << std::endl;
+
+  for (size_t num_producers : producers) {
+    auto stream = IExecutionGraph::Create(IExecutionGraph::Type::STREAM,
+                                          nullptr);
+    const size_t nodes_per_producer = total_nodes / num_producers;
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t p = 0; p < num_producers; ++p) {
+      threads.emplace_back([&] {
+        for (size_t i = 0; i < nodes_per_producer; ++i) {
+          stream->Add(func);
+        }
+      });
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+    stream->Sync();
+    auto end = std::chrono::steady_clock::now();
+
+    std::chrono::duration<double> elapsed = end - start;
+    const double nodes = nodes_per_producer * num_producers;
+    std::cout << "Producers: " << num_producers
+              << " Time (s): " << elapsed.count()
+              << " Throughput (Mnodes/s): " << nodes / elapsed.count() / 1e6
+              << std::endl;
+  }
+
+  return 0;
+}
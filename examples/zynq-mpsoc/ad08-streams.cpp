@@ -13,23 +13,31 @@
 #include <cynq/accelerator.hpp>
 #include <cynq/datamover.hpp>
 #include <cynq/execution-graph.hpp>
+#include <cynq/execution-trace.hpp>
 #include <cynq/hardware.hpp>
 #include <cynq/memory.hpp>
 #include <iostream>
 #include <memory>
 #include <string>
 #include <third-party/timer.hpp>
+#include <vector>
 // clang-format on
 
 /**
  * @example zynq-mpsoc/ad08-streams.cpp
  *
  * This is a use case that involves two accelerators with AXI-MM ports.
- * The accelerators are executed in parallel using IExecutionGraph
+ * The accelerators are executed in parallel using a single IExecutionGraph
+ * of type GRAPH. Each accelerator is a chain of dependent nodes
+ * (configure -> upload -> start -> wait -> download), and both chains overlap
+ * within the same graph since they do not depend on each other.
+ *
+ * If a trace file is given, the execution of the nodes is recorded and
+ * dumped as a Chrome trace, which can be opened in Perfetto.
  */
 
 /*
- * Running: sudo ./builddir/examples/ad08-kria 4 4 4
+ * Running: sudo ./builddir/examples/ad08-kria 4 4 4 [trace.json]
  *
  * Result:
  *   MatMul Result:
@@ -56,13 +64,19 @@ int main(int argc, char** argv) {
   total_time->reset();
 #endif
 
-  if (argc != 4) {
+  if (argc != 4 && argc != 5) {
     std::cerr << "ERROR: Cannot execute the example. Requires a parameter:"
               << std::endl
-              << "\t" << argv[0] << " a_rows b_cols c_cols" << std::endl;
+              << "\t" << argv[0] << " a_rows b_cols c_cols [trace_file]"
+              << std::endl;
     return -1;
   }
 
+  // Record the execution of the nodes if requested
+  if (argc == 5) {
+    ExecutionTrace::Enable();
+  }
+
   // Load image
   AD08_INFO("Loading arguments");
   // Get input size
@@ -97,11 +111,9 @@ int main(int argc, char** argv) {
       platform->GetAccelerator(kElemWiseAddr);
   // Get a data mover
   std::shared_ptr<IDataMover> mover = platform->GetDataMover(kDmaAddress);
-  // Get two streams
-  std::shared_ptr<IExecutionGraph> matmul_stream =
-      platform->GetExecutionStream("matmul");
-  std::shared_ptr<IExecutionGraph> elemwise_stream =
-      platform->GetExecutionStream("elemwise");
+  // Get a dependency graph for both accelerators
+  std::shared_ptr<IExecutionGraph> graph =
+      platform->GetExecutionStream("ad08", IExecutionGraph::Type::GRAPH);
 #ifdef PROFILE_MODE
   setup_time->tick();
 #endif
@@ -134,16 +146,26 @@ int main(int argc, char** argv) {
   GET_PROFILE_INSTANCE(configuration_time, cynq_profiler);
   configuration_time->reset();
 #endif
-  matmul->Write(matmul_stream, XMATMUL_CONTROL_ADDR_A_ROWS_DATA, &a_rows, 1);
-  matmul->Write(matmul_stream, XMATMUL_CONTROL_ADDR_B_COLS_DATA, &b_cols, 1);
-  matmul->Write(matmul_stream, XMATMUL_CONTROL_ADDR_C_COLS_DATA, &c_cols, 1);
+  // The configuration nodes are independent among them
+  std::vector<IExecutionGraph::NodeID> matmul_deps, elemwise_deps;
+  matmul_deps.push_back(
+      matmul->Write(graph, XMATMUL_CONTROL_ADDR_A_ROWS_DATA, &a_rows, 1)
+          .retval);
+  matmul_deps.push_back(
+      matmul->Write(graph, XMATMUL_CONTROL_ADDR_B_COLS_DATA, &b_cols, 1)
+          .retval);
+  matmul_deps.push_back(
+      matmul->Write(graph, XMATMUL_CONTROL_ADDR_C_COLS_DATA, &c_cols, 1)
+          .retval);
   matmul->Attach(XMATMUL_CONTROL_ADDR_A_DATA, buf_mem_mm_a);
   matmul->Attach(XMATMUL_CONTROL_ADDR_B_DATA, buf_mem_mm_b);
   matmul->Attach(XMATMUL_CONTROL_ADDR_C_DATA, buf_mem_mm_c);
 
-  elemwise->Write(elemwise_stream, XELEMENTWISE_CONTROL_ADDR_SIZE_DATA, &size_c,
-                  1);
-  elemwise->Write(elemwise_stream, XELEMENTWISE_CONTROL_ADDR_OP_DATA, &op, 1);
+  elemwise_deps.push_back(
+      elemwise->Write(graph, XELEMENTWISE_CONTROL_ADDR_SIZE_DATA, &size_c, 1)
+          .retval);
+  elemwise_deps.push_back(
+      elemwise->Write(graph, XELEMENTWISE_CONTROL_ADDR_OP_DATA, &op, 1).retval);
   elemwise->Attach(XELEMENTWISE_CONTROL_ADDR_IN1_DATA, buf_mem_ew_a);
   elemwise->Attach(XELEMENTWISE_CONTROL_ADDR_IN2_DATA, buf_mem_ew_b);
   elemwise->Attach(XELEMENTWISE_CONTROL_ADDR_OUT_R_DATA, buf_mem_ew_c);
@@ -157,10 +179,15 @@ int main(int argc, char** argv) {
   GET_PROFILE_INSTANCE(upload_time, cynq_profiler);
   upload_time->reset();
 #endif
-  buf_mem_mm_a->Sync(matmul_stream, SyncType::HostToDevice);
-  buf_mem_mm_b->Sync(matmul_stream, SyncType::HostToDevice);
-  buf_mem_ew_a->Sync(elemwise_stream, SyncType::HostToDevice);
-  buf_mem_ew_b->Sync(elemwise_stream, SyncType::HostToDevice);
+  // The uploads can run concurrently with the configuration
+  matmul_deps.push_back(
+      buf_mem_mm_a->Sync(graph, SyncType::HostToDevice).retval);
+  matmul_deps.push_back(
+      buf_mem_mm_b->Sync(graph, SyncType::HostToDevice).retval);
+  elemwise_deps.push_back(
+      buf_mem_ew_a->Sync(graph, SyncType::HostToDevice).retval);
+  elemwise_deps.push_back(
+      buf_mem_ew_b->Sync(graph, SyncType::HostToDevice).retval);
 #ifdef PROFILE_MODE
   upload_time->tick();
 #endif
@@ -170,10 +197,13 @@ int main(int argc, char** argv) {
   GET_PROFILE_INSTANCE(compute_time, cynq_profiler);
   compute_time->reset();
 #endif
-  matmul->Start(matmul_stream, StartMode::Once);
-  matmul->Sync(matmul_stream);
-  elemwise->Start(elemwise_stream, StartMode::Once);
-  elemwise->Sync(elemwise_stream);
+  // Each accelerator starts once its configuration and inputs are ready
+  IExecutionGraph::NodeID matmul_node =
+      matmul->Start(graph, StartMode::Once, matmul_deps).retval;
+  matmul_node = matmul->Sync(graph, {matmul_node}).retval;
+  IExecutionGraph::NodeID elemwise_node =
+      elemwise->Start(graph, StartMode::Once, elemwise_deps).retval;
+  elemwise_node = elemwise->Sync(graph, {elemwise_node}).retval;
 #ifdef PROFILE_MODE
   compute_time->tick();
 #endif
@@ -183,19 +213,18 @@ int main(int argc, char** argv) {
   GET_PROFILE_INSTANCE(download_time, cynq_profiler);
   download_time->reset();
 #endif
-  buf_mem_mm_c->Sync(matmul_stream, SyncType::DeviceToHost);
-  buf_mem_ew_c->Sync(elemwise_stream, SyncType::DeviceToHost);
+  buf_mem_mm_c->Sync(graph, SyncType::DeviceToHost, {matmul_node});
+  buf_mem_ew_c->Sync(graph, SyncType::DeviceToHost, {elemwise_node});
 #ifdef PROFILE_MODE
   download_time->tick();
 #endif
 
-  AD08_INFO("Synchronise streams");
+  AD08_INFO("Synchronise graph");
 #ifdef PROFILE_MODE
   GET_PROFILE_INSTANCE(sync_time, cynq_profiler);
   sync_time->reset();
 #endif
-  matmul_stream->Sync();
-  elemwise_stream->Sync();
+  graph->Sync();
 #ifdef PROFILE_MODE
   sync_time->tick();
 #endif
@@ -212,5 +241,10 @@ int main(int argc, char** argv) {
 #endif
   std::cout << cynq_profiler << std::endl;
 
+  if (argc == 5) {
+    AD08_INFO("Dumping trace");
+    ExecutionTrace::Dump(argv[4]);
+  }
+
   return 0;
 }
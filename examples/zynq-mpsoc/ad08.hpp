@@ -53,7 +53,7 @@ void AD08_UNUSED(const std::string&) {}
 static void fill_data(std::shared_ptr<cynq::IMemory> buffer, const size_t num,
                       const DataType start_value = 100,
                       const DataType step_value = 10) {
-  DataType* data = buffer->HostAddress<DataType>().get();
+  DataType* data = buffer->HostSpan<DataType>().Data();
   for (size_t i = 0; i < num; ++i) {
     data[i] = static_cast<DataType>(start_value + step_value * i);
   }
@@ -63,7 +63,7 @@ static void fill_data(std::shared_ptr<cynq::IMemory> buffer, const size_t num,
 /* Auxiliary function to print */
 static void print_data(std::shared_ptr<cynq::IMemory> buffer,
                        const size_t num) {
-  DataType* data = buffer->HostAddress<DataType>().get();
+  DataType* data = buffer->HostSpan<DataType>().Data();
   for (size_t i = 0; i < num; ++i) {
     std::cout << data[i] << " ";
   }
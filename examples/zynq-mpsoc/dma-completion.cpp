@@ -0,0 +1,124 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <cynq/datamover.hpp>
+#include <cynq/hardware.hpp>
+#include <cynq/memory.hpp>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @example zynq-mpsoc/dma-completion.cpp
+ *
+ * Benchmark of the completion modes of the DMA data mover (see
+ * CompletionOptions). For each transfer size, it moves a buffer through an
+ * AXI DMA whose MM2S stream is looped back into its S2MM stream (i.e.
+ * through an AXI4-Stream FIFO) and reports:
+ *
+ * - Latency: average wall time of the round trip in microseconds.
+ * - CPU: CPU time of the thread over the wall time. The polling keeps the
+ *   core busy during the whole transfer.
+ *
+ * The modes are polling, interrupt and hybrid (spin for 20 us and then
+ * block). The interrupts of the channels (mm2s_introut and s2mm_introut)
+ * must be exposed as generic-uio devices.
+ *
+ * Running: sudo ./builddir/examples/dma-completion-kria <bitstream>
+ * <dma address> <mm2s uio> <s2mm uio> [iterations]
+ */
+
+using namespace cynq;  // NOLINT
+
+struct Mode {
+  std::string name;
+  CompletionMode mode;
+};
+
+// CPU time of the calling thread in microseconds
+static double CpuTime() {
+  struct rusage usage;
+  getrusage(RUSAGE_THREAD, &usage);
+  return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1e6 +
+         usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+}
+
+int main(int argc, char **argv) {
+  if (argc < 5) {
+    std::cerr << "Usage: " << argv[0]
+              << " <bitstream> <dma address> <mm2s uio> <s2mm uio>"
+                 " [iterations]"
+              << std::endl;
+    return 1;
+  }
+  const std::string bitstream = argv[1];
+  const uint64_t address = std::stoull(argv[2], nullptr, 0);
+  const int iterations = argc > 5 ? std::stoi(argv[5]) : 1000;
+
+  std::cout << "----- Initialising platform -----" << std::endl;
+  std::shared_ptr<IHardware> platform =
+      IHardware::Create(HardwareArchitecture::UltraScale, bitstream);
+  std::shared_ptr<IDataMover> mover = platform->GetDataMover(address);
+
+  const std::vector<Mode> modes = {{"Polling", CompletionMode::Polling},
+                                   {"Interrupt", CompletionMode::Interrupt},
+                                   {"Hybrid", CompletionMode::Hybrid}};
+
+  std::cout << "----- Round trip: latency (us) / CPU (%) -----" << std::endl;
+  std::cout << std::setw(12) << "Size (KiB)";
+  for (const auto &mode : modes) {
+    std::cout << std::setw(20) << mode.name;
+  }
+  std::cout << std::endl;
+
+  for (size_t size = 4096; size <= (4 << 20); size <<= 2) {
+    std::shared_ptr<IMemory> in = mover->GetBuffer(size);
+    std::shared_ptr<IMemory> out = mover->GetBuffer(size);
+    auto data = in->HostSpan<uint8_t>();
+    std::fill(data.begin(), data.end(), 0x5A);
+
+    std::cout << std::setw(12) << (size >> 10);
+    for (const auto &mode : modes) {
+      CompletionOptions options;
+      options.mode = mode.mode;
+      options.write_uio = argv[3];
+      options.read_uio = argv[4];
+      Status st = mover->SetCompletionOptions(options);
+      if (st.code != Status::OK) {
+        std::cout << std::setw(20) << "unavailable";
+        continue;
+      }
+
+      // The S2MM channel is armed first to receive the looped-back stream
+      auto start = std::chrono::steady_clock::now();
+      const double cpu_start = CpuTime();
+      for (int i = 0; i < iterations; ++i) {
+        mover->Download(out, size, 0, ExecutionType::Async);
+        mover->Upload(in, size, 0, ExecutionType::Async);
+        mover->Sync(SyncType::HostToDevice);
+        mover->Sync(SyncType::DeviceToHost);
+      }
+      const double cpu = CpuTime() - cpu_start;
+      auto end = std::chrono::steady_clock::now();
+
+      std::chrono::duration<double, std::micro> elapsed = end - start;
+      std::cout << std::setw(12) << std::fixed << std::setprecision(1)
+                << elapsed.count() / iterations << " / " << std::setw(5)
+                << 100.0 * cpu / elapsed.count();
+    }
+    std::cout << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <cynq/datamover.hpp>
+#include <cynq/execution-future.hpp>
+#include <cynq/hardware.hpp>
+#include <cynq/memory.hpp>
+#include <cynq/transfer-channel.hpp>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @example zynq-mpsoc/dma-duplex.cpp
+ *
+ * Benchmark of the bidirectional streaming throughput of an AXI DMA whose
+ * MM2S stream is looped back into its S2MM stream (i.e. through an
+ * AXI4-Stream FIFO). For each transfer size, it moves a batch of buffers:
+ *
+ * - Single object: each buffer is moved with an asynchronous download, a
+ *   synchronous upload and a Sync() of the download. Only one buffer per
+ *   direction is in flight, and the host waits for both.
+ * - Channels: the buffers are enqueued in an upload and a download
+ *   TransferChannel, so both directions are kept busy by their own streams
+ *   and each buffer is tracked by its own handle.
+ *
+ * The throughput counts the bytes of both directions.
+ *
+ * Running: sudo ./builddir/examples/dma-duplex-kria <bitstream>
+ * <dma address> [buffers]
+ */
+
+using namespace cynq;  // NOLINT
+
+int main(int argc, char **argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <bitstream> <dma address> [buffers]"
+              << std::endl;
+    return 1;
+  }
+  const std::string bitstream = argv[1];
+  const uint64_t address = std::stoull(argv[2], nullptr, 0);
+  const size_t count = argc > 3 ? std::stoul(argv[3]) : 64;
+
+  std::cout << "----- Initialising platform -----" << std::endl;
+  std::shared_ptr<IHardware> platform =
+      IHardware::Create(HardwareArchitecture::UltraScale, bitstream);
+  std::shared_ptr<IDataMover> mover = platform->GetDataMover(address);
+
+  std::cout << "----- Bidirectional throughput (MB/s) -----" << std::endl;
+  std::cout << std::setw(12) << "Size (KiB)" << std::setw(16) << "Single object"
+            << std::setw(16) << "Channels" << std::setw(10) << "Errors"
+            << std::endl;
+
+  for (size_t size = 16 << 10; size <= (4 << 20); size <<= 2) {
+    std::vector<std::shared_ptr<IMemory>> in, out;
+    for (size_t i = 0; i < count; ++i) {
+      in.push_back(mover->GetBuffer(size));
+      out.push_back(mover->GetBuffer(size));
+      auto data = in.back()->HostSpan<uint8_t>();
+      std::fill(data.begin(), data.end(), static_cast<uint8_t>(i));
+    }
+    const double bytes = 2.0 * size * count;
+
+    // Single object: the download is armed first to receive the loopback
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < count; ++i) {
+      mover->Download(out[i], size, 0, ExecutionType::Async);
+      mover->Upload(in[i], size, 0, ExecutionType::Sync);
+      mover->Sync(SyncType::DeviceToHost);
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> single = end - start;
+
+    // Channels: both queues are filled and run concurrently
+    size_t errors = 0;
+    start = std::chrono::steady_clock::now();
+    {
+      TransferChannel tx{mover, SyncType::HostToDevice};
+      TransferChannel rx{mover, SyncType::DeviceToHost};
+      std::vector<ExecutionFuture> received;
+      for (size_t i = 0; i < count; ++i) {
+        received.push_back(rx.Enqueue(out[i], size));
+        tx.Enqueue(in[i], size);
+      }
+      for (size_t i = 0; i < count; ++i) {
+        if (received[i].Get().code != Status::OK ||
+            out[i]->HostSpan<uint8_t>()[size - 1] != static_cast<uint8_t>(i)) {
+          errors++;
+        }
+      }
+      tx.Sync();
+    }
+    end = std::chrono::steady_clock::now();
+    std::chrono::duration<double> channels = end - start;
+
+    std::cout << std::setw(12) << (size >> 10) << std::setw(16) << std::fixed
+              << std::setprecision(1) << bytes / single.count() / 1e6
+              << std::setw(16) << bytes / channels.count() / 1e6
+              << std::setw(10) << errors << std::endl;
+  }
+
+  return 0;
+}
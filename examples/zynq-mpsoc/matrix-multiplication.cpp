@@ -12,6 +12,7 @@
 #include <cynq/datamover.hpp>
 #include <cynq/hardware.hpp>
 #include <cynq/memory.hpp>
+#include <cynq/tensor.hpp>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -54,25 +55,38 @@ static constexpr int output_rows = input_a_rows;
 using DataType = uint16_t;
 static constexpr int word_size = sizeof(DataType);
 
+// Layouts of the matrices. A and B share the input buffer since they are
+// streamed together. The offsets and sizes are computed at compile time
+static constexpr cynq::TensorLayout<DataType, 2> kLayoutA{
+    {input_a_rows, input_a_cols}};
+static constexpr cynq::TensorLayout<DataType, 2> kLayoutB{
+    {input_b_rows, input_b_cols}, kLayoutA.Bytes()};
+static constexpr cynq::TensorLayout<DataType, 2> kLayoutC{
+    {output_rows, output_cols}};
+static_assert(kLayoutB.Offset() + kLayoutB.Bytes() ==
+                  (input_a_cols * input_a_rows + input_b_cols * input_b_rows) *
+                      word_size,
+              "A and B must fill the input buffer");
+
+using Matrix = cynq::Tensor<DataType, 2>;
+
 // Fill data
-void FillData(DataType* A, DataType* B, DataType* C) {
+void FillData(const Matrix& A, const Matrix& B, const Matrix& C) {
   for (uint32_t row = 0; row < input_b_cols; ++row) {
     for (uint32_t col = 0; col < input_a_cols; ++col) {
-      A[((row % input_a_rows) * input_a_cols) + (col % input_a_cols)] =
-          row * col;
-      B[((col % input_b_rows) * input_b_cols) + (row % input_b_cols)] =
-          row * col;
-      C[((row % output_rows) * output_cols) + (col % output_cols)] = 0;
+      A(row % input_a_rows, col % input_a_cols) = row * col;
+      B(col % input_b_rows, row % input_b_cols) = row * col;
+      C(row % output_rows, col % output_cols) = 0;
     }
   }
 }
 
 // Print results
-void PrintData(DataType* C) {
+void PrintData(const Matrix& C) {
   std::cout << "Output: " << std::endl;
-  for (int i = 0; i < output_rows; ++i) {
-    for (int j = 0; j < output_cols; ++j) {
-      std::cout << C[i * output_cols + j] << " ";
+  for (size_t i = 0; i < C.Dimension(0); ++i) {
+    for (size_t j = 0; j < C.Dimension(1); ++j) {
+      std::cout << C(i, j) << " ";
     }
     std::cout << std::endl;
   }
@@ -110,11 +124,11 @@ int main() {
   std::shared_ptr<IMemory> in_mem = mover->GetBuffer(input_size);
   std::shared_ptr<IMemory> out_mem = mover->GetBuffer(output_size);
 
-  // Get the host pointers for input/outut
+  // Get the views of the matrices
   std::cout << "----- Loading input -----" << std::endl;
-  DataType* A = in_mem->HostAddress<DataType>().get();
-  DataType* B = A + (input_a_cols * input_a_rows);
-  DataType* C = out_mem->HostAddress<DataType>().get();
+  Matrix A{in_mem, kLayoutA};
+  Matrix B{in_mem, kLayoutB};
+  Matrix C{out_mem, kLayoutC};
 
   // Fill the data
   FillData(A, B, C);
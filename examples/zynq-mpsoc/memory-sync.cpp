@@ -0,0 +1,112 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <cynq/datamover.hpp>
+#include <cynq/hardware.hpp>
+#include <cynq/memory.hpp>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+/**
+ * @example zynq-mpsoc/memory-sync.cpp
+ *
+ * Benchmark of the cost of flushing a cacheable buffer against its size.
+ * For each buffer size, the host updates 4 KiB of the buffer and flushes it
+ * in three ways:
+ *
+ * - Full: IMemory::Sync() flushes the whole buffer.
+ * - Ranged: IMemory::Sync(type, size, offset) flushes the updated region.
+ * - Dirty: the region is written through a DirtyWriter, so IMemory::Sync()
+ *   only flushes the touched cache lines.
+ *
+ * The full flush grows with the buffer size, whereas the other ones only
+ * depend on the size of the update.
+ *
+ * Running: sudo ./builddir/examples/memory-sync-kria [iterations]
+ */
+
+#if !defined(EXAMPLE_MULTIPLICATION_BITSTREAM_LOCATION)
+#error "Missing location macros for example"
+#endif
+
+// Given by the example. Any bitstream works since there are no transfers
+static constexpr char kBitstream[] = EXAMPLE_MULTIPLICATION_BITSTREAM_LOCATION;
+// Size of the update
+static constexpr size_t kUpdateSize = 4096;
+
+using namespace cynq;  // NOLINT
+
+// Measures the average time in microseconds of a function
+template <typename F>
+static double Measure(const int iterations, F func) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    func(i);
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::chrono::duration<double, std::micro> elapsed = end - start;
+  return elapsed.count() / iterations;
+}
+
+int main(int argc, char** argv) {
+  const int iterations = argc > 1 ? std::stoi(argv[1]) : 100;
+
+  std::cout << "----- Initialising platform -----" << std::endl;
+  std::shared_ptr<IHardware> platform =
+      IHardware::Create(HardwareArchitecture::UltraScale, kBitstream);
+  // The DMA engine is not needed: only the buffers are used
+  std::shared_ptr<IDataMover> mover = platform->GetDataMover(0);
+
+  std::cout << "----- Flush cost (us) -----" << std::endl;
+  std::cout << std::setw(12) << "Size (KiB)" << std::setw(12) << "Full"
+            << std::setw(12) << "Ranged" << std::setw(12) << "Dirty"
+            << std::endl;
+
+  for (size_t size = 4096; size <= (64 << 20); size <<= 2) {
+    std::shared_ptr<IMemory> mem =
+        mover->GetBuffer(size, 0, MemoryType::Cacheable);
+    uint8_t* data = mem->HostSpan<uint8_t>().Data();
+    const size_t regions = size / kUpdateSize;
+
+    // Update a different region on each iteration
+    auto update = [&](const int i) -> size_t {
+      const size_t offset = (i % regions) * kUpdateSize;
+      std::fill(data + offset, data + offset + kUpdateSize, i & 0xFF);
+      return offset;
+    };
+
+    double full = Measure(iterations, [&](const int i) {
+      update(i);
+      mem->Sync(SyncType::HostToDevice);
+    });
+
+    double ranged = Measure(iterations, [&](const int i) {
+      mem->Sync(SyncType::HostToDevice, kUpdateSize, update(i));
+    });
+
+    mem->SetDirtyTracking(true);
+    DirtyWriter<uint8_t> writer{mem};
+    double dirty = Measure(iterations, [&](const int i) {
+      const size_t offset = (i % regions) * kUpdateSize;
+      uint8_t* region = writer.Write(offset, kUpdateSize);
+      std::fill(region, region + kUpdateSize, i & 0xFF);
+      mem->Sync(SyncType::HostToDevice);
+    });
+    mem->SetDirtyTracking(false);
+
+    std::cout << std::setw(12) << (size >> 10) << std::setw(12) << full
+              << std::setw(12) << ranged << std::setw(12) << dirty
+              << std::endl;
+  }
+
+  return 0;
+}
@@ -9,9 +9,11 @@
 #pragma once
 #include <memory>
 #include <string>
+#include <vector>
 
 // cynq headers
 #include <cynq/enums.hpp>
+#include <cynq/execution-future.hpp>
 #include <cynq/execution-graph.hpp>
 #include <cynq/memory.hpp>
 #include <cynq/status.hpp>
@@ -80,11 +82,41 @@ class IAccelerator {
    * @param graph Execution graph to execute on. If nullptr is passed, the
    * execution will be synchronous.
    *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
    * @return Status. It fills the retval field with the NodeID of the
    * execution graph.
    */
-  virtual Status Start(std::shared_ptr<IExecutionGraph> graph,
-                       const StartMode mode);
+  virtual Status Start(
+      std::shared_ptr<IExecutionGraph> graph, const StartMode mode,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
+
+  /**
+   * @brief Start method (future)
+   * Please, refer to IAccelerator::Start for reference. It schedules the
+   * start in the graph like the asynchronous overload, and returns a future
+   * with its Status. The future can be waited or awaited by a coroutine (see
+   * ExecutionFuture).
+   *
+   * @param graph Execution graph to execute on. If nullptr is passed, the
+   * execution will be synchronous and the future is ready.
+   *
+   * @param mode One of the values in the StartMode enum class
+   * present in the enums.hpp file.
+   *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
+   * @return ExecutionFuture future of the start
+   */
+  virtual ExecutionFuture StartAsync(
+      std::shared_ptr<IExecutionGraph> graph, const StartMode mode,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
 
   /**
    * @brief Stop method
@@ -105,10 +137,16 @@ class IAccelerator {
    * @param graph Execution graph to execute on. If nullptr is passed, the
    * execution will be synchronous.
    *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
    * @return Status. It fills the retval field with the NodeID of the
    * execution graph.
    */
-  virtual Status Stop(std::shared_ptr<IExecutionGraph> graph);
+  virtual Status Stop(std::shared_ptr<IExecutionGraph> graph,
+                      const std::vector<IExecutionGraph::NodeID> &dependencies =
+                          std::vector<IExecutionGraph::NodeID>(0));
 
   /**
    * @brief Sync method
@@ -128,10 +166,37 @@ class IAccelerator {
    * @param graph Execution graph to execute on. If nullptr is passed, the
    * execution will be synchronous.
    *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
    * @return Status. It fills the retval field with the NodeID of the
    * execution graph.
    */
-  virtual Status Sync(std::shared_ptr<IExecutionGraph> graph);
+  virtual Status Sync(std::shared_ptr<IExecutionGraph> graph,
+                      const std::vector<IExecutionGraph::NodeID> &dependencies =
+                          std::vector<IExecutionGraph::NodeID>(0));
+
+  /**
+   * @brief Sync method (future)
+   * Please, refer to IAccelerator::Sync for reference. It schedules the wait
+   * for the accelerator in the graph like the asynchronous overload, and
+   * returns a future with its Status. A coroutine can await the completion
+   * of the accelerator without blocking a thread (see ExecutionFuture).
+   *
+   * @param graph Execution graph to execute on. If nullptr is passed, the
+   * execution will be synchronous and the future is ready.
+   *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
+   * @return ExecutionFuture future of the synchronisation
+   */
+  virtual ExecutionFuture SyncAsync(
+      std::shared_ptr<IExecutionGraph> graph,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
 
   /**
    * @brief GetStatus method
@@ -238,15 +303,21 @@ class IAccelerator {
    * @param elements
    * Number of elements being written to the device. Defaults to one
    *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
    * @return Status. It fills the retval field with the NodeID within the
    * execution graph
    */
   template <typename T>
   Status Write(std::shared_ptr<IExecutionGraph> graph, const uint64_t address,
-               const T *data, const size_t elements = 1) {
+               const T *data, const size_t elements = 1,
+               const std::vector<IExecutionGraph::NodeID> &dependencies =
+                   std::vector<IExecutionGraph::NodeID>(0)) {
     return this->WriteRegister(graph, address,
                                reinterpret_cast<const uint8_t *>(data),
-                               elements * sizeof(T));
+                               elements * sizeof(T), dependencies);
   }
 
   /**
@@ -295,14 +366,20 @@ class IAccelerator {
    * @param elements
    * Number of elements being read from the device. Defaults to one
    *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
    * @return Status. It fills the retval field with the NodeID within the
    * execution graph
    */
   template <typename T>
   Status Read(std::shared_ptr<IExecutionGraph> graph, const uint64_t address,
-              T *data, const size_t elements = 1) {
+              T *data, const size_t elements = 1,
+              const std::vector<IExecutionGraph::NodeID> &dependencies =
+                  std::vector<IExecutionGraph::NodeID>(0)) {
     return this->ReadRegister(graph, address, reinterpret_cast<uint8_t *>(data),
-                              elements * sizeof(T));
+                              elements * sizeof(T), dependencies);
   }
 
   /**
@@ -319,6 +396,20 @@ class IAccelerator {
    */
   virtual int GetMemoryBank(const uint pos) = 0;
 
+  /**
+   * @brief Get all the memory banks connected to an argument
+   *
+   * Unlike GetMemoryBank(), it lists every bank the argument can reach
+   * according to the connectivity of the loaded design (i.e. an HBM argument
+   * connected to several channels). It is used by PlacementPlanner.
+   *
+   * @param pos memory bank position within the kernel
+   *
+   * @return std::vector<int> memory banks sorted by ID. By default, it only
+   * contains GetMemoryBank(pos).
+   */
+  virtual std::vector<int> GetMemoryBanks(const uint pos);
+
   /**
    * @brief Attach an argument
    * Performs an attachment of the argument and the respective pointer. If the
@@ -377,6 +468,34 @@ class IAccelerator {
    */
   virtual Status Attach(const uint64_t addr, std::shared_ptr<IMemory> mem) = 0;
 
+  /**
+   * @brief Attach a memory argument (asynchronous)
+   * Please, refer to IAccelerator::Attach for reference. This overload
+   * performs an asynchronous execution of the function based on a graph
+   * of operations. It returns as soon as the operation is scheduled. It
+   * allows to record the buffer bindings within a captured graph.
+   *
+   * @param graph Execution graph to execute on. If nullptr is passed, the
+   * execution will be synchronous.
+   *
+   * @param addr Argument address to set the memory address. In the case of
+   * Alveo or Vitis-based workflows, it is the argument index.
+   *
+   * @param mem Memory buffer to attach to the argument
+   *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
+   * @return Status. It fills the retval field with the NodeID of the
+   * execution graph.
+   */
+  virtual Status Attach(
+      std::shared_ptr<IExecutionGraph> graph, const uint64_t addr,
+      std::shared_ptr<IMemory> mem,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
+
  protected:
   /**
    * @brief Opaque Write Register method
@@ -421,11 +540,17 @@ class IAccelerator {
    *
    * @param size size in bytes of the data to write.
    *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
    * @return Status
    */
-  virtual Status WriteRegister(std::shared_ptr<IExecutionGraph> graph,
-                               const uint64_t address, const uint8_t *data,
-                               const size_t size);
+  virtual Status WriteRegister(
+      std::shared_ptr<IExecutionGraph> graph, const uint64_t address,
+      const uint8_t *data, const size_t size,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
   /**
    * @brief Read Register method (asynchronous)
    *
@@ -439,11 +564,17 @@ class IAccelerator {
    *
    * @param size size in bytes of the data to read.
    *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
    * @return Status
    */
-  virtual Status ReadRegister(std::shared_ptr<IExecutionGraph> graph,
-                              const uint64_t address, uint8_t *data,
-                              const size_t size);
+  virtual Status ReadRegister(
+      std::shared_ptr<IExecutionGraph> graph, const uint64_t address,
+      uint8_t *data, const size_t size,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
 
   /**
    * @brief Opaque Attach Register method
@@ -18,8 +18,10 @@
 #include <cynq/enums.hpp>
 #include <cynq/hardware.hpp>
 #include <cynq/status.hpp>
+#include <cynq/xrt/buffer-pool.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace cynq {
 /**
@@ -35,6 +37,8 @@ struct AlveoParameters : public HardwareParameters {
   xrt::uuid uuid_;
   /** XCLBIN file path */
   std::string xclbin_file_;
+  /** Buffer pool and memory accounting shared by the data movers */
+  std::shared_ptr<XRTBufferPool> pool_ = std::make_shared<XRTBufferPool>();
 
   /** Virtual destructor required for the inheritance */
   virtual ~AlveoParameters() = default;
@@ -120,6 +124,21 @@ class Alveo : public IHardware {
    *
    */
   std::shared_ptr<IAccelerator> GetAccelerator(const uint64_t address) override;
+  /**
+   * @brief Get the memory accounting of the memory banks
+   *
+   * @param stats one entry per memory bank used so far (output)
+   * @returns Status of the operation
+   */
+  Status GetMemoryStatistics(std::vector<MemoryBankStatistics> &stats) override;
+  /**
+   * @brief Set the maximum number of bytes allocated in a memory bank
+   *
+   * @param memory_bank memory bank
+   * @param bytes budget in bytes. 0 removes the budget.
+   * @returns Status of the operation
+   */
+  Status SetMemoryBudget(const int memory_bank, const size_t bytes) override;
 
  private:
   /** Parameters used for internal hardware configuration */
@@ -0,0 +1,192 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <condition_variable>  // NOLINT
+#include <cstddef>
+#include <cynq/datamover.hpp>
+#include <cynq/enums.hpp>
+#include <cynq/execution-graph.hpp>
+#include <cynq/memory.hpp>
+#include <cynq/status.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
+namespace cynq {
+/**
+ * @brief Slot of a BufferRing
+ *
+ * It groups the buffers used by one frame of the pipeline (i.e. the input
+ * and the output of the accelerator).
+ */
+struct BufferRingSlot {
+  /** State of the slot */
+  enum class State {
+    /** Available for the producer */
+    Free = 0,
+    /** Owned by the producer */
+    Filling,
+    /** Owned by the execution graph (i.e. the DMA) */
+    InFlight,
+    /** Completed and waiting for the consumer */
+    Ready,
+    /** Owned by the consumer */
+    Reading,
+  };
+
+  /** Position of the slot in the ring */
+  size_t index = 0;
+  /** Buffers of the slot */
+  std::vector<std::shared_ptr<IMemory>> buffers;
+  /** Status returned by the stage of the graph */
+  Status result;
+  /** Sequence number of the frame held by the slot */
+  uint64_t sequence = 0;
+  /** State of the slot. It is managed by the ring */
+  State state = State::Free;
+};
+
+/**
+ * @brief Ring of buffers for streaming pipelines (double/triple buffering)
+ *
+ * The slots of the ring go through the producer, the execution graph and
+ * the consumer in order:
+ *
+ * 1. The producer gets a free slot with AcquireWrite() and fills it.
+ * 2. Submit() hands the slot over to the execution graph, which runs the
+ *    stage of the slot (i.e. the upload and the download).
+ * 3. The consumer gets the slots in submission order with AcquireRead() once
+ *    their stages are completed, and returns them with Release().
+ *
+ * With N slots, the producer can fill frame i + 1 while the graph moves
+ * frame i and the consumer reads frame i - 1, so the transfers overlap with
+ * the host work without further synchronisation. The producer and the
+ * consumer can be different threads. The stages of the slots are chained in
+ * submission order in the graph.
+ */
+class BufferRing {
+ public:
+  /** Stage executed by the graph for a slot */
+  typedef std::function<Status(BufferRingSlot &)> Stage;
+
+  /**
+   * @brief Construct a new ring from existing buffers
+   *
+   * @param graph execution graph that runs the stages. If it is nullptr,
+   * the stages are executed synchronously by Submit().
+   * @param buffers buffers of each slot
+   */
+  BufferRing(std::shared_ptr<IExecutionGraph> graph,
+             const std::vector<std::vector<std::shared_ptr<IMemory>>> &buffers);
+
+  /**
+   * @brief Waits for the slots owned by the graph
+   */
+  ~BufferRing();
+
+  /**
+   * @brief Factory method to create a ring allocating its buffers
+   *
+   * @param mover data mover used to allocate the buffers (GetBuffer())
+   * @param graph execution graph that runs the stages
+   * @param slots number of slots (1: single, 2: double, 3: triple buffering)
+   * @param sizes sizes in bytes of the buffers of each slot
+   * @param memory_bank memory bank of the buffers
+   * @param type memory type of the buffers
+   * @return std::shared_ptr<BufferRing> ring or nullptr if the parameters
+   * are invalid
+   */
+  static std::shared_ptr<BufferRing> Create(
+      std::shared_ptr<IDataMover> mover,
+      std::shared_ptr<IExecutionGraph> graph, const size_t slots,
+      const std::vector<size_t> &sizes, const int memory_bank = 0,
+      const MemoryType type = MemoryType::Dual);
+
+  /**
+   * @brief Number of slots
+   *
+   * @return size_t number of slots
+   */
+  size_t Slots() const;
+
+  /**
+   * @brief Gets the next free slot for the producer
+   *
+   * The slots are handed out in ring order.
+   *
+   * @param wait if true, blocks until the slot is free
+   * @return BufferRingSlot* slot in Filling state. nullptr if it is not
+   * free and wait is false.
+   */
+  BufferRingSlot *AcquireWrite(const bool wait = true);
+
+  /**
+   * @brief Hands a filled slot over to the execution graph
+   *
+   * @param slot slot obtained from AcquireWrite()
+   * @param stage function executed by the graph for the slot. Its Status is
+   * stored in BufferRingSlot::result.
+   * @param dependencies extra nodes of the graph that must be completed
+   * before the stage. The stage always depends on the stage of the
+   * previous slot.
+   * @return Status INVALID_PARAMETER if the slot is not owned by the
+   * producer. The retval is the node of the stage.
+   */
+  Status Submit(BufferRingSlot *slot, const Stage &stage,
+                const std::vector<IExecutionGraph::NodeID> &dependencies =
+                    std::vector<IExecutionGraph::NodeID>(0));
+
+  /**
+   * @brief Gets the oldest submitted slot for the consumer
+   *
+   * @param wait if true, blocks until its stage is completed
+   * @return BufferRingSlot* slot in Reading state. nullptr if it is not
+   * ready and wait is false, or if there are no submitted slots.
+   */
+  BufferRingSlot *AcquireRead(const bool wait = true);
+
+  /**
+   * @brief Returns a slot to the producer
+   *
+   * A slot obtained from AcquireWrite() cannot be returned directly, since
+   * the consumer expects it. To drop a frame, submit it with a stage that
+   * does nothing.
+   *
+   * @param slot slot obtained from AcquireRead()
+   * @return Status INVALID_PARAMETER if the slot is not owned by the
+   * consumer
+   */
+  Status Release(BufferRingSlot *slot);
+
+ private:
+  /** Marks the stage of a slot as completed. Called by the graph */
+  void Complete(const size_t index, const Status &result);
+
+  /** Graph that runs the stages */
+  std::shared_ptr<IExecutionGraph> graph_;
+  /** Slots of the ring */
+  std::vector<BufferRingSlot> slots_;
+  /** Stages of the slots. They are kept out of the graph nodes */
+  std::vector<Stage> stages_;
+  /** Position of the next slot for the producer */
+  size_t write_pos_ = 0;
+  /** Position of the next slot for the consumer */
+  size_t read_pos_ = 0;
+  /** Number of submitted slots not read yet */
+  size_t pending_ = 0;
+  /** Sequence number of the next submitted frame */
+  uint64_t sequence_ = 0;
+  /** Node of the last submitted stage */
+  IExecutionGraph::NodeID last_node_ = -1;
+  /** Mutex of the ring */
+  std::mutex mutex_;
+  /** Condition variable for the changes of state */
+  std::condition_variable condition_;
+};
+}  // namespace cynq
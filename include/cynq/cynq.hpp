@@ -9,10 +9,20 @@
 #pragma once
 
 #include <cynq/accelerator.hpp>
+#include <cynq/buffer-ring.hpp>
 #include <cynq/datamover.hpp>
 #include <cynq/debug.hpp>
 #include <cynq/enums.hpp>
+#include <cynq/execution-event.hpp>
+#include <cynq/execution-future.hpp>
 #include <cynq/execution-graph.hpp>
+#include <cynq/execution-pool.hpp>
+#include <cynq/execution-trace.hpp>
 #include <cynq/hardware.hpp>
+#include <cynq/inline-function.hpp>
+#include <cynq/memory-span.hpp>
 #include <cynq/memory.hpp>
+#include <cynq/placement.hpp>
 #include <cynq/status.hpp>
+#include <cynq/tensor.hpp>
+#include <cynq/transfer-channel.hpp>
@@ -7,8 +7,14 @@
  *
  */
 #pragma once
+#include <array>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <cynq/execution-future.hpp>
 #include <cynq/execution-graph.hpp>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "cynq/enums.hpp"
 #include "cynq/memory.hpp"
@@ -31,6 +37,183 @@ struct DataMoverParameters {
 
 struct HardwareParameters;
 
+/**
+ * @brief Counters of the buffer pool of a data mover
+ */
+struct BufferPoolStatistics {
+  /** Number of buffers served from the pool */
+  uint64_t hits = 0;
+  /** Number of buffers allocated because the pool had none */
+  uint64_t misses = 0;
+  /** Number of buffers returned to the pool */
+  uint64_t recycled = 0;
+  /** Number of buffers freed because of the limit or a trim */
+  uint64_t evicted = 0;
+  /** Number of buffers currently cached */
+  size_t cached_buffers = 0;
+  /** Number of bytes currently cached */
+  size_t cached_bytes = 0;
+  /** Maximum number of bytes cached at the same time */
+  size_t peak_cached_bytes = 0;
+  /** Limit of cached bytes (high-water mark) */
+  size_t limit = 0;
+  /** Number of host allocations that did not get the requested pages or
+      NUMA node (see HostMemoryOptions) */
+  uint64_t host_fallbacks = 0;
+};
+
+/**
+ * @brief Placement of the host memory of the buffers
+ *
+ * It applies to the host-only buffers (MemoryType::Host) and to the host
+ * staging side of the dual buffers (MemoryType::Dual). On multi-socket
+ * hosts, the NUMA node close to the PCIe root complex of the card avoids the
+ * inter-socket link, and the huge pages reduce the TLB and IOMMU misses of
+ * the transfers.
+ */
+struct HostMemoryOptions {
+  /** Page size of a regular page */
+  static constexpr size_t kDefaultPage = 0;
+  /** Page size of a 2 MiB huge page */
+  static constexpr size_t kHugePage2M = 2ul << 20;
+  /** Page size of a 1 GiB huge page */
+  static constexpr size_t kHugePage1G = 1ul << 30;
+
+  /** NUMA node of the allocations. -1 keeps the default placement */
+  int numa_node = -1;
+  /**
+   * Page size: kDefaultPage, kHugePage2M or kHugePage1G. The buffers smaller
+   * than a huge page use the largest page size that fits them
+   */
+  size_t page_size = kDefaultPage;
+  /**
+   * If true, the allocations fail if the pages or the NUMA node are not
+   * available. Otherwise, they fall back to smaller pages and to the
+   * default placement
+   */
+  bool strict = false;
+};
+
+/**
+ * @brief Completion of the transfers of a DMA engine
+ *
+ * The polling keeps a core busy during the whole transfer. The interrupt
+ * modes block on the completion interrupt of each channel (IOC), exposed to
+ * the user space through UIO (i.e. a generic-uio node in the device tree).
+ * The channels without interrupt keep polling.
+ */
+struct CompletionOptions {
+  /** Completion mode */
+  CompletionMode mode = CompletionMode::Polling;
+  /** IRQ of the host-to-device channel as given to PYNQ_openUIO(). -1 if
+      unused */
+  int write_irq = -1;
+  /** IRQ of the device-to-host channel as given to PYNQ_openUIO(). -1 if
+      unused */
+  int read_irq = -1;
+  /** UIO device of the host-to-device channel (i.e. /dev/uio4). It takes
+      precedence over the IRQ */
+  std::string write_uio;
+  /** UIO device of the device-to-host channel. It takes precedence over the
+      IRQ */
+  std::string read_uio;
+  /** Time spinning before blocking in the hybrid mode */
+  std::chrono::microseconds spin{20};
+  /** Maximum blocking time before checking the engine again. It bounds the
+      wait if an interrupt is lost. 0 blocks indefinitely */
+  std::chrono::milliseconds timeout{100};
+};
+
+/**
+ * @brief Scatter-gather mode of a DMA engine
+ *
+ * The transfers are described by chains of descriptors in a ring of
+ * device-visible memory, so a transfer can be longer than the length
+ * register of the engine and several buffers or slices are moved with a
+ * single doorbell. It requires an engine built with scatter-gather.
+ */
+struct ScatterGatherOptions {
+  /** Descriptors of the ring of each channel. 0 returns to the simple
+      (register) mode */
+  size_t descriptors = 0;
+  /** Width in bits of the buffer length of the engine (8 to 26). The
+      segments longer than the length are split into several descriptors */
+  unsigned int length_width = 14;
+};
+
+/**
+ * @brief Splitting of the transfers of a DMA engine in simple mode
+ *
+ * The transfers longer than the length register of the engine are split
+ * into several transfers. Moreover, the transfers can be split into chunks
+ * to overlap the cache maintenance of a chunk (the synchronisation of its
+ * buffer object) with the transfer of the previous chunk (host to device)
+ * or the next one (device to host).
+ *
+ * Each chunk is a separate stream packet (with its own TLAST), so the
+ * chunking only suits the accelerators that do not rely on the packet
+ * boundaries. The split transfers are completed before returning, so the
+ * asynchronous transfers that would be split are rejected instead of
+ * becoming blocking.
+ */
+struct TransferChunkOptions {
+  /** Chunk size picked by a one-time calibration of the cache maintenance */
+  static constexpr size_t kAutomatic = ~static_cast<size_t>(0);
+
+  /** Width in bits of the length register of the engine (8 to 26). The
+      default is the widest register, so the transfers are not split unless
+      the chunking is configured */
+  unsigned int length_width = 26;
+  /** Chunk size in bytes (at least 4 KiB) or kAutomatic. 0 only splits the
+      transfers longer than the length register */
+  size_t chunk_size = 0;
+};
+
+/**
+ * @brief Region of a memory moved by a scatter-gather transfer
+ */
+struct TransferSegment {
+  /** Memory of the region */
+  std::shared_ptr<IMemory> mem;
+  /** Size in bytes */
+  size_t size = 0;
+  /** Offset in bytes within the memory */
+  size_t offset = 0;
+};
+
+/**
+ * @brief Memory accounting of a memory bank
+ *
+ * The bytes are the ones of the buffer objects held by the memories and by
+ * the buffer pool. The imported allocations (see IDataMover::ImportBuffer())
+ * belong to the caller and are not accounted.
+ */
+struct MemoryBankStatistics {
+  /** Memory bank */
+  int bank = 0;
+  /** Bytes of the allocated buffer objects (in use and cached) */
+  size_t allocated_bytes = 0;
+  /** Bytes requested by the live memories */
+  size_t requested_bytes = 0;
+  /** Bytes of the buffer objects cached by the buffer pool */
+  size_t cached_bytes = 0;
+  /** Maximum number of allocated bytes at the same time */
+  size_t peak_bytes = 0;
+  /** Number of allocated buffer objects (in use and cached) */
+  size_t buffers = 0;
+  /** Allocated bytes per memory type, indexed by MemoryType */
+  std::array<size_t, 4> type_bytes = {0};
+  /** Maximum number of allocated bytes. 0 if unlimited */
+  size_t budget = 0;
+  /** Number of allocations rejected by the budget or the runtime */
+  uint64_t failures = 0;
+  /**
+   * Fragmentation estimate: fraction of the allocated bytes that are not
+   * used by the live memories (size-class rounding and cached buffers)
+   */
+  float fragmentation = 0.f;
+};
+
 /**
  * @brief Interface for standardising the API of DataMover for a specific
  * device:
@@ -66,6 +249,10 @@ class IDataMover {
    * typed past to the method. The memory can be mirrored with pageable
    * memory for its use in the host (or CPU).
    *
+   * The XRT-based data movers recycle the buffers of the released memories
+   * (see GetBufferPoolStatistics()), so the contents of the buffer are not
+   * initialised.
+   *
    * @param size Size in bytes of the buffer.
    *
    * @param type One of the values in the MemoryType enum class which can be
@@ -80,6 +267,67 @@ class IDataMover {
   virtual std::shared_ptr<IMemory> GetBuffer(
       const size_t size, const int memory_bank = 0,
       const MemoryType type = MemoryType::Dual) = 0;
+  /**
+   * @brief AllocateBuffer method
+   * Allocates a memory buffer like GetBuffer(), reporting the failures
+   * through the Status instead of exceptions. If the allocation would
+   * exceed the memory budget of the bank (see SetMemoryBudget()), the
+   * buffers cached by the pool for the bank are freed first, and the
+   * allocation fails fast if it still does not fit, without reaching the
+   * runtime.
+   *
+   * @param size Size in bytes of the buffer.
+   *
+   * @param mem Allocated memory (output). It is nullptr on failure.
+   *
+   * @param memory_bank Memory bank corresponding to the memory to be
+   * allocated. It is used for XRT-based data allocators.
+   *
+   * @param type One of the values in the MemoryType enum class.
+   *
+   * @return Status OUT_OF_MEMORY if the allocation exceeds the budget or the
+   * runtime cannot allocate it. NOT_IMPLEMENTED if the data mover does not
+   * support it.
+   */
+  virtual Status AllocateBuffer(const size_t size,
+                                std::shared_ptr<IMemory> &mem,
+                                const int memory_bank = 0,
+                                const MemoryType type = MemoryType::Dual);
+  /**
+   * @brief ImportBuffer method
+   * Wraps an existing host allocation as a memory without copying it (i.e.
+   * an XRT user-pointer buffer object). Decoders and network stacks can
+   * write straight into the allocation, which remains owned by the caller
+   * and must outlive the memory.
+   *
+   * If the allocation cannot be imported, the memory is not created and the
+   * caller can fall back to GetBuffer() and copy the data into it.
+   *
+   * @param ptr Host allocation. It must be aligned to ImportAlignment().
+   *
+   * @param size Size in bytes of the allocation.
+   *
+   * @param mem Memory wrapping the allocation (output). It is nullptr if
+   * the allocation is not imported.
+   *
+   * @param memory_bank Memory bank corresponding to the memory. It is used
+   * for XRT-based data allocators.
+   *
+   * @return Status INVALID_PARAMETER if the pointer is null, not aligned or
+   * the size is zero. CONFIGURATION_ERROR if the runtime rejects the
+   * allocation (i.e. it cannot be addressed by the device). NOT_IMPLEMENTED
+   * if the data mover cannot import allocations.
+   */
+  virtual Status ImportBuffer(void *ptr, const size_t size,
+                              std::shared_ptr<IMemory> &mem,
+                              const int memory_bank = 0);
+  /**
+   * @brief ImportAlignment method
+   * Alignment required by ImportBuffer(): the page size of the system.
+   *
+   * @return size_t alignment in bytes
+   */
+  static size_t ImportAlignment();
   /**
    * @brief Upload method
    * This method moves the data from the host to the device using a DMA engine.
@@ -122,11 +370,50 @@ class IDataMover {
    * execution type, a Sync call must be performed afterwards to get coherent
    * results.
    *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
    * @return Status
    */
-  virtual Status Upload(std::shared_ptr<IExecutionGraph> graph,
-                        const std::shared_ptr<IMemory> mem, const size_t size,
-                        const size_t offset, const ExecutionType exetype);
+  virtual Status Upload(
+      std::shared_ptr<IExecutionGraph> graph,
+      const std::shared_ptr<IMemory> mem, const size_t size,
+      const size_t offset, const ExecutionType exetype,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
+
+  /**
+   * @brief Upload method (future)
+   * Please, refer to IDataMover::Upload for reference. It schedules the
+   * upload in the graph like the asynchronous overload, and returns a future
+   * with the Status of the upload. The future can be waited or awaited by a
+   * coroutine (see ExecutionFuture).
+   *
+   * @param graph Execution graph to execute on. If nullptr is passed, the
+   * execution will be synchronous and the future is ready.
+   *
+   * @param mem IMemory instance to upload.
+   *
+   * @param size Size in bytes of data being uploaded in the memory device by
+   * making use of the buffer.
+   *
+   * @param offset Offset in bytes where the device pointer should start
+   *
+   * @param exetype The execution type to use for the upload.
+   *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
+   * @return ExecutionFuture future of the upload
+   */
+  virtual ExecutionFuture UploadAsync(
+      std::shared_ptr<IExecutionGraph> graph,
+      const std::shared_ptr<IMemory> mem, const size_t size,
+      const size_t offset, const ExecutionType exetype,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
 
   /**
    * @brief Download method
@@ -167,11 +454,50 @@ class IDataMover {
    * execution type, a Sync call must be performed afterwards to get coherent
    * results.
    *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
    * @return Status
    */
-  virtual Status Download(std::shared_ptr<IExecutionGraph> graph,
-                          const std::shared_ptr<IMemory> mem, const size_t size,
-                          const size_t offset, const ExecutionType exetype);
+  virtual Status Download(
+      std::shared_ptr<IExecutionGraph> graph,
+      const std::shared_ptr<IMemory> mem, const size_t size,
+      const size_t offset, const ExecutionType exetype,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
+
+  /**
+   * @brief Download method (future)
+   * Please, refer to IDataMover::Download for reference. It schedules the
+   * download in the graph like the asynchronous overload, and returns a
+   * future with the Status of the download. The future can be waited or
+   * awaited by a coroutine (see ExecutionFuture).
+   *
+   * @param graph Execution graph to execute on. If nullptr is passed, the
+   * execution will be synchronous and the future is ready.
+   *
+   * @param mem IMemory instance to download.
+   *
+   * @param size Size in bytes of data being downloaded from the memory device
+   * by making use of the buffer.
+   *
+   * @param offset Offset in bytes where the device pointer should start
+   *
+   * @param exetype The execution type to use for the download.
+   *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
+   * @return ExecutionFuture future of the download
+   */
+  virtual ExecutionFuture DownloadAsync(
+      std::shared_ptr<IExecutionGraph> graph,
+      const std::shared_ptr<IMemory> mem, const size_t size,
+      const size_t offset, const ExecutionType exetype,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
 
   /**
    * @brief Sync method
@@ -193,10 +519,16 @@ class IDataMover {
    *
    * @param type sync type. Depending on the transaction, it will trigger sync
    *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
    * @return Status
    */
   virtual Status Sync(std::shared_ptr<IExecutionGraph> graph,
-                      const SyncType type);
+                      const SyncType type,
+                      const std::vector<IExecutionGraph::NodeID> &dependencies =
+                          std::vector<IExecutionGraph::NodeID>(0));
 
   /**
    * @brief GetStatus method
@@ -207,6 +539,145 @@ class IDataMover {
 
   virtual DeviceStatus GetStatus() = 0;
 
+  /**
+   * @brief Get the counters of the buffer pool
+   *
+   * GetBuffer() recycles the buffers of the released memories with the
+   * same size class, memory bank and memory type.
+   *
+   * @param stats counters of the pool (output)
+   * @return Status NOT_IMPLEMENTED if the data mover does not pool buffers
+   */
+  virtual Status GetBufferPoolStatistics(BufferPoolStatistics &stats);
+
+  /**
+   * @brief Set the maximum number of bytes cached by the buffer pool
+   *
+   * The released buffers that exceed the limit are freed. The cached
+   * buffers are trimmed down to the new limit.
+   *
+   * @param bytes limit in bytes. 0 disables the pool.
+   * @return Status NOT_IMPLEMENTED if the data mover does not pool buffers
+   */
+  virtual Status SetBufferPoolLimit(const size_t bytes);
+
+  /**
+   * @brief Free the buffers cached by the buffer pool
+   *
+   * @param bytes number of cached bytes to keep. By default, all the cached
+   * buffers are freed.
+   * @return Status NOT_IMPLEMENTED if the data mover does not pool buffers
+   */
+  virtual Status TrimBufferPool(const size_t bytes = 0);
+
+  /**
+   * @brief Get the memory accounting of the memory banks
+   *
+   * The accounting is shared by all the data movers of the same hardware.
+   *
+   * @param stats one entry per memory bank used so far (output)
+   * @return Status NOT_IMPLEMENTED if the data mover does not account the
+   * memory
+   */
+  virtual Status GetMemoryStatistics(std::vector<MemoryBankStatistics> &stats);
+
+  /**
+   * @brief Set the maximum number of bytes allocated in a memory bank
+   *
+   * The allocations beyond the budget fail with OUT_OF_MEMORY (see
+   * AllocateBuffer()). Lowering the budget does not free the memories in
+   * use, but it frees the cached buffers of the bank down to the budget.
+   *
+   * @param memory_bank memory bank
+   * @param bytes budget in bytes. 0 removes the budget.
+   * @return Status NOT_IMPLEMENTED if the data mover does not account the
+   * memory
+   */
+  virtual Status SetMemoryBudget(const int memory_bank, const size_t bytes);
+
+  /**
+   * @brief Set the NUMA node and page size of the host memory
+   *
+   * It applies to the host-only and dual buffers allocated afterwards by
+   * all the data movers of the same hardware. The buffers of those types
+   * cached by the buffer pool are freed. The fallbacks are counted in
+   * BufferPoolStatistics::host_fallbacks.
+   *
+   * @param options placement of the host memory
+   * @return Status INVALID_PARAMETER if the page size is not supported.
+   * NOT_IMPLEMENTED if the data mover cannot place the host memory.
+   */
+  virtual Status SetHostMemoryOptions(const HostMemoryOptions &options);
+
+  /**
+   * @brief Set the way Sync() waits for the end of the transfers
+   *
+   * It must not be called while there are transfers in flight, since the
+   * engine may be restarted to enable its interrupts.
+   *
+   * @param options completion mode and interrupts of the channels
+   * @return Status INVALID_PARAMETER if an interrupt mode has no channel
+   * with interrupt. CONFIGURATION_ERROR if the UIO devices cannot be opened.
+   * NOT_IMPLEMENTED if the data mover does not wait for a DMA engine.
+   */
+  virtual Status SetCompletionOptions(const CompletionOptions &options);
+
+  /**
+   * @brief Set the scatter-gather mode of the data mover
+   *
+   * Once enabled, Upload() and Download() also go through the descriptor
+   * rings. It must not be called while there are transfers in flight.
+   *
+   * @param options number of descriptors and length of the engine
+   * @return Status INCOMPATIBLE_PARAMETER if the engine has no
+   * scatter-gather. NOT_IMPLEMENTED if the data mover has no DMA engine.
+   */
+  virtual Status SetScatterGather(const ScatterGatherOptions &options);
+
+  /**
+   * @brief Set the splitting of the transfers into chunks
+   *
+   * It applies to the transfers issued by Upload() and Download() outside
+   * the scatter-gather mode. With TransferChunkOptions::kAutomatic, the
+   * chunk size of each memory type is calibrated on its first transfer.
+   *
+   * @param options length of the engine and chunk size
+   * @return Status INVALID_PARAMETER if the width or the chunk size is out
+   * of range. NOT_IMPLEMENTED if the data mover does not split transfers.
+   */
+  virtual Status SetTransferChunking(const TransferChunkOptions &options);
+
+  /**
+   * @brief Submit several regions as a single scatter-gather transfer
+   *
+   * The regions are gathered (host to device) or scattered (device to host)
+   * as a single stream packet. The descriptors of all of them are queued
+   * before ringing the doorbell of the engine once. If the ring is full,
+   * it waits for the oldest descriptors. The transfer is asynchronous:
+   * use Reap() or Sync() to get the completions.
+   *
+   * @param segments regions to move, in stream order
+   * @param type direction of the transfer
+   * @return Status INVALID_PARAMETER if a region is out of its memory.
+   * NOT_IMPLEMENTED if the scatter-gather mode is not enabled.
+   */
+  virtual Status Submit(const std::vector<TransferSegment> &segments,
+                        const SyncType type);
+
+  /**
+   * @brief Collect the completed scatter-gather transfers without waiting
+   *
+   * The descriptors of the finished regions are returned to the ring and
+   * the regions moved from the device are synchronised for the host.
+   *
+   * @param type direction of the transfers
+   * @param completed number of regions completed since the last call
+   * (output)
+   * @return Status REGISTER_IO_ERROR if the engine reported an error in a
+   * descriptor. NOT_IMPLEMENTED if the scatter-gather mode is not enabled.
+   */
+  virtual Status Reap(const SyncType type, size_t &completed);
+
   /**
    * @brief Create method
    * Factory method used for creating specific subclasses of IDataMover.
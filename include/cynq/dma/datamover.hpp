@@ -13,8 +13,10 @@
 #include <cynq/enums.hpp>
 #include <cynq/hardware.hpp>
 #include <cynq/status.hpp>
+#include <cynq/xrt/buffer-pool.hpp>
 #include <cynq/xrt/memory.hpp>
 #include <memory>
+#include <vector>
 
 namespace cynq {
 /**
@@ -25,6 +27,10 @@ struct DMADataMoverMeta {
   std::shared_ptr<xrt::bo> bo_;
   /** Memory type */
   MemoryType type_;
+  /** Memory bank of the buffer object */
+  int bank_ = 0;
+  /** Pool where the buffer object is returned. It can be null */
+  std::shared_ptr<XRTBufferPool> pool_;
 };
 
 /**
@@ -87,6 +93,20 @@ class DMADataMover : public IDataMover {
   std::shared_ptr<IMemory> GetBuffer(
       const size_t size, const int memory_bank = 0,
       const MemoryType type = MemoryType::Dual) override;
+  /**
+   * @brief AllocateBuffer method
+   * Allocates a memory buffer from the buffer pool, checking the memory
+   * budget of the bank.
+   *
+   * @param size Size in bytes of the buffer.
+   * @param mem Allocated memory (output).
+   * @param memory_bank Memory bank corresponding to the memory.
+   * @param type One of the values in the MemoryType enum class.
+   * @return Status
+   */
+  Status AllocateBuffer(const size_t size, std::shared_ptr<IMemory> &mem,
+                        const int memory_bank = 0,
+                        const MemoryType type = MemoryType::Dual) override;
   /**
    * @brief Upload method
    * This method moves the data from the host to the device using a DMA engine.
@@ -103,7 +123,8 @@ class DMADataMover : public IDataMover {
    * @param exetype The execution type to use for the upload, this is either
    * sync (synchronous) or async (asynchronous) execution.
    *
-   * @return Status
+   * @return Status INCOMPATIBLE_PARAMETER if the transfer is asynchronous
+   * and it must be split (see TransferChunkOptions)
    */
   Status Upload(const std::shared_ptr<IMemory> mem, const size_t size,
                 const size_t offset, const ExecutionType exetype) override;
@@ -120,7 +141,8 @@ class DMADataMover : public IDataMover {
    * @param exetype The execution type to use for the download, this is either
    * sync (synchronous) or async (asynchronous) execution.
    *
-   * @return Status
+   * @return Status INCOMPATIBLE_PARAMETER if the transfer is asynchronous
+   * and it must be split (see TransferChunkOptions)
    */
   Status Download(const std::shared_ptr<IMemory> mem, const size_t size,
                   const size_t offset, const ExecutionType exetype) override;
@@ -138,9 +160,154 @@ class DMADataMover : public IDataMover {
    *
    * @return DeviceStatus
    */
+  /**
+   * @brief ImportBuffer method
+   * Host allocations cannot be imported: the DMA engine needs physically
+   * contiguous memory and the pages of an allocation are scattered. Use
+   * GetBuffer() instead.
+   *
+   * @param ptr Host allocation aligned to the page size.
+   * @param size Size in bytes of the allocation.
+   * @param mem Memory wrapping the allocation (output). It is always
+   * nullptr.
+   * @param memory_bank Memory bank corresponding to the memory.
+   * @return Status INVALID_PARAMETER if the arguments are invalid.
+   * NOT_IMPLEMENTED otherwise.
+   */
+  Status ImportBuffer(void *ptr, const size_t size,
+                      std::shared_ptr<IMemory> &mem,
+                      const int memory_bank = 0) override;
   DeviceStatus GetStatus() override;
+  /**
+   * @brief GetBufferPoolStatistics method
+   * Gets the counters of the pool of buffer objects.
+   *
+   * @param stats counters of the pool (output)
+   * @return Status
+   */
+  Status GetBufferPoolStatistics(BufferPoolStatistics &stats) override;
+  /**
+   * @brief SetBufferPoolLimit method
+   * Sets the maximum number of bytes cached by the pool of buffer objects.
+   *
+   * @param bytes limit in bytes. 0 disables the pool.
+   * @return Status
+   */
+  Status SetBufferPoolLimit(const size_t bytes) override;
+  /**
+   * @brief TrimBufferPool method
+   * Frees the buffer objects cached by the pool.
+   *
+   * @param bytes number of cached bytes to keep
+   * @return Status
+   */
+  Status TrimBufferPool(const size_t bytes = 0) override;
+  /**
+   * @brief GetMemoryStatistics method
+   * Gets the memory accounting of the memory banks.
+   *
+   * @param stats one entry per memory bank used so far (output)
+   * @return Status
+   */
+  Status GetMemoryStatistics(std::vector<MemoryBankStatistics> &stats) override;
+  /**
+   * @brief SetMemoryBudget method
+   * Sets the maximum number of bytes allocated in a memory bank.
+   *
+   * @param memory_bank memory bank
+   * @param bytes budget in bytes. 0 removes the budget.
+   * @return Status
+   */
+  Status SetMemoryBudget(const int memory_bank, const size_t bytes) override;
+  /**
+   * @brief SetCompletionOptions method
+   * Sets the way Sync() waits for the DMA engine: polling the status
+   * register, blocking on the IOC interrupt of the channels or both.
+   *
+   * @param options completion mode and interrupts of the channels
+   * @return Status
+   */
+  Status SetCompletionOptions(const CompletionOptions &options) override;
+  /**
+   * @brief SetScatterGather method
+   * Allocates the descriptor rings of both channels and restarts the
+   * engine in scatter-gather mode.
+   *
+   * @param options number of descriptors and length of the engine
+   * @return Status
+   */
+  Status SetScatterGather(const ScatterGatherOptions &options) override;
+  /**
+   * @brief SetTransferChunking method
+   * Sets the length of the engine and the chunk size of the transfers
+   * issued in simple mode.
+   *
+   * @param options length of the engine and chunk size
+   * @return Status
+   */
+  Status SetTransferChunking(const TransferChunkOptions &options) override;
+  /**
+   * @brief Submit method
+   * Queues the descriptors of the regions and rings the doorbell once.
+   *
+   * @param segments regions to move, in stream order
+   * @param type direction of the transfer
+   * @return Status
+   */
+  Status Submit(const std::vector<TransferSegment> &segments,
+                const SyncType type) override;
+  /**
+   * @brief Reap method
+   * Collects the completed regions without waiting.
+   *
+   * @param type direction of the transfers
+   * @param completed number of regions completed since the last call
+   * (output)
+   * @return Status
+   */
+  Status Reap(const SyncType type, size_t &completed) override;
 
  private:
+  /**
+   * @brief Reaps the completed descriptors of a channel
+   *
+   * The regions moved from the device are synchronised for the host and
+   * counted for Reap().
+   *
+   * @param type direction of the channel
+   * @return Status of the descriptors
+   */
+  Status ReapDescriptors(const SyncType type);
+
+  /**
+   * @brief Gets the chunk size of a transfer in simple mode
+   *
+   * The chunk size is calibrated on the first call for the memory type if
+   * it is automatic.
+   *
+   * @param type memory type of the buffer
+   * @return size_t chunk size in bytes
+   */
+  size_t ChunkSize(const MemoryType type);
+
+  /**
+   * @brief Moves a region in chunks
+   *
+   * The synchronisation of the buffer object of each chunk overlaps with
+   * the transfer of the previous chunk (host to device) or the next one
+   * (device to host).
+   *
+   * @param mem memory to move
+   * @param size size in bytes of the region
+   * @param offset offset in bytes of the region
+   * @param type direction of the transfer
+   * @param chunk chunk size in bytes
+   * @return Status
+   */
+  Status TransferChunks(const std::shared_ptr<IMemory> mem, const size_t size,
+                        const size_t offset, const SyncType type,
+                        const size_t chunk);
+
   /** Data Mover Parameters */
   std::unique_ptr<DataMoverParameters> data_mover_params_;
 };
@@ -0,0 +1,109 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cynq/datamover.hpp>
+#include <cynq/status.hpp>
+#include <vector>
+
+namespace cynq {
+/**
+ * @brief Ring of scatter-gather descriptors of an AXI DMA channel
+ *
+ * The descriptors follow the layout of the AXI DMA (PG021): 64-byte
+ * aligned, chained in a circle through their next pointers. The producer
+ * pushes descriptors at the tail and the engine processes them up to the
+ * tail pointer (TAILDESC) and marks them as completed in their status.
+ * The completed descriptors are reaped from the head in order.
+ *
+ * The ring only manages the descriptor memory: the registers of the engine
+ * and the coherence of the memory are handled by the data mover.
+ */
+class DMADescriptorRing {
+ public:
+  /** Size of a descriptor (with its alignment padding) */
+  static constexpr size_t kDescriptorSize = 0x40;
+  /** Largest buffer length supported by the descriptors (26 bits) */
+  static constexpr size_t kMaxLengthWidth = 26;
+
+  /**
+   * @brief Construct a new ring and chain its descriptors
+   *
+   * @param host host address of the descriptor memory
+   * @param device device address of the descriptor memory. It must be
+   * aligned to kDescriptorSize.
+   * @param descriptors number of descriptors. The memory must hold
+   * descriptors * kDescriptorSize bytes.
+   */
+  DMADescriptorRing(uint8_t *host, const uint64_t device,
+                    const size_t descriptors);
+
+  /**
+   * @brief Drops the pending descriptors and rewinds the ring
+   *
+   * Only valid while the channel is halted. The next descriptor fetched by
+   * the engine must be Head().
+   */
+  void Reset();
+
+  /** Number of descriptors of the ring */
+  size_t Capacity() const;
+  /** Number of descriptors pushed and not reaped yet */
+  size_t Pending() const;
+  /** Number of descriptors that can be pushed */
+  size_t Available() const;
+  /** Device address of the oldest pending descriptor (CURDESC) */
+  uint64_t Head() const;
+  /** Device address of the last pushed descriptor (TAILDESC) */
+  uint64_t Tail() const;
+
+  /**
+   * @brief Pushes a descriptor at the tail
+   *
+   * @param address device address of the buffer
+   * @param length length in bytes. It must fit the length of the engine.
+   * @param sof whether the buffer starts a stream packet
+   * @param eof whether the buffer ends a stream packet
+   * @param segment region completed with this descriptor. Its memory is
+   * null for the descriptors that do not end a region
+   * @return Status INVALID_PARAMETER if the ring is full or the length does
+   * not fit in a descriptor
+   */
+  Status Push(const uint64_t address, const size_t length, const bool sof,
+              const bool eof, const TransferSegment &segment);
+
+  /**
+   * @brief Reaps the completed descriptors from the head
+   *
+   * It stops at the first descriptor not completed yet.
+   *
+   * @param segments regions completed by the reaped descriptors (appended)
+   * @return Status REGISTER_IO_ERROR if the engine reported an error in a
+   * descriptor. The descriptor is reaped anyway.
+   */
+  Status Reap(std::vector<TransferSegment> &segments);
+
+ private:
+  /** Host address of the descriptor */
+  volatile uint32_t *Descriptor(const size_t index) const;
+  /** Device address of the descriptor */
+  uint64_t Address(const size_t index) const;
+
+  /** Host address of the descriptor memory */
+  uint8_t *host_;
+  /** Device address of the descriptor memory */
+  uint64_t device_;
+  /** Regions completed by each descriptor */
+  std::vector<TransferSegment> segments_;
+  /** Index of the oldest pending descriptor */
+  size_t head_ = 0;
+  /** Number of pending descriptors */
+  size_t pending_ = 0;
+};
+}  // namespace cynq
@@ -106,4 +106,19 @@ enum class RegisterAccess {
   /** Auto-detection: for Alveo/Vitis */
   Auto,
 };
+
+/**
+ * @brief CompletionMode
+ * Way of waiting for the end of the transfers in the Sync method. This is
+ * used by the classes that implement the IDataMover interface with a DMA
+ * engine.
+ */
+enum class CompletionMode {
+  /** Spins on the status register of the engine */
+  Polling,
+  /** Blocks until the engine raises the completion interrupt */
+  Interrupt,
+  /** Spins for a while and then blocks on the completion interrupt */
+  Hybrid
+};
 }  // namespace cynq
@@ -0,0 +1,176 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <cynq/status.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+namespace cynq {
+/**
+ * @brief Execution event
+ *
+ * Synchronisation marker between execution graphs, similar to CUDA Events.
+ * An event is recorded on a graph through IExecutionGraph::RecordEvent() and
+ * completes when the graph reaches the record node. Another graph can wait
+ * for it through IExecutionGraph::WaitEvent() without blocking the host
+ * thread, since the wait happens in the worker of the waiting graph.
+ *
+ * An event can be recorded many times. The queries always refer to the most
+ * recent record at the moment of the call, whereas the waits refer to the
+ * record given by its generation: a record keeps its outcome regardless of
+ * the outcome of the later ones.
+ *
+ * If the graph is destroyed before reaching the record node, the record is
+ * discarded (together with the earlier records that are still pending): the
+ * waits for them are released with an EXECUTION_FAILED status.
+ */
+class ExecutionEvent {
+ public:
+  /**
+   * @brief Construct a new event. It is not recorded.
+   */
+  ExecutionEvent() = default;
+
+  /**
+   * @brief Factory method to create a new event
+   *
+   * @return std::shared_ptr<ExecutionEvent> new event
+   */
+  static std::shared_ptr<ExecutionEvent> Create();
+
+  /**
+   * @brief Checks if the event is completed
+   *
+   * It is a non-blocking call.
+   *
+   * @return Status OK if the most recent record is completed or the event
+   * was never recorded. RESOURCE_BUSY if it is still pending and
+   * EXECUTION_FAILED if it was discarded.
+   */
+  Status Query();
+
+  /**
+   * @brief Blocks the host until the event is completed
+   *
+   * @return Status EXECUTION_FAILED if the record was discarded
+   */
+  Status Synchronize();
+
+  /**
+   * @brief Computes the elapsed time between two completed events
+   *
+   * The time is measured between the completion of the most recent records
+   * of both events.
+   *
+   * @param start event recorded first
+   * @param end event recorded last
+   * @param ms elapsed time in milliseconds (output)
+   * @return Status INVALID_PARAMETER if any of the events was never
+   * recorded, RESOURCE_BUSY if any of them is still pending and
+   * EXECUTION_FAILED if any of them was discarded.
+   */
+  static Status ElapsedTime(const std::shared_ptr<ExecutionEvent> start,
+                            const std::shared_ptr<ExecutionEvent> end,
+                            float &ms);
+
+  /**
+   * @brief Arms the event for a new record
+   *
+   * It is used by the IExecutionGraph implementations when the record is
+   * scheduled.
+   *
+   * @return uint64_t generation of the record
+   */
+  uint64_t Arm();
+
+  /**
+   * @brief Completes a record
+   *
+   * It is used by the IExecutionGraph implementations when the graph reaches
+   * the record node. It takes the completion timestamp.
+   *
+   * @param generation generation of the record given by Arm()
+   */
+  void Signal(const uint64_t generation);
+
+  /**
+   * @brief Discards a record
+   *
+   * It is used by the IExecutionGraph implementations when the record node
+   * is dropped without running (i.e. the graph is destroyed). The waits are
+   * released with an error.
+   *
+   * @param generation generation of the record given by Arm()
+   */
+  void Abort(const uint64_t generation);
+
+  /**
+   * @brief Gets the generation of the most recent record
+   *
+   * @return uint64_t generation. It is zero if the event was never recorded
+   */
+  uint64_t Generation();
+
+  /**
+   * @brief Blocks until a record is completed
+   *
+   * It is used by the IExecutionGraph implementations to wait for an event
+   * within the graph.
+   *
+   * @param generation generation of the record to wait for
+   * @return Status EXECUTION_FAILED if the record was discarded
+   */
+  Status Wait(const uint64_t generation);
+
+  /**
+   * @brief Registers a callback for the completion of a record
+   *
+   * It is used by the streams of a shared pool to park until the event
+   * completes instead of blocking a worker. The callback runs in the thread
+   * that completes (or discards) the record and it must not block.
+   *
+   * @param generation generation of the record to wait for
+   * @param callback function called once the record is completed
+   * @return true if the callback was registered. false if the record is
+   * already completed: the callback is not registered nor called.
+   */
+  bool OnCompletion(const uint64_t generation,
+                    const std::function<void()> &callback);
+
+ private:
+  /** Mutex of the event */
+  std::mutex mutex_;
+  /** Condition variable to notify the completion */
+  std::condition_variable condition_;
+  /** Generation of the most recent record */
+  uint64_t recorded_ = 0;
+  /** Generation of the most recent completed record */
+  uint64_t completed_ = 0;
+  /** Ranges of discarded generations (first and last, both included),
+      sorted by generation */
+  std::vector<std::pair<uint64_t, uint64_t>> aborted_;
+  /** Timestamp of the most recent completed record */
+  std::chrono::steady_clock::time_point timestamp_;
+  /** Callbacks waiting for a record, with the generation of the record */
+  std::vector<std::pair<uint64_t, std::function<void()>>> callbacks_;
+
+  /** Takes the callbacks of the records completed so far. It must be called
+      with the mutex held */
+  std::vector<std::function<void()>> TakeCallbacks();
+
+  /** Checks if a completed record was discarded. It must be called with the
+      mutex held */
+  bool Discarded(const uint64_t generation) const;
+};
+}  // namespace cynq
@@ -0,0 +1,143 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <cynq/execution-graph.hpp>
+#include <cynq/status.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#include <coroutine>  // NOLINT
+/** Defined if ExecutionFuture can be awaited by C++20 coroutines */
+#define CYNQ_HAS_COROUTINES 1
+#endif
+
+namespace cynq {
+struct ExecutionFutureState;
+
+/**
+ * @brief Result of an asynchronous operation
+ *
+ * It represents an operation added to an execution graph (i.e. through
+ * IDataMover::UploadAsync()). Unlike the NodeID returned by the graph
+ * overloads, it holds the Status returned by the operation itself, and it
+ * can notify its completion without blocking any thread:
+ *
+ * - Get() blocks the caller until the operation is completed, like
+ *   std::future::get().
+ * - OnCompletion() registers a callback executed by the worker of the graph.
+ * - In C++20, the future is awaitable: co_await resumes the coroutine in the
+ *   worker of the graph once the operation is completed.
+ *
+ * The coroutines and callbacks run in the worker of the graph, so they
+ * delay the following nodes of the same graph. They must not synchronise
+ * the same graph since it would lead to a deadlock. They can add nodes to
+ * the same graph as long as it is not full (see
+ * ExecutionGraphParameters::capacity). The futures are not meant to be used
+ * while capturing a graph.
+ */
+class ExecutionFuture {
+ public:
+  /**
+   * @brief Construct an invalid future
+   */
+  ExecutionFuture() = default;
+
+  /**
+   * @brief Adds a function to the graph and gets its future
+   *
+   * @param graph execution graph where the function is added. If it is
+   * nullptr, the function is executed immediately and the future is ready.
+   * @param function auxiliar function to add for execution
+   * @param dependencies dependency nodes of the graph (see
+   * IExecutionGraph::Add())
+   * @return ExecutionFuture future of the function. If the function could not
+   * be added, the future is ready with an INVALID_PARAMETER status.
+   */
+  static ExecutionFuture Submit(
+      std::shared_ptr<IExecutionGraph> graph,
+      const IExecutionGraph::Function &function,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
+
+  /**
+   * @brief Checks if the future refers to an operation
+   *
+   * @return true if it was obtained from Submit()
+   */
+  bool Valid() const;
+
+  /**
+   * @brief ID of the node that runs the operation
+   *
+   * It can be used as a dependency of other nodes of the same graph.
+   *
+   * @return IExecutionGraph::NodeID node ID. -1 if the operation was not
+   * added to a graph.
+   */
+  IExecutionGraph::NodeID Node() const;
+
+  /**
+   * @brief Checks if the operation is completed
+   *
+   * It is a non-blocking call.
+   *
+   * @return true if completed
+   */
+  bool Ready() const;
+
+  /**
+   * @brief Waits for the operation and gets its result
+   *
+   * @return Status status returned by the operation. INVALID_PARAMETER if
+   * the future is invalid and EXECUTION_FAILED if the operation was
+   * discarded without running (i.e. the graph was destroyed before).
+   */
+  Status Get() const;
+
+  /**
+   * @brief Registers a callback for the completion of the operation
+   *
+   * Only one callback can be registered per operation. It replaces the
+   * previous one.
+   *
+   * @param callback function executed by the worker of the graph once the
+   * operation is completed. If the operation is discarded, it is executed
+   * by the thread that discards it
+   * @return true if the callback was registered. false if the operation is
+   * already completed or the future is invalid. In that case, the callback
+   * is not registered nor executed.
+   */
+  bool OnCompletion(const std::function<void()> &callback) const;
+
+#ifdef CYNQ_HAS_COROUTINES
+  /**
+   * @brief Awaiter interface: checks if the coroutine must be suspended
+   */
+  bool await_ready() const noexcept { return !this->Valid() || this->Ready(); }
+
+  /**
+   * @brief Awaiter interface: resumes the coroutine in the worker of the
+   * graph once the operation is completed
+   */
+  bool await_suspend(std::coroutine_handle<> handle) const {
+    return this->OnCompletion([handle]() { handle.resume(); });
+  }
+
+  /**
+   * @brief Awaiter interface: gets the result of the operation
+   */
+  Status await_resume() const { return this->Get(); }
+#endif
+
+ private:
+  /** State shared with the node that runs the operation */
+  std::shared_ptr<ExecutionFutureState> state_;
+};
+}  // namespace cynq
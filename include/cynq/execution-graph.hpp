@@ -6,16 +6,23 @@
  *
  */
 #pragma once
+#include <chrono>  // NOLINT
 #include <condition_variable>  // NOLINT
+#include <cstdint>
 #include <cynq/enums.hpp>
+#include <cynq/execution-event.hpp>
+#include <cynq/execution-pool.hpp>
+#include <cynq/execution-trace.hpp>
+#include <cynq/inline-function.hpp>
 #include <cynq/status.hpp>
-#include <functional>
 #include <memory>
 #include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 
 namespace cynq {
+class ExecutableGraph;
+
 /**
  * @brief Define an abstract representation of the IExecutionGraph parameters
  * with some prefilled fields
@@ -23,13 +30,53 @@ namespace cynq {
 struct ExecutionGraphParameters {
   /** Name of the stream */
   std::string name;
-  /** Timeout in microseconds: time waited until having a new element before
-      checking again. It has low impact */
+  /** Timeout in microseconds. Unused by the ExecutionStream since it is
+      event-driven: the worker and the synchronisation are notified as soon as
+      a node is added or retired. Kept for compatibility */
   uint64_t timeout = 100;
+  /** Maximum number of pending nodes. The nodes are preallocated and Add()
+      waits when the graph is full. Type::GRAPH rounds it up to a power of
+      two */
+  uint64_t capacity = 1024;
+  /** Number of worker threads used by the graph implementations that run
+      independent nodes concurrently. 0 means one per hardware thread */
+  uint64_t workers = 0;
+  /** Pool of workers shared among streams. If it is set, the ExecutionStream
+      runs on it instead of having its own thread. The SHARED_STREAM type
+      uses the process-wide pool (ExecutionPool::Default) if it is not set */
+  std::shared_ptr<ExecutionPool> pool = nullptr;
+  /** Priority of the graph. When many graphs compete for the workers of a
+      shared ExecutionPool, the ones with higher priority are dispatched
+      first. 0 is the default and negative values are meant for background
+      work. It only affects the dispatch order of the pool, not the access
+      to the shared devices (see ExecutionPool) */
+  int priority = 0;
+  /** Measure the queueing delay of the nodes (see ExecutionGraphStatistics).
+      It is disabled by default since it reads the clock twice per node */
+  bool statistics = false;
   /** Virtual destructor required for the inheritance */
   virtual ~ExecutionGraphParameters() = default;
 };
 
+/**
+ * @brief Counters of the execution of a graph
+ *
+ * The queueing delay of a node is the time since it is added until it
+ * starts. It includes the time waiting for its dependencies and for a
+ * worker. It is only measured if ExecutionGraphParameters::statistics is
+ * enabled. Otherwise, the delays are zero.
+ */
+struct ExecutionGraphStatistics {
+  /** Number of nodes executed */
+  uint64_t nodes = 0;
+  /** Accumulated queueing delay in nanoseconds */
+  uint64_t total_queue_delay = 0;
+  /** Maximum queueing delay in nanoseconds */
+  uint64_t max_queue_delay = 0;
+  /** Number of nodes completed after their deadline */
+  uint64_t deadline_misses = 0;
+};
+
 /**
  * @brief Execution Graph Interface
  *
@@ -38,9 +85,14 @@ struct ExecutionGraphParameters {
  * the ones from CUDA) or graphs, where you can have nodes that depend on two
  * different tasks.
  *
- * In the future, we plan to add support for Events. In the mean time, you
- * can synchronise using the Sync(node_id) for synchronising at a certain point
- * of the execution.
+ * The host can synchronise using the Sync(node_id) for synchronising at a
+ * certain point of the execution. Different graphs can be synchronised
+ * without blocking the host through ExecutionEvent objects, which are
+ * recorded with RecordEvent() and waited with WaitEvent().
+ *
+ * A sequence of operations can be captured once into an ExecutableGraph by
+ * enclosing the calls between BeginCapture() and EndCapture(). Then, it can
+ * be replayed many times through Launch(), similar to CUDA Graphs.
  *
  * All functions and their arguments added to the ExecutionGraph must be
  * accesible all the time that the graph is active. Otherwise, it may lead to
@@ -53,8 +105,16 @@ class IExecutionGraph {
  public:
   /**
    * @brief Underlying type for the NodeID
+   *
+   * The IDs grow with every added node. They are 64-bit wide, so they do not
+   * wrap in practice.
+   */
+  typedef int64_t NodeID;
+
+  /**
+   * @brief Maximum size in bytes of the values captured by a Function
    */
-  typedef int NodeID;
+  static constexpr size_t kFunctionCapacity = 64;
 
   /**
    * @brief Underlying type for the auxiliar functions
@@ -63,8 +123,21 @@ class IExecutionGraph {
    * This requires to all the members to be passed by value to ensure certain
    * integrity. However, all objects must be reachable by all the program,
    * especially if they are pointers.
+   *
+   * The function is stored inline within the node, so adding nodes does not
+   * allocate memory. The captured values must fit in kFunctionCapacity
+   * bytes, which is checked at compile time. Bigger captures must be opted
+   * into the heap explicitly with Function::Allocate(). It is implicitly
+   * constructible from std::function.
+   * However, the implementations of IExecutionGraph written before must
+   * override the methods with this type instead of std::function.
+   */
+  typedef InlineFunction<Status(), kFunctionCapacity> Function;
+
+  /**
+   * @brief Clock used for the deadlines and the statistics
    */
-  typedef std::function<Status()> Function;
+  typedef std::chrono::steady_clock Clock;
 
   /**
    * @brief Enum with the multiple implementations of the IExecutionGraph
@@ -73,7 +146,12 @@ class IExecutionGraph {
     /** No runtime. It is left for the future */
     None = 0,
     /** Stream or queue based graph implementation */
-    STREAM
+    STREAM,
+    /** Stream that runs on a pool of workers shared with other streams */
+    SHARED_STREAM,
+    /** Dependency graph (DAG) implementation. Independent nodes run
+        concurrently */
+    GRAPH
   };
 
   /**
@@ -96,7 +174,28 @@ class IExecutionGraph {
    */
   virtual IExecutionGraph::NodeID Add(
       const Function &function,
-      const std::vector<NodeID> dependencies = std::vector<NodeID>(0)) = 0;
+      const std::vector<NodeID> &dependencies = std::vector<NodeID>(0)) = 0;
+
+  /**
+   * @brief Adds a function with a deadline to the execution graph
+   *
+   * Same as Add(). The deadline is a hint for the scheduler: among the
+   * nodes that are ready, the ones with the earliest deadline are dispatched
+   * first, as long as the order of the implementation allows it (a stream is
+   * always FIFO). The nodes completed after their deadline are counted as
+   * misses in the statistics. The deadlines are ignored while capturing.
+   * They do not preempt running nodes nor reorder the operations already
+   * issued to the devices (see ExecutionPool).
+   *
+   * @param function auxiliar function to add for execution
+   * @param dependencies dependency nodes of the graph (see Add())
+   * @param deadline time point when the node is expected to be completed
+   * @return NodeID id of the newly added node. If the NodeID is -1, it means
+   * that the function could not be added.
+   */
+  virtual IExecutionGraph::NodeID Add(const Function &function,
+                                      const std::vector<NodeID> &dependencies,
+                                      const Clock::time_point deadline);
 
   /**
    * @brief Synchronises the execution of the graph
@@ -121,6 +220,102 @@ class IExecutionGraph {
    */
   virtual Status GetLastError() = 0;
 
+  /**
+   * @brief Get the counters of the execution
+   *
+   * They are collected since the creation of the graph.
+   *
+   * @param stats counters of the graph (output)
+   * @return Status NOT_IMPLEMENTED if the implementation does not collect
+   * statistics
+   */
+  virtual Status GetStatistics(ExecutionGraphStatistics &stats);
+
+  /**
+   * @brief Starts the capture of the graph
+   *
+   * After calling this method, the nodes added to the graph are not executed.
+   * Instead, they are recorded into an ExecutableGraph that is returned by
+   * EndCapture(). The NodeIDs returned by Add() during the capture are local
+   * to the captured graph: they can be used as dependencies of the captured
+   * nodes and to patch them through ExecutableGraph::Update(), but not to
+   * synchronise the graph.
+   *
+   * @return Status RESOURCE_BUSY if there is a capture in progress and
+   * NOT_IMPLEMENTED if the implementation does not support captures
+   */
+  virtual Status BeginCapture();
+
+  /**
+   * @brief Ends the capture of the graph
+   *
+   * The graph returns to its normal operation, executing the nodes added
+   * after this call.
+   *
+   * @return std::shared_ptr<ExecutableGraph> immutable graph with the
+   * captured nodes. It is nullptr if there was no capture in progress.
+   */
+  virtual std::shared_ptr<ExecutableGraph> EndCapture();
+
+  /**
+   * @brief Launches a captured graph
+   *
+   * By default, it adds the whole captured graph as a single node, so the
+   * host overhead does not depend on the number of captured nodes. The
+   * captured nodes run in the capture order within the same worker. The
+   * implementations that run nodes in parallel may expand the captured
+   * nodes instead (see ExecutionGraph::Launch()).
+   *
+   * The events recorded within the capture are armed again on each launch,
+   * so the waits scheduled after the launch refer to it.
+   *
+   * @param exec captured graph to launch. The launch holds a reference to it
+   * until it is completed.
+   * @param dependencies dependency nodes of the graph (see Add())
+   * @return NodeID id of the node that runs the captured graph. If the
+   * NodeID is -1, it means that it could not be added.
+   */
+  virtual NodeID Launch(
+      std::shared_ptr<ExecutableGraph> exec,
+      const std::vector<NodeID> &dependencies = std::vector<NodeID>(0));
+
+  /**
+   * @brief Records an event in the graph
+   *
+   * The event completes when the graph executes the record node. In the
+   * case of streams, it happens when all the previously added nodes are
+   * completed. For dependency graphs, the record node runs after its
+   * dependencies. Within a capture, the event is armed on each launch of
+   * the captured graph.
+   *
+   * @param event event to record
+   * @param dependencies dependency nodes of the graph (see Add())
+   * @return NodeID id of the record node. If the NodeID is -1, it means that
+   * it could not be added.
+   */
+  virtual NodeID RecordEvent(
+      std::shared_ptr<ExecutionEvent> event,
+      const std::vector<NodeID> &dependencies = std::vector<NodeID>(0));
+
+  /**
+   * @brief Waits for an event within the graph
+   *
+   * The nodes that come after the wait node (in the case of streams) or
+   * depend on it (in the case of dependency graphs) do not execute until
+   * the most recent record of the event is completed. The host is not
+   * blocked: the wait happens in the worker of the graph. If the event was
+   * never recorded, the wait node completes immediately. Within a capture,
+   * the wait refers to the most recent record at the moment of each launch.
+   *
+   * @param event event to wait for
+   * @param dependencies dependency nodes of the graph (see Add())
+   * @return NodeID id of the wait node. If the NodeID is -1, it means that
+   * it could not be added.
+   */
+  virtual NodeID WaitEvent(
+      std::shared_ptr<ExecutionEvent> event,
+      const std::vector<NodeID> &dependencies = std::vector<NodeID>(0));
+
   /**
    * Default destructor
    */
@@ -152,6 +347,181 @@ class IExecutionGraph {
     std::vector<Node *> parents = {};
     /** Pointers to the children nodes */
     std::vector<Node *> children = {};
+    /** Time when the node was added */
+    Clock::time_point enqueued = {};
+    /** Time when the node is expected to be completed. No deadline by
+        default */
+    Clock::time_point deadline = Clock::time_point::max();
+    /** Label of the node for tracing (see ExecutionTrace::Label) */
+    const char *label = nullptr;
+    /** Event waited by the node, if any (see WaitEvent()). The streams of a
+        shared pool are parked until it completes instead of blocking a
+        worker */
+    std::shared_ptr<ExecutionEvent> event = nullptr;
+    /** Generation of the record of the event waited by the node */
+    uint64_t generation = 0;
   };
 };
+
+/**
+ * @brief Captured execution graph
+ *
+ * It holds a sequence of nodes recorded by IExecutionGraph::BeginCapture()
+ * and IExecutionGraph::EndCapture(). Once the capture ends, the graph is
+ * immutable: it is not possible to add more nodes, but it is possible to
+ * patch the function of a node between launches through Update().
+ *
+ * The scalar arguments passed by pointer (i.e. IAccelerator::Write) are read
+ * when the node runs, so they can be patched by changing the value pointed.
+ * The buffer bindings (i.e. IAccelerator::Attach) and other arguments passed
+ * by value can be patched by replacing the function of the node.
+ */
+class ExecutableGraph {
+ public:
+  /**
+   * @brief Records a node into the graph
+   *
+   * It is used by the IExecutionGraph implementations during the capture.
+   *
+   * @param function auxiliar function of the node
+   * @param dependencies nodes of the captured graph that must be completed
+   * before the current one
+   * @return IExecutionGraph::NodeID id of the node within the captured graph.
+   * It is -1 if the graph is already immutable or the dependencies do not
+   * exist.
+   */
+  IExecutionGraph::NodeID Record(
+      const IExecutionGraph::Function &function,
+      const std::vector<IExecutionGraph::NodeID> &dependencies);
+
+  /**
+   * @brief Records an event record node into the graph
+   *
+   * Unlike IExecutionGraph::RecordEvent(), the event is not armed when
+   * capturing but on each launch (see Instantiate()).
+   *
+   * @param event event to record
+   * @param dependencies nodes of the captured graph that must be completed
+   * before the current one
+   * @return IExecutionGraph::NodeID id of the node within the captured graph.
+   * It is -1 if the graph is already immutable, the event is nullptr or the
+   * dependencies do not exist.
+   */
+  IExecutionGraph::NodeID RecordEvent(
+      std::shared_ptr<ExecutionEvent> event,
+      const std::vector<IExecutionGraph::NodeID> &dependencies);
+
+  /**
+   * @brief Records an event wait node into the graph
+   *
+   * The node waits for the most recent record of the event at the moment of
+   * each launch (see Instantiate()).
+   *
+   * @param event event to wait for
+   * @param dependencies nodes of the captured graph that must be completed
+   * before the current one
+   * @return IExecutionGraph::NodeID id of the node within the captured graph.
+   * It is -1 if the graph is already immutable, the event is nullptr or the
+   * dependencies do not exist.
+   */
+  IExecutionGraph::NodeID WaitEvent(
+      std::shared_ptr<ExecutionEvent> event,
+      const std::vector<IExecutionGraph::NodeID> &dependencies);
+
+  /**
+   * @brief Runs the captured nodes
+   *
+   * The nodes run in the capture order, which respects the dependencies. The
+   * execution stops at the first node that fails.
+   *
+   * @return Status of the first failing node or OK
+   */
+  Status Run();
+
+  /**
+   * @brief Gets the functions of a single launch
+   *
+   * The functions of the event nodes are bound to the records of this launch:
+   * the recorded events are armed and the waits take the most recent record
+   * of their events. If a record function is destroyed without running, the
+   * record is discarded (see ExecutionEvent::Abort()).
+   *
+   * @return std::vector<IExecutionGraph::Function> functions of the launch.
+   * The index is the node id
+   */
+  std::vector<IExecutionGraph::Function> Instantiate() const;
+
+  /**
+   * @brief Replaces the function of a captured node
+   *
+   * It must not be called while a launch of the graph is in flight.
+   *
+   * @param node id of the node within the captured graph
+   * @param function new auxiliar function of the node
+   * @return Status INVALID_PARAMETER if the node does not exist or it is an
+   * event node
+   */
+  Status Update(const IExecutionGraph::NodeID node,
+                const IExecutionGraph::Function &function);
+
+  /**
+   * @brief Number of captured nodes
+   *
+   * @return size_t number of nodes
+   */
+  size_t Size() const;
+
+  /**
+   * @brief Number of captured event record and wait nodes
+   *
+   * @return size_t number of event nodes
+   */
+  size_t Events() const;
+
+  /**
+   * @brief Captured nodes
+   *
+   * The index is the node id. The functions of the event nodes are empty:
+   * use Instantiate() to get the functions of a launch.
+   *
+   * @return const std::vector<IExecutionGraph::Node>& captured nodes
+   */
+  const std::vector<IExecutionGraph::Node> &Nodes() const;
+
+  /**
+   * @brief Makes the graph immutable
+   *
+   * It is called by the IExecutionGraph implementations when the capture
+   * ends. Record() fails afterwards.
+   */
+  void Freeze();
+
+ private:
+  /** Captured nodes. The index is the node id */
+  std::vector<IExecutionGraph::Node> nodes_;
+  /** Flag to indicate that no more nodes are accepted */
+  bool frozen_ = false;
+  /** Events of the event nodes. The index is the node id */
+  std::vector<std::shared_ptr<ExecutionEvent>> events_;
+  /** Flags to indicate whether the event node records (true) or waits for
+      (false) its event. The index is the node id */
+  std::vector<bool> records_;
+  /** Number of event nodes */
+  size_t event_nodes_ = 0;
+
+  /**
+   * @brief Records a node into the graph, optionally bound to an event
+   *
+   * @param function auxiliar function of the node (empty for event nodes)
+   * @param dependencies nodes of the captured graph that must be completed
+   * before the current one
+   * @param event event of the node or nullptr if it is a regular node
+   * @param record whether the node records or waits for the event
+   * @return IExecutionGraph::NodeID id of the node or -1 if it is invalid
+   */
+  IExecutionGraph::NodeID Record(
+      const IExecutionGraph::Function &function,
+      const std::vector<IExecutionGraph::NodeID> &dependencies,
+      std::shared_ptr<ExecutionEvent> event, const bool record);
+};
 }  // namespace cynq
@@ -0,0 +1,193 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <cynq/enums.hpp>
+#include <cynq/execution-graph.hpp>
+#include <cynq/status.hpp>
+#include <memory>
+#include <vector>
+
+namespace cynq {
+/**
+ * @brief ExecutionGraph Implementation
+ *
+ * This implementation is used to create execution graphs for asynchronous
+ * running as a directed acyclic graph (DAG). Each node is released as soon
+ * as all its dependencies (parents) are completed, and the released nodes
+ * are executed concurrently by a pool of workers. The number of workers is
+ * given by ExecutionGraphParameters::workers.
+ *
+ * Unlike the ExecutionStream, a node without dependencies does not wait for
+ * the previously added nodes. The order must be expressed through the
+ * dependencies passed to Add(). Among the released nodes, the ones with the
+ * earliest deadline run first, and the ones without deadline run in the
+ * order they were added.
+ *
+ * All functions and their arguments added to the ExecutionGraph must be
+ * accesible all the time that the graph is active. Otherwise, it may lead to
+ * catastrophic errors.
+ */
+class ExecutionGraph : public IExecutionGraph {
+ public:
+  /**
+   * @brief Construct a new execution graph.
+   *
+   * @param params parameters of the graph.
+   */
+  explicit ExecutionGraph(std::shared_ptr<ExecutionGraphParameters> params);
+
+  /**
+   * @brief Adds a function to the execution graph
+   *
+   * This adds a new node to the graph for further execution. The node runs
+   * once all its dependencies are completed. If it does not have pending
+   * dependencies, it is ready to run immediately.
+   *
+   * @param function auxiliar function to add for execution. It is a lambda
+   * function with all elements passed by value (recommended) and all the
+   * variables used must be reachable.
+   * @param dependencies nodes that must be completed before executing the
+   * new node. The completed dependencies are ignored.
+   * @return NodeID id of the newly added node. If the NodeID is -1, it means
+   * that the function could not be added because one of the dependencies
+   * never existed.
+   */
+  NodeID Add(const IExecutionGraph::Function &function,
+             const std::vector<IExecutionGraph::NodeID> &dependencies =
+                 std::vector<IExecutionGraph::NodeID>(0)) override;
+
+  /**
+   * @brief Adds a function with a deadline to the execution graph
+   *
+   * Same as Add(). Once released, the node runs before the released nodes
+   * with later deadlines.
+   *
+   * @param function auxiliar function to add for execution
+   * @param dependencies nodes that must be completed before executing the
+   * new node. The completed dependencies are ignored.
+   * @param deadline time point when the node is expected to be completed
+   * @return NodeID id of the newly added node. If the NodeID is -1, it means
+   * that the function could not be added because one of the dependencies
+   * never existed.
+   */
+  NodeID Add(const IExecutionGraph::Function &function,
+             const std::vector<IExecutionGraph::NodeID> &dependencies,
+             const IExecutionGraph::Clock::time_point deadline) override;
+
+  /**
+   * @brief Synchronises the execution of the graph
+   *
+   * It synchronises the execution of the graph partially or completely. This
+   * is a blocking call, meaning that it will wait until the execution is
+   * completed. If the node passed by argument already executed, it returns
+   * immediately. Otherwise, it will wait until a notification of completion.
+   *
+   * @param node wait until the node is completed (defaults to: -1), which
+   * means that it will block until all the nodes added so far are completed.
+   * @return Status
+   */
+  Status Sync(const IExecutionGraph::NodeID node = -1) override;
+
+  /**
+   * @brief Get the Last Error found during the execution
+   *
+   * It returns the last error that happened during the execution.
+   *
+   * @return Status status object with the error
+   */
+  Status GetLastError() override;
+
+  /**
+   * @brief Get the counters of the execution
+   *
+   * See IExecutionGraph::GetStatistics()
+   *
+   * @param stats counters of the graph (output)
+   * @return Status
+   */
+  Status GetStatistics(ExecutionGraphStatistics &stats) override;
+
+  /**
+   * @brief Starts the capture of the graph
+   *
+   * The nodes added afterwards are recorded instead of executed. See
+   * IExecutionGraph::BeginCapture()
+   *
+   * @return Status RESOURCE_BUSY if there is a capture in progress
+   */
+  Status BeginCapture() override;
+
+  /**
+   * @brief Ends the capture of the graph
+   *
+   * See IExecutionGraph::EndCapture()
+   *
+   * @return std::shared_ptr<ExecutableGraph> captured graph or nullptr if
+   * there was no capture in progress
+   */
+  std::shared_ptr<ExecutableGraph> EndCapture() override;
+
+  /**
+   * @brief Launches a captured graph
+   *
+   * Unlike IExecutionGraph::Launch(), the captured nodes are added as nodes
+   * of the graph with their captured dependencies, so they run concurrently
+   * as any other node. The captured nodes without dependencies depend on
+   * the dependencies of the launch. As in the rest of the graph, a failing
+   * node does not prevent its children from running.
+   *
+   * @param exec captured graph to launch
+   * @param dependencies dependency nodes of the graph (see Add())
+   * @return NodeID id of the node that joins the captured nodes. If the
+   * NodeID is -1, it means that the launch could not be added completely.
+   */
+  NodeID Launch(std::shared_ptr<ExecutableGraph> exec,
+                const std::vector<IExecutionGraph::NodeID> &dependencies =
+                    std::vector<IExecutionGraph::NodeID>(0)) override;
+
+  /**
+   * @brief Records an event in the graph
+   *
+   * See IExecutionGraph::RecordEvent()
+   *
+   * @param event event to record
+   * @param dependencies dependency nodes of the graph (see Add())
+   * @return NodeID id of the record node. If the NodeID is -1, it means that
+   * it could not be added.
+   */
+  NodeID RecordEvent(std::shared_ptr<ExecutionEvent> event,
+                     const std::vector<IExecutionGraph::NodeID> &dependencies =
+                         std::vector<IExecutionGraph::NodeID>(0)) override;
+
+  /**
+   * @brief Waits for an event within the graph
+   *
+   * See IExecutionGraph::WaitEvent()
+   *
+   * @param event event to wait for
+   * @param dependencies dependency nodes of the graph (see Add())
+   * @return NodeID id of the wait node. If the NodeID is -1, it means that
+   * it could not be added.
+   */
+  NodeID WaitEvent(std::shared_ptr<ExecutionEvent> event,
+                   const std::vector<IExecutionGraph::NodeID> &dependencies =
+                       std::vector<IExecutionGraph::NodeID>(0)) override;
+
+  /**
+   * @brief destroys the graph
+   */
+  virtual ~ExecutionGraph();
+
+ private:
+  /** Parameters of the graph */
+  std::shared_ptr<ExecutionGraphParameters> params_;
+
+  /** Worker thread used by the pool to execute the ready nodes */
+  void Worker();
+};
+}  // namespace cynq
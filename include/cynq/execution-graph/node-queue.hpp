@@ -0,0 +1,215 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>  // NOLINT
+#include <utility>
+
+namespace cynq {
+/**
+ * @brief Bounded lock-free multi-producer single-consumer queue
+ *
+ * Ring of preallocated elements with a sequence number per slot. Producers
+ * claim a position (ticket) by a compare-and-swap on the enqueue position and
+ * write the element in place. The consumer moves the element out of the slot
+ * and releases it for the next lap. Elements are never copied by the queue.
+ *
+ * The ticket is a monotonic counter that gives the global order of the
+ * elements, so it can be used as an identifier of the element.
+ *
+ * @tparam T type of the elements. It must be default constructible and
+ * move-assignable.
+ */
+template <typename T>
+class NodeQueue {
+ public:
+  /**
+   * @brief Construct a new queue
+   *
+   * @param capacity number of preallocated slots. It is rounded up to the
+   * next power of two.
+   */
+  explicit NodeQueue(const size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+      size <<= 1;
+    }
+    mask_ = size - 1;
+    slots_ = std::make_unique<Slot[]>(size);
+    for (size_t i = 0; i < size; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueue_pos_.store(0, std::memory_order_relaxed);
+    dequeue_pos_.store(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Try to push an element in place
+   *
+   * It claims the next slot and calls writer(slot, ticket) to fill the
+   * preallocated element.
+   *
+   * @param writer functor with signature void(T &, size_t)
+   * @param ticket ticket of the element (output)
+   * @return true if the element was pushed. false if the queue is full.
+   */
+  template <typename F>
+  bool TryPush(F &&writer, size_t &ticket) {
+    Slot *slot = nullptr;
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      size_t seq = slot->sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        /* Full */
+        return false;
+      } else {
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+
+    writer(slot->data, pos);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    ticket = pos;
+    return true;
+  }
+
+  /**
+   * @brief Push an element in place
+   *
+   * Same as TryPush(). If the queue is full, the producer yields until the
+   * consumer releases a slot.
+   *
+   * @param writer functor with signature void(T &, size_t)
+   * @return size_t ticket of the element
+   */
+  template <typename F>
+  size_t Push(F &&writer) {
+    size_t ticket = 0;
+    while (!TryPush(writer, ticket)) {
+      std::this_thread::yield();
+    }
+    return ticket;
+  }
+
+  /**
+   * @brief Pop an element (single consumer)
+   *
+   * @param item element where the head is moved to
+   * @return true if an element was popped. false if empty.
+   */
+  bool Pop(T &item) {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Slot &slot = slots_[pos & mask_];
+    size_t seq = slot.sequence.load(std::memory_order_acquire);
+    if (seq != pos + 1) {
+      return false;
+    }
+
+    item = std::move(slot.data);
+    slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+    dequeue_pos_.store(pos + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  /**
+   * @brief Peeks the head of the queue (single consumer)
+   *
+   * The element remains valid until it is popped. It must be called from
+   * the consumer or while the consumer is not running.
+   *
+   * @return const T* head of the queue. nullptr if empty.
+   */
+  const T *Front() const {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    const Slot &slot = slots_[pos & mask_];
+    if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+      return nullptr;
+    }
+    return &slot.data;
+  }
+
+  /**
+   * @brief Checks if the head of the queue has been published
+   *
+   * @return true if there is no element ready to be popped
+   */
+  bool Empty() const {
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    const Slot &slot = slots_[pos & mask_];
+    return slot.sequence.load(std::memory_order_acquire) != pos + 1;
+  }
+
+  /**
+   * @brief Checks if there is no free slot for a producer
+   *
+   * @return true if the queue is full
+   */
+  bool Full() const {
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    const Slot &slot = slots_[pos & mask_];
+    size_t seq = slot.sequence.load(std::memory_order_acquire);
+    return static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos) < 0;
+  }
+
+  /**
+   * @brief Number of elements claimed and not popped yet
+   *
+   * It is an approximation when there are concurrent producers.
+   *
+   * @return size_t number of elements
+   */
+  size_t Size() const {
+    return enqueue_pos_.load(std::memory_order_acquire) -
+           dequeue_pos_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Number of tickets given so far
+   *
+   * @return size_t ticket of the next element to push
+   */
+  size_t Tickets() const {
+    return enqueue_pos_.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Capacity of the queue
+   *
+   * @return size_t number of slots
+   */
+  size_t Capacity() const { return mask_ + 1; }
+
+ private:
+  /** Slot of the queue */
+  struct Slot {
+    /** Sequence number of the slot */
+    std::atomic<size_t> sequence;
+    /** Element */
+    T data;
+  };
+
+  /** Preallocated slots */
+  std::unique_ptr<Slot[]> slots_;
+  /** Mask to compute the slot from a position */
+  size_t mask_;
+  /** Position of the next element to push (shared by producers) */
+  alignas(64) std::atomic<size_t> enqueue_pos_;
+  /** Position of the next element to pop (owned by the consumer) */
+  alignas(64) std::atomic<size_t> dequeue_pos_;
+};
+}  // namespace cynq
@@ -19,6 +19,23 @@ namespace cynq {
  * This implementation is used to create execution graphs for asynchronous
  * running in a linear queue fashion, quite similar to CUDA Streams.
  *
+ * The queue is a bounded lock-free ring of preallocated nodes that accepts
+ * multiple producers and it is consumed by a single worker thread. The size
+ * of the ring is given by ExecutionGraphParameters::capacity.
+ *
+ * By default, the stream has its own worker thread. If a pool is given
+ * through ExecutionGraphParameters::pool, the stream does not create any
+ * thread: it is scheduled onto the pool while it has pending nodes and only
+ * one worker runs it at a time, keeping the FIFO order. In that case, the
+ * priority of the stream and the deadline of its next node are used by the
+ * pool to choose which stream runs first.
+ *
+ * A node that blocks (i.e. ExecutionFuture::Get() or a blocking transfer)
+ * holds the worker of the pool while it runs, so the pool deadlocks if all
+ * its workers block waiting for streams that cannot get a worker. The event
+ * waits (WaitEvent()) do not block: the stream is parked until the event
+ * completes and it is scheduled again afterwards.
+ *
  * All functions and their arguments added to the ExecutionStream must be
  * accesible all the time that the graph is active. Otherwise, it may lead to
  * catastrophic errors.
@@ -47,9 +64,55 @@ class ExecutionStream : public IExecutionGraph {
    * that the function could not be added.
    */
   NodeID Add(const IExecutionGraph::Function &function,
-             const std::vector<IExecutionGraph::NodeID> dependencies =
+             const std::vector<IExecutionGraph::NodeID> &dependencies =
                  std::vector<IExecutionGraph::NodeID>(0)) override;
 
+  /**
+   * @brief Adds a function with a deadline to the execution stream
+   *
+   * Same as Add(). The stream is FIFO, so the deadline does not reorder the
+   * nodes. It is used by the shared pool to prioritise the stream and to
+   * count the deadline misses.
+   *
+   * @param function auxiliar function to add for execution
+   * @param dependencies unused since it is implemented as a FIFO.
+   * @param deadline time point when the node is expected to be completed
+   * @return NodeID id of the newly added node. If the NodeID is -1, it means
+   * that the function could not be added.
+   */
+  NodeID Add(const IExecutionGraph::Function &function,
+             const std::vector<IExecutionGraph::NodeID> &dependencies,
+             const IExecutionGraph::Clock::time_point deadline) override;
+
+  /**
+   * @brief Records an event in the stream
+   *
+   * See IExecutionGraph::RecordEvent()
+   *
+   * @param event event to record
+   * @param dependencies unused since it is implemented as a FIFO.
+   * @return NodeID id of the record node. If the NodeID is -1, it means that
+   * it could not be added.
+   */
+  NodeID RecordEvent(std::shared_ptr<ExecutionEvent> event,
+                     const std::vector<IExecutionGraph::NodeID> &dependencies =
+                         std::vector<IExecutionGraph::NodeID>(0)) override;
+
+  /**
+   * @brief Waits for an event within the stream
+   *
+   * See IExecutionGraph::WaitEvent(). If the stream runs on a shared pool,
+   * it releases the worker until the event completes.
+   *
+   * @param event event to wait for
+   * @param dependencies unused since it is implemented as a FIFO.
+   * @return NodeID id of the wait node. If the NodeID is -1, it means that
+   * it could not be added.
+   */
+  NodeID WaitEvent(std::shared_ptr<ExecutionEvent> event,
+                   const std::vector<IExecutionGraph::NodeID> &dependencies =
+                       std::vector<IExecutionGraph::NodeID>(0)) override;
+
   /**
    * @brief Synchronises the execution of the stream
    *
@@ -73,6 +136,36 @@ class ExecutionStream : public IExecutionGraph {
    */
   Status GetLastError() override;
 
+  /**
+   * @brief Get the counters of the execution
+   *
+   * See IExecutionGraph::GetStatistics()
+   *
+   * @param stats counters of the stream (output)
+   * @return Status
+   */
+  Status GetStatistics(ExecutionGraphStatistics &stats) override;
+
+  /**
+   * @brief Starts the capture of the stream
+   *
+   * The nodes added afterwards are recorded instead of executed. See
+   * IExecutionGraph::BeginCapture()
+   *
+   * @return Status RESOURCE_BUSY if there is a capture in progress
+   */
+  Status BeginCapture() override;
+
+  /**
+   * @brief Ends the capture of the stream
+   *
+   * See IExecutionGraph::EndCapture()
+   *
+   * @return std::shared_ptr<ExecutableGraph> captured graph or nullptr if
+   * there was no capture in progress
+   */
+  std::shared_ptr<ExecutableGraph> EndCapture() override;
+
   /**
    * @brief destroys the stream
    */
@@ -84,5 +177,12 @@ class ExecutionStream : public IExecutionGraph {
 
   /** Worker thread used by the queue to schedule events */
   void Worker();
+
+  /** Pushes a node into the queue. The event is only given by the wait
+      nodes */
+  NodeID Enqueue(const IExecutionGraph::Function &function,
+                 const IExecutionGraph::Clock::time_point deadline,
+                 std::shared_ptr<ExecutionEvent> event,
+                 const uint64_t generation);
 };
 }  // namespace cynq
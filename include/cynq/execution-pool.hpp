@@ -0,0 +1,141 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <memory>
+
+namespace cynq {
+struct ExecutionPoolParameters;
+
+/**
+ * @brief Execution pool
+ *
+ * Fixed-size pool of worker threads shared by many execution graphs. Each
+ * worker has its own queue of tasks and, when it runs out of work, it
+ * steals tasks from the other workers. The workers sleep when there is no
+ * work at all, so the idle pools do not consume CPU.
+ *
+ * The streams created with IExecutionGraph::Type::SHARED_STREAM are
+ * scheduled onto a pool as a single task, so the FIFO order of each stream
+ * is kept while many streams share a few threads.
+ *
+ * The tasks are dispatched by priority and, within the same priority, by
+ * earliest deadline. The tasks with positive priority go to a queue shared
+ * by all the workers, which is checked before the own queue, so they do not
+ * wait behind the work of a busy worker. The priorities and the deadlines
+ * only order the dispatch of the pool: there is no arbitration at the
+ * shared devices (IAccelerator, IDataMover). Once dispatched, a node runs to
+ * completion and competes for the device with the nodes of other graphs in
+ * arrival order.
+ *
+ * A task that blocks holds its worker. The streams release the worker while
+ * they wait for an event (IExecutionGraph::WaitEvent()), but the nodes that
+ * block by other means (i.e. ExecutionFuture::Get() on a node of another
+ * stream of the same pool) can deadlock the pool if there are not more
+ * workers than blocked nodes.
+ */
+class ExecutionPool {
+ public:
+  /**
+   * @brief Unit of work scheduled in the pool
+   */
+  class Task {
+   public:
+    /**
+     * @brief Executes the task. It runs in one of the workers of the pool
+     */
+    virtual void Run() = 0;
+    /**
+     * @brief Priority of the task. Higher values run first. It is read when
+     * the task is scheduled
+     */
+    virtual int Priority() const { return 0; }
+    /**
+     * @brief Deadline of the task. Earlier deadlines run first among the
+     * tasks with the same priority. It is read when the task is scheduled
+     */
+    virtual std::chrono::steady_clock::time_point Deadline() const {
+      return std::chrono::steady_clock::time_point::max();
+    }
+    /** Virtual destructor required for the inheritance */
+    virtual ~Task() = default;
+  };
+
+  /**
+   * @brief Construct a new pool
+   *
+   * @param workers number of worker threads. 0 means one per hardware
+   * thread.
+   */
+  explicit ExecutionPool(const size_t workers = 0);
+
+  /**
+   * @brief Factory method to create a new pool
+   *
+   * @param workers number of worker threads. 0 means one per hardware
+   * thread.
+   * @return std::shared_ptr<ExecutionPool> new pool
+   */
+  static std::shared_ptr<ExecutionPool> Create(const size_t workers = 0);
+
+  /**
+   * @brief Gets the process-wide pool
+   *
+   * It is created on the first call with one worker per hardware thread.
+   *
+   * @return std::shared_ptr<ExecutionPool> process-wide pool
+   */
+  static std::shared_ptr<ExecutionPool> Default();
+
+  /**
+   * @brief Schedules a task
+   *
+   * If it is called from a worker of the pool, the task is pushed into the
+   * queue of the same worker. Otherwise, the queues are chosen in a
+   * round-robin fashion. The tasks with positive priority are pushed into
+   * the shared queue instead. The task must be alive until it runs.
+   *
+   * @param task task to run
+   */
+  void Schedule(Task *task);
+
+  /**
+   * @brief Checks if there are tasks waiting with a higher priority
+   *
+   * The tasks that run for a long time (i.e. a batch of nodes of a stream)
+   * use it to return early, so the high-priority tasks do not wait for
+   * them. The check is cheap for non-negative priorities when there is no
+   * high-priority task. For negative priorities, it also looks at the queue
+   * of every worker.
+   *
+   * @param priority priority of the running task
+   * @return true if the running task should yield the worker
+   */
+  bool ShouldYield(const int priority) const;
+
+  /**
+   * @brief Number of worker threads
+   *
+   * @return size_t number of workers
+   */
+  size_t Workers() const;
+
+  /**
+   * @brief Destroys the pool. The pending tasks are discarded
+   */
+  virtual ~ExecutionPool();
+
+ private:
+  /** Parameters of the pool */
+  std::shared_ptr<ExecutionPoolParameters> params_;
+
+  /** Worker thread of the pool */
+  void Worker(const size_t index);
+};
+}  // namespace cynq
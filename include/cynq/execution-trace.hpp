@@ -0,0 +1,142 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <chrono>  // NOLINT
+#include <cstddef>
+#include <cstdint>
+#include <cynq/status.hpp>
+#include <string>
+
+namespace cynq {
+/**
+ * @brief Execution tracer
+ *
+ * Process-wide instrumentation of the workers of the execution graphs. When
+ * it is enabled, the workers record the enqueue, start and end timestamps of
+ * every node, together with the label of the node and the name of its graph
+ * (ExecutionGraphParameters::name). The trace can be dumped as a Chrome
+ * trace (JSON), which can be opened in chrome://tracing or Perfetto:
+ *
+ * - Each worker thread is a track with the execution of the nodes, so the
+ *   gaps between nodes and the overlap among graphs are visible.
+ * - The queueing time of each node (since it is added until it starts) is
+ *   an asynchronous slice under the name of its graph.
+ *
+ * The events are written into a preallocated buffer per worker thread. Only
+ * the owner thread writes into its buffer, so the recording does not take
+ * any lock. If a buffer is full, the new events are dropped.
+ *
+ * The graph overloads of IAccelerator, IDataMover and IMemory label their
+ * nodes (i.e. "Upload" or "Start"). Custom nodes can be labelled through
+ * ExecutionTrace::Label.
+ */
+class ExecutionTrace {
+ public:
+  /**
+   * @brief Scoped label for the nodes added by the current thread
+   *
+   * The nodes added while the object is alive are labelled with the given
+   * name. The labels can be nested: the previous label is restored when the
+   * object is destroyed.
+   */
+  class Label {
+   public:
+    /**
+     * @brief Sets the label of the nodes added by the current thread
+     *
+     * @param name label. It must have static storage (i.e. a string literal)
+     * since it is kept until the trace is dumped.
+     */
+    explicit Label(const char *name);
+    /** Restores the previous label */
+    ~Label();
+    /** Non copyable */
+    Label(const Label &) = delete;
+    /** Non copyable */
+    Label &operator=(const Label &) = delete;
+
+   private:
+    /** Label to restore */
+    const char *previous_;
+  };
+
+  /**
+   * @brief Enables the recording
+   *
+   * @param capacity number of events of the buffer of each worker thread.
+   * It only applies to the buffers created afterwards.
+   */
+  static void Enable(const size_t capacity = 65536);
+
+  /**
+   * @brief Disables the recording. The recorded events are kept.
+   */
+  static void Disable();
+
+  /**
+   * @brief Checks if the recording is enabled
+   *
+   * @return true if the workers record the nodes
+   */
+  static bool Enabled();
+
+  /**
+   * @brief Discards the recorded events
+   *
+   * It must not be called while the graphs are executing nodes.
+   */
+  static void Clear();
+
+  /**
+   * @brief Dumps the recorded events as a Chrome trace
+   *
+   * @param filename path of the JSON file to write
+   * @return Status FILE_ERROR if the file cannot be written
+   */
+  static Status Dump(const std::string &filename);
+
+  /**
+   * @brief Gets the label of the nodes added by the current thread
+   *
+   * It is used by the IExecutionGraph implementations when adding a node.
+   *
+   * @return const char* label or nullptr if there is no label
+   */
+  static const char *CurrentLabel();
+
+  /**
+   * @brief Registers the name of a graph
+   *
+   * It is used by the IExecutionGraph implementations on construction. The
+   * graphs with the same name share the identifier.
+   *
+   * @param name name of the graph
+   * @return uint32_t identifier of the graph in the trace
+   */
+  static uint32_t RegisterGraph(const std::string &name);
+
+  /**
+   * @brief Records the execution of a node
+   *
+   * It is used by the workers of the IExecutionGraph implementations. It
+   * does nothing if the recording is disabled.
+   *
+   * @param graph identifier of the graph given by RegisterGraph()
+   * @param node ID of the node
+   * @param label label of the node. It can be nullptr
+   * @param enqueued time when the node was added
+   * @param start time when the node started
+   * @param end time when the node finished
+   */
+  static void Record(const uint32_t graph, const int64_t node,
+                     const char *label,
+                     const std::chrono::steady_clock::time_point enqueued,
+                     const std::chrono::steady_clock::time_point start,
+                     const std::chrono::steady_clock::time_point end);
+};
+}  // namespace cynq
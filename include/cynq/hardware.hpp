@@ -121,7 +121,9 @@ class IHardware {
    * This method is a factory method to obtain an execution stream compatible
    * with the hardware implementation. By default, it returns a new execution
    * stream similar to the CUDA Stream, which is a queue-based scheduler to
-   * manage synchronism.
+   * manage synchronism. Many streams can share the process-wide pool of
+   * workers by using the SHARED_STREAM type (see ExecutionPool), or a
+   * custom pool by setting ExecutionGraphParameters::pool.
    *
    * @param name name of the stream for debugging purposes
    *
@@ -140,6 +142,31 @@ class IHardware {
       const IExecutionGraph::Type type = IExecutionGraph::Type::STREAM,
       const std::shared_ptr<ExecutionGraphParameters> params = nullptr);
 
+  /**
+   * @brief GetExecutionStream with priority
+   *
+   * Same as GetExecutionStream(). The priority is used when the streams
+   * compete for the workers of a shared pool (SHARED_STREAM), so the
+   * latency-critical streams are dispatched before the background ones
+   * (see ExecutionGraphParameters::priority). It does not prioritise the
+   * access to the accelerators and data movers shared by the streams.
+   *
+   * @param name name of the stream for debugging purposes
+   *
+   * @param type implementation for the execution graph
+   *
+   * @param priority priority of the stream. Higher values are dispatched
+   * first. 0 is the default priority and negative values are meant for
+   * background work.
+   *
+   * @return std::shared_ptr<IExecutionGraph>
+   * Returns an execution graph instance compatible with the API of the
+   * interface IExecutionGraph
+   */
+  std::shared_ptr<IExecutionGraph> GetExecutionStream(
+      const std::string &name, const IExecutionGraph::Type type,
+      const int priority);
+
   /**
    * @brief Get clocks from the PL
    *
@@ -164,6 +191,29 @@ class IHardware {
    * @returns Status of the operation
    */
   virtual Status SetClocks(const std::vector<float> &clocks);
+  /**
+   * @brief Get the memory accounting of the memory banks
+   *
+   * It covers the buffers allocated by all the data movers of the hardware
+   * (see IDataMover::GetMemoryStatistics()).
+   *
+   * @param stats one entry per memory bank used so far (output)
+   * @returns Status NOT_IMPLEMENTED if the platform does not account the
+   * memory
+   */
+  virtual Status GetMemoryStatistics(std::vector<MemoryBankStatistics> &stats);
+  /**
+   * @brief Set the maximum number of bytes allocated in a memory bank
+   *
+   * It applies to all the data movers of the hardware (see
+   * IDataMover::SetMemoryBudget()).
+   *
+   * @param memory_bank memory bank
+   * @param bytes budget in bytes. 0 removes the budget.
+   * @returns Status NOT_IMPLEMENTED if the platform does not account the
+   * memory
+   */
+  virtual Status SetMemoryBudget(const int memory_bank, const size_t bytes);
   /**
    * @brief Create method
    * Factory method to create a hardware-specific subclasses for accelerators
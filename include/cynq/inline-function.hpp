@@ -0,0 +1,258 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace cynq {
+template <typename Signature, size_t Capacity>
+class InlineFunction;
+
+/**
+ * @brief Fixed-capacity callable wrapper
+ *
+ * Drop-in replacement of std::function that does not allocate for small
+ * callables: the callable is stored within an inline buffer of Capacity
+ * bytes. Callables that do not fit (or are over-aligned) are rejected at
+ * compile time: the lambdas must capture few values (pass big objects by
+ * pointer or by reference). The callables that cannot be reduced are stored
+ * in the heap, as std::function does, only when requested explicitly through
+ * InlineFunction::Allocate().
+ *
+ * @tparam R return type
+ * @tparam Args argument types
+ * @tparam Capacity size in bytes of the inline buffer
+ */
+template <typename R, typename... Args, size_t Capacity>
+class InlineFunction<R(Args...), Capacity> {
+ public:
+  /**
+   * @brief Construct an empty function
+   */
+  InlineFunction() noexcept = default;
+
+  /**
+   * @brief Construct an empty function
+   */
+  InlineFunction(std::nullptr_t) noexcept {}  // NOLINT
+
+  /**
+   * @brief Construct a function from a callable
+   *
+   * @param callable lambda, functor or function pointer. It must be copy
+   * constructible and it must fit in the inline buffer.
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, InlineFunction> &&
+                std::is_invocable_r_v<R, std::decay_t<F> &, Args...>>>
+  InlineFunction(F &&callable) {  // NOLINT
+    this->Emplace(std::forward<F>(callable));
+  }
+
+  /**
+   * @brief Copy constructor
+   */
+  InlineFunction(const InlineFunction &other) {
+    if (other.ops_) {
+      other.ops_->copy(storage_, other.storage_);
+      ops_ = other.ops_;
+    }
+  }
+
+  /**
+   * @brief Move constructor
+   *
+   * The moves never throw, so the containers of functions move them instead
+   * of copying. A callable whose move throws terminates the program.
+   */
+  InlineFunction(InlineFunction &&other) noexcept {
+    if (other.ops_) {
+      other.ops_->move(storage_, other.storage_);
+      ops_ = other.ops_;
+      other.Reset();
+    }
+  }
+
+  /**
+   * @brief Copy assignment
+   */
+  InlineFunction &operator=(const InlineFunction &other) {
+    if (this != &other) {
+      this->Reset();
+      if (other.ops_) {
+        other.ops_->copy(storage_, other.storage_);
+        ops_ = other.ops_;
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Move assignment
+   */
+  InlineFunction &operator=(InlineFunction &&other) noexcept {
+    if (this != &other) {
+      this->Reset();
+      if (other.ops_) {
+        other.ops_->move(storage_, other.storage_);
+        ops_ = other.ops_;
+        other.Reset();
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Empties the function, releasing the captured values
+   */
+  InlineFunction &operator=(std::nullptr_t) noexcept {
+    this->Reset();
+    return *this;
+  }
+
+  /**
+   * @brief Assigns a new callable
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, InlineFunction> &&
+                std::is_invocable_r_v<R, std::decay_t<F> &, Args...>>>
+  InlineFunction &operator=(F &&callable) {
+    this->Reset();
+    this->Emplace(std::forward<F>(callable));
+    return *this;
+  }
+
+  /**
+   * @brief Construct a function whose callable is stored in the heap
+   *
+   * Opt-in for the callables that do not fit in the inline buffer. The
+   * function allocates on construction and on every copy, as std::function.
+   *
+   * @param callable lambda, functor or function pointer. It must be copy
+   * constructible.
+   * @return function holding a heap copy of the callable
+   */
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same_v<std::decay_t<F>, InlineFunction> &&
+                std::is_invocable_r_v<R, std::decay_t<F> &, Args...>>>
+  static InlineFunction Allocate(F &&callable) {
+    using Functor = std::decay_t<F>;
+    static_assert(std::is_copy_constructible_v<Functor>,
+                  "The callable must be copy constructible");
+    return InlineFunction{
+        HeapCallable<Functor>{new Functor(std::forward<F>(callable))}};
+  }
+
+  /**
+   * @brief Destroys the function
+   */
+  ~InlineFunction() { this->Reset(); }
+
+  /**
+   * @brief Invokes the callable
+   *
+   * @throw std::bad_function_call if the function is empty
+   */
+  R operator()(Args... args) const {
+    if (!ops_) {
+      throw std::bad_function_call();
+    }
+    return ops_->invoke(const_cast<unsigned char *>(storage_),
+                        std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Checks if the function holds a callable
+   */
+  explicit operator bool() const noexcept { return ops_ != nullptr; }
+
+ private:
+  /** Type-erased operations of the stored callable */
+  struct Operations {
+    /** Calls the callable */
+    R (*invoke)(void *, Args &&...);
+    /** Copy-constructs the callable in another buffer */
+    void (*copy)(void *, const void *);
+    /** Move-constructs the callable in another buffer */
+    void (*move)(void *, void *) noexcept;
+    /** Destroys the callable */
+    void (*destroy)(void *) noexcept;
+  };
+
+  /** Heap storage of the callables given to Allocate(). The copies are
+      deep, as in std::function */
+  template <typename F>
+  struct HeapCallable {
+    explicit HeapCallable(F *f) : callable{f} {}
+    HeapCallable(const HeapCallable &other)
+        : callable{std::make_unique<F>(*other.callable)} {}
+    HeapCallable(HeapCallable &&other) noexcept = default;
+    R operator()(Args &&...args) {
+      return std::invoke(*callable, std::forward<Args>(args)...);
+    }
+    std::unique_ptr<F> callable;
+  };
+
+  /** Operations for a given callable type */
+  template <typename F>
+  static constexpr Operations kOperations = {
+      [](void *f, Args &&...args) -> R {
+        return std::invoke(*static_cast<F *>(f), std::forward<Args>(args)...);
+      },
+      [](void *dst, const void *src) {
+        ::new (dst) F(*static_cast<const F *>(src));
+      },
+      [](void *dst, void *src) noexcept {
+        ::new (dst) F(std::move(*static_cast<F *>(src)));
+      },
+      [](void *f) noexcept { static_cast<F *>(f)->~F(); }};
+
+  template <typename F>
+  void Emplace(F &&callable) {
+    using Functor = std::decay_t<F>;
+    static_assert(sizeof(Functor) <= Capacity,
+                  "The callable does not fit in the InlineFunction. Capture "
+                  "fewer values, pass them by pointer or use Allocate()");
+    static_assert(alignof(Functor) <= alignof(std::max_align_t),
+                  "The callable is over-aligned for the InlineFunction");
+    static_assert(std::is_copy_constructible_v<Functor>,
+                  "The callable must be copy constructible");
+
+    /* Null function pointers lead to empty functions */
+    using Argument = std::remove_cv_t<std::remove_reference_t<F>>;
+    if constexpr (std::is_pointer_v<Argument> ||
+                  std::is_member_pointer_v<Argument>) {
+      if (!callable) {
+        return;
+      }
+    }
+
+    ::new (storage_) Functor(std::forward<F>(callable));
+    ops_ = &kOperations<Functor>;
+  }
+
+  void Reset() noexcept {
+    if (ops_) {
+      ops_->destroy(storage_);
+      ops_ = nullptr;
+    }
+  }
+
+  /** Inline storage of the callable */
+  alignas(std::max_align_t) unsigned char storage_[Capacity];
+  /** Operations of the stored callable. nullptr if empty */
+  const Operations *ops_ = nullptr;
+};
+}  // namespace cynq
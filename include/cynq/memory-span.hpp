@@ -0,0 +1,106 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <cstddef>
+
+namespace cynq {
+/**
+ * @brief Non-owning typed view of a contiguous region
+ *
+ * It is a pointer plus a number of elements, obtained from
+ * IMemory::HostSpan() or IMemory::DeviceSpan(). Unlike
+ * IMemory::HostAddress(), it does not allocate nor count references, so it
+ * is cheap to get and copy in tight loops. It does not keep the memory
+ * alive: the memory must outlive the span.
+ *
+ * @tparam T type of the elements
+ */
+template <typename T>
+class MemorySpan {
+ public:
+  /**
+   * @brief Construct an empty span
+   */
+  constexpr MemorySpan() noexcept : data_{nullptr}, size_{0} {}
+
+  /**
+   * @brief Construct a span
+   *
+   * @param data pointer to the first element
+   * @param size number of elements
+   */
+  constexpr MemorySpan(T *data, const size_t size) noexcept
+      : data_{data}, size_{size} {}
+
+  /**
+   * @brief Pointer to the first element
+   *
+   * @return T* pointer. It is nullptr if the span is empty.
+   */
+  constexpr T *Data() const noexcept { return data_; }
+
+  /**
+   * @brief Number of elements
+   *
+   * @return size_t number of elements
+   */
+  constexpr size_t Size() const noexcept { return size_; }
+
+  /**
+   * @brief Number of bytes
+   *
+   * @return size_t size in bytes
+   */
+  constexpr size_t Bytes() const noexcept { return size_ * sizeof(T); }
+
+  /**
+   * @brief Checks if the span is empty
+   *
+   * @return true if it does not have elements
+   */
+  constexpr bool Empty() const noexcept { return 0 == size_; }
+
+  /**
+   * @brief Access an element without bounds checking
+   *
+   * @param index position of the element
+   * @return T& element
+   */
+  constexpr T &operator[](const size_t index) const noexcept {
+    return data_[index];
+  }
+
+  /**
+   * @brief Get a part of the span
+   *
+   * @param offset position of the first element
+   * @param count number of elements. It is clamped to the end of the span.
+   * @return MemorySpan<T> span of the part. It is empty if the offset
+   * exceeds the span.
+   */
+  constexpr MemorySpan<T> Subspan(const size_t offset,
+                                  const size_t count) const noexcept {
+    if (offset >= size_) {
+      return MemorySpan<T>{};
+    }
+    return MemorySpan<T>{data_ + offset,
+                         count < size_ - offset ? count : size_ - offset};
+  }
+
+  /** Iterator to the first element */
+  constexpr T *begin() const noexcept { return data_; }
+  /** Iterator past the last element */
+  constexpr T *end() const noexcept { return data_ + size_; }
+
+ private:
+  /** Pointer to the first element */
+  T *data_;
+  /** Number of elements */
+  size_t size_;
+};
+}  // namespace cynq
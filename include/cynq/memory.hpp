@@ -8,9 +8,12 @@
  */
 #pragma once
 #include <cynq/enums.hpp>
+#include <cynq/execution-future.hpp>
 #include <cynq/execution-graph.hpp>
+#include <cynq/memory-span.hpp>
 #include <cynq/status.hpp>
 #include <memory>
+#include <vector>
 
 namespace cynq {
 /**
@@ -48,6 +51,23 @@ class IMemory {
    * @return Status
    */
   virtual Status Sync(const SyncType type) = 0;
+  /**
+   * @brief Sync method (ranged)
+   * Synchronizes a region of the memory. Only the cache lines of the region
+   * are flushed or invalidated.
+   *
+   * @param type The orientation of the Synchronizaton this can be host to
+   * host to device (HostToDevice) or device to host (DeviceToHost).
+   *
+   * @param size Size in bytes of the region
+   *
+   * @param offset Offset in bytes of the region
+   *
+   * @return Status INVALID_PARAMETER if the region exceeds the memory. The
+   * default implementation synchronises the whole memory.
+   */
+  virtual Status Sync(const SyncType type, const size_t size,
+                      const size_t offset);
   /**
    * @brief Sync method (Asynchronous)
    * This function executes asynchronously through an execution graph. Please,
@@ -58,10 +78,90 @@ class IMemory {
    * @param type The orientation of the Synchronizaton this can be host to
    * host to device (HostToDevice) or device to host (DeviceToHost).
    *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
    * @return Status
    */
   virtual Status Sync(std::shared_ptr<IExecutionGraph> graph,
-                      const SyncType type);
+                      const SyncType type,
+                      const std::vector<IExecutionGraph::NodeID> &dependencies =
+                          std::vector<IExecutionGraph::NodeID>(0));
+  /**
+   * @brief Sync method (ranged and asynchronous)
+   * This function executes asynchronously through an execution graph. Please,
+   * see IMemory::Sync for more information.
+   *
+   * @param graph The execution graph to work on
+   *
+   * @param type The orientation of the Synchronizaton this can be host to
+   * host to device (HostToDevice) or device to host (DeviceToHost).
+   *
+   * @param size Size in bytes of the region
+   *
+   * @param offset Offset in bytes of the region
+   *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
+   * @return Status
+   */
+  virtual Status Sync(std::shared_ptr<IExecutionGraph> graph,
+                      const SyncType type, const size_t size,
+                      const size_t offset,
+                      const std::vector<IExecutionGraph::NodeID> &dependencies =
+                          std::vector<IExecutionGraph::NodeID>(0));
+  /**
+   * @brief Sync method (future)
+   * It schedules the synchronisation in the graph like the asynchronous
+   * overload, and returns a future with its Status. The future can be waited
+   * or awaited by a coroutine (see ExecutionFuture).
+   *
+   * @param graph The execution graph to work on. If nullptr is passed, the
+   * execution will be synchronous and the future is ready.
+   *
+   * @param type The orientation of the Synchronizaton this can be host to
+   * host to device (HostToDevice) or device to host (DeviceToHost).
+   *
+   * @param dependencies nodes of the graph that must be completed before
+   * the operation. By default, it does not have explicit dependencies (see
+   * IExecutionGraph::Add).
+   *
+   * @return ExecutionFuture future of the synchronisation
+   */
+  virtual ExecutionFuture SyncAsync(
+      std::shared_ptr<IExecutionGraph> graph, const SyncType type,
+      const std::vector<IExecutionGraph::NodeID> &dependencies =
+          std::vector<IExecutionGraph::NodeID>(0));
+  /**
+   * @brief SetDirtyTracking method
+   * Enables the tracking of the regions written by the host. While it is
+   * enabled, Sync(SyncType::HostToDevice) only flushes the regions marked
+   * through MarkDirty() (or written through a DirtyWriter) since the last
+   * synchronisation. The writes that are not marked are not flushed.
+   *
+   * @param enable true to enable the tracking. Disabling it discards the
+   * marked regions.
+   *
+   * @return Status NOT_IMPLEMENTED if the memory does not track regions
+   */
+  virtual Status SetDirtyTracking(const bool enable);
+  /**
+   * @brief MarkDirty method
+   * Marks a region as written by the host. The region is extended to whole
+   * cache lines and merged with the other marked regions. It does nothing if
+   * the tracking is disabled.
+   *
+   * @param offset Offset in bytes of the region
+   *
+   * @param size Size in bytes of the region
+   *
+   * @return Status INVALID_PARAMETER if the region exceeds the memory.
+   * NOT_IMPLEMENTED if the memory does not track regions.
+   */
+  virtual Status MarkDirty(const size_t offset, const size_t size);
   /**
    * @brief Size method
    * Gives the value for the memory size in bytes.
@@ -69,6 +169,29 @@ class IMemory {
    * @return size_t
    */
   virtual size_t Size() = 0;
+  /**
+   * @brief Slice method
+   * Creates a view of a region of the memory. The view shares the allocation
+   * of the memory (zero-copy), so one large buffer can be carved into many
+   * tensors without allocating and mapping each of them. The view can be
+   * used as any other memory: it can be attached to an accelerator, uploaded,
+   * downloaded or synchronised, and these operations only cover the region
+   * of the view.
+   *
+   * The view keeps the memory alive. Some DMA engines and accelerators
+   * require aligned addresses (i.e. 64 bytes), so the offset must honour
+   * them.
+   *
+   * @param offset Offset in bytes of the region within the memory
+   *
+   * @param size Size in bytes of the region
+   *
+   * @return std::shared_ptr<IMemory>
+   * View of the region. It is nullptr if the region exceeds the memory, if
+   * the size is zero or if the memory cannot be sliced.
+   */
+  virtual std::shared_ptr<IMemory> Slice(const size_t offset,
+                                         const size_t size);
   /**
    * @brief HostAddress method
    * Getter for the address of the host.
@@ -97,6 +220,42 @@ class IMemory {
   std::shared_ptr<T> DeviceAddress() {
     return std::reinterpret_pointer_cast<T>(this->GetDeviceAddress());
   }
+  /**
+   * @brief HostSpan method
+   * Non-owning view of the host address. The address is mapped once, so
+   * getting the span neither allocates nor counts references. Prefer it to
+   * HostAddress() in tight loops.
+   *
+   * @tparam T
+   * A type which is used for type casting within this method.
+   *
+   * @return MemorySpan<T>
+   * View of Size() / sizeof(T) elements. It is empty if the memory does
+   * not have a host address.
+   */
+  template <typename T>
+  MemorySpan<T> HostSpan() {
+    T *ptr = reinterpret_cast<T *>(this->GetHostPointer());
+    return ptr ? MemorySpan<T>{ptr, this->Size() / sizeof(T)}
+               : MemorySpan<T>{};
+  }
+  /**
+   * @brief DeviceSpan method
+   * Non-owning view of the device address. Please, see IMemory::HostSpan.
+   *
+   * @tparam T
+   * A type which is used for type casting within this method.
+   *
+   * @return MemorySpan<T>
+   * View of Size() / sizeof(T) elements. It is empty if the memory does
+   * not have a device address.
+   */
+  template <typename T>
+  MemorySpan<T> DeviceSpan() {
+    T *ptr = reinterpret_cast<T *>(this->GetDevicePointer());
+    return ptr ? MemorySpan<T>{ptr, this->Size() / sizeof(T)}
+               : MemorySpan<T>{};
+  }
 
   /**
    * @brief Create method
@@ -151,5 +310,107 @@ class IMemory {
    * @return std::shared_ptr<uint8_t>
    */
   virtual std::shared_ptr<uint8_t> GetDeviceAddress() = 0;
+  /**
+   * @brief GetHostPointer method
+   * Get the Address that belongs to the host without reference counting.
+   * The default implementation relies on GetHostAddress().
+   *
+   * @return uint8_t* address or nullptr if it is not available
+   */
+  virtual uint8_t *GetHostPointer();
+  /**
+   * @brief GetDevicePointer method
+   * Get the Address that belongs to the device without reference counting.
+   * The default implementation relies on GetDeviceAddress().
+   *
+   * @return uint8_t* address or nullptr if it is not available
+   */
+  virtual uint8_t *GetDevicePointer();
+};
+
+/**
+ * @brief Typed writer that marks the written regions of a memory
+ *
+ * It writes through the host address of the memory and marks the written
+ * elements with IMemory::MarkDirty(), so the next host to device
+ * synchronisation only flushes them. The tracking must be enabled in the
+ * memory (see IMemory::SetDirtyTracking()). Marking element by element has
+ * a cost, so prefer the ranged Write() for bulk writes.
+ *
+ * @tparam T type of the elements
+ */
+template <typename T>
+class DirtyWriter {
+ public:
+  /**
+   * @brief Construct a new writer
+   *
+   * @param mem memory to write. The writer keeps it alive.
+   */
+  explicit DirtyWriter(std::shared_ptr<IMemory> mem)
+      : mem_{mem},
+        data_{mem ? mem->HostSpan<T>().Data() : nullptr},
+        size_{mem ? mem->Size() / sizeof(T) : 0} {}
+
+  /**
+   * @brief Number of elements of the memory
+   *
+   * @return size_t number of elements
+   */
+  size_t Size() const { return size_; }
+
+  /**
+   * @brief Read an element without marking it
+   *
+   * @param index position of the element
+   * @return const T& element
+   */
+  const T &operator[](const size_t index) const { return data_[index]; }
+
+  /**
+   * @brief Write an element and mark it
+   *
+   * Each call takes the lock of the dirty tracking of the memory, so it is
+   * meant for sparse updates. Use the ranged Write() to mark many adjacent
+   * elements at once.
+   *
+   * @param index position of the element
+   * @param value value to write
+   * @return Status INVALID_PARAMETER if the memory does not have a host
+   * address or the index is out of range. Otherwise, the element is written
+   * and the status of IMemory::MarkDirty() is returned.
+   */
+  Status Write(const size_t index, const T &value) {
+    if (!data_ || index >= size_) {
+      return Status{Status::INVALID_PARAMETER,
+                    "The element is out of the memory"};
+    }
+    data_[index] = value;
+    return mem_->MarkDirty(index * sizeof(T), sizeof(T));
+  }
+
+  /**
+   * @brief Mark a range of elements and get it for writing
+   *
+   * @param index position of the first element
+   * @param count number of elements
+   * @return T* pointer to the first element. It is nullptr if the memory
+   * does not have a host address or the range is out of the memory.
+   */
+  T *Write(const size_t index, const size_t count) {
+    if (!data_ || index > size_ || count > size_ - index) {
+      return nullptr;
+    }
+    mem_->MarkDirty(index * sizeof(T), count * sizeof(T));
+    return data_ + index;
+  }
+
+ private:
+  /** Memory to write */
+  std::shared_ptr<IMemory> mem_;
+  /** Host address of the memory */
+  T *data_;
+  /** Number of elements */
+  size_t size_;
 };
 }  // namespace cynq
@@ -0,0 +1,169 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <cstddef>
+#include <cynq/accelerator.hpp>
+#include <cynq/datamover.hpp>
+#include <cynq/enums.hpp>
+#include <cynq/memory.hpp>
+#include <cynq/status.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace cynq {
+/**
+ * @brief Kernel argument that accesses a tensor
+ */
+struct PlacementArgument {
+  /** Accelerator (kernel) */
+  std::shared_ptr<IAccelerator> accelerator;
+  /** Position of the argument within the kernel */
+  uint pos = 0;
+};
+
+/**
+ * @brief Logical tensor to place in a memory bank
+ */
+struct PlacementTensor {
+  /** Name for reporting purposes */
+  std::string name;
+  /** Size in bytes */
+  size_t size = 0;
+  /** Expected bytes moved per run. It weights the bank selection */
+  size_t traffic = 0;
+  /** Memory type of the buffer */
+  MemoryType type = MemoryType::Dual;
+  /** Banks reachable by all the arguments that access the tensor */
+  std::vector<int> candidates;
+  /** Selected bank. -1 until the plan is computed */
+  int bank = -1;
+};
+
+/**
+ * @brief Expected usage of a memory bank by a plan
+ */
+struct PlacementBankUsage {
+  /** Memory bank */
+  int bank = 0;
+  /** Number of tensors placed in the bank */
+  size_t tensors = 0;
+  /** Bytes allocated in the bank */
+  size_t bytes = 0;
+  /** Expected bytes moved per run */
+  size_t traffic = 0;
+};
+
+/**
+ * @brief Bank-aware placement of the buffers of one or more kernels
+ *
+ * Instead of querying IAccelerator::GetMemoryBank() for each buffer, the
+ * tensors are declared together with the kernel arguments that access them.
+ * A tensor shared by several kernels can only go to the banks reachable by
+ * all of them (see IAccelerator::GetMemoryBanks()). Among those, the
+ * tensors with the most traffic are placed first in the candidate bank with
+ * the least expected traffic, so the bandwidth is spread across the HBM/DDR
+ * channels. The banks have unlimited capacity unless it is set through
+ * SetBankCapacity() (i.e. from MemoryBankStatistics::budget).
+ *
+ * Example:
+ *
+ * @code
+ * PlacementPlanner planner;
+ * planner.AddTensor("a", size, {{accel, 0}});
+ * planner.AddTensor("b", size, {{accel, 1}});
+ * planner.AddTensor("c", size, {{accel, 2}, {next_accel, 0}});
+ * std::vector<std::shared_ptr<IMemory>> buffers;
+ * planner.Allocate(mover, buffers);
+ * @endcode
+ */
+class PlacementPlanner {
+ public:
+  /**
+   * @brief Declares a tensor accessed by kernel arguments
+   *
+   * @param name name for reporting purposes
+   * @param size size in bytes
+   * @param arguments kernel arguments that access the tensor
+   * @param traffic expected bytes moved per run. If 0, the size is used.
+   * @param type memory type of the buffer
+   * @return Status INVALID_PARAMETER if there are no arguments or the size
+   * is 0. INCOMPATIBLE_PARAMETER if the arguments do not share any bank.
+   * The retval is the index of the tensor.
+   */
+  Status AddTensor(const std::string &name, const size_t size,
+                   const std::vector<PlacementArgument> &arguments,
+                   const size_t traffic = 0,
+                   const MemoryType type = MemoryType::Dual);
+
+  /**
+   * @brief Declares a tensor with explicit candidate banks
+   *
+   * @param name name for reporting purposes
+   * @param size size in bytes
+   * @param banks banks where the tensor can be placed
+   * @param traffic expected bytes moved per run. If 0, the size is used.
+   * @param type memory type of the buffer
+   * @return Status INVALID_PARAMETER if there are no banks or the size is 0.
+   * The retval is the index of the tensor.
+   */
+  Status AddTensor(const std::string &name, const size_t size,
+                   const std::vector<int> &banks, const size_t traffic = 0,
+                   const MemoryType type = MemoryType::Dual);
+
+  /**
+   * @brief Limits the bytes that the plan places in a bank
+   *
+   * @param bank memory bank
+   * @param bytes capacity in bytes. 0 means unlimited (default).
+   */
+  void SetBankCapacity(const int bank, const size_t bytes);
+
+  /**
+   * @brief Computes the bank of each tensor
+   *
+   * The candidate banks without room for a tensor are skipped (see
+   * SetBankCapacity()).
+   *
+   * @param usage expected usage of the banks, sorted by bank (output)
+   * @return Status INVALID_PARAMETER if there are no tensors and
+   * OUT_OF_MEMORY if a tensor does not fit in any of its candidate banks
+   */
+  Status Plan(std::vector<PlacementBankUsage> &usage);
+
+  /**
+   * @brief Allocates the buffers of all the tensors
+   *
+   * The plan is computed if needed. The allocations are done with
+   * IDataMover::AllocateBuffer(), so the memory budgets are honoured. If
+   * any allocation fails, the buffers allocated so far are released.
+   *
+   * @param mover data mover used to allocate the buffers
+   * @param buffers buffers in the order the tensors were declared (output)
+   * @return Status of the plan or the failed allocation
+   */
+  Status Allocate(std::shared_ptr<IDataMover> mover,
+                  std::vector<std::shared_ptr<IMemory>> &buffers);
+
+  /**
+   * @brief Gets the declared tensors and their banks
+   *
+   * @return const std::vector<PlacementTensor>& tensors in declaration order
+   */
+  const std::vector<PlacementTensor> &Tensors() const;
+
+ private:
+  /** Declared tensors */
+  std::vector<PlacementTensor> tensors_;
+  /** Whether the banks of the tensors are up to date */
+  bool planned_ = false;
+  /** Capacity in bytes of the banks with a limit */
+  std::map<int, size_t> capacities_;
+};
+}  // namespace cynq
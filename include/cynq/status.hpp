@@ -8,6 +8,7 @@
  */
 #pragma once
 
+#include <cstdint>
 #include <string>
 
 namespace cynq {
@@ -32,10 +33,11 @@ struct Status {
     RESOURCE_BUSY,        /** Busy */
     EXECUTION_FAILED,     /** Cannot execute the IP */
     REGISTER_NOT_ALIGNED, /** Issues with alignment when writing a reg */
+    OUT_OF_MEMORY,        /** Memory budget or device memory exhausted */
   };
 
   int code;        /** Code of the error */
-  int retval;      /** Auxiliar data coming from user */
+  int64_t retval;  /** Auxiliar data coming from user (i.e. a NodeID) */
   std::string msg; /** Description of the error */
 
   /**
@@ -65,7 +67,8 @@ struct Status {
    * @param retval return value in case of integer
    * @param msg description
    */
-  Status(const int code, const int retval, const std::string &msg) noexcept
+  Status(const int code, const int64_t retval,
+         const std::string &msg) noexcept
       : code{code}, retval{retval}, msg{msg} {}
 };
 }  // namespace cynq
@@ -0,0 +1,470 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cynq/datamover.hpp>
+#include <cynq/enums.hpp>
+#include <cynq/memory.hpp>
+#include <cynq/status.hpp>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace cynq {
+/**
+ * @brief Layout of a multi-dimensional tensor within a memory
+ *
+ * It holds the shape, the strides (in elements) and the offset (in bytes)
+ * of the tensor. It is a literal type: all its operations are constexpr, so
+ * the offsets and sizes of layouts known at compile time are computed at
+ * compile time:
+ *
+ * @code
+ * constexpr TensorLayout<uint16_t, 2> kA{{4, 8}};
+ * static_assert(kA.Bytes() == 64);
+ * constexpr auto kRow = kA.Select(0, 2);  // Third row: offset of 32 bytes
+ * @endcode
+ *
+ * @tparam T type of the elements
+ * @tparam Rank number of dimensions
+ */
+template <typename T, size_t Rank>
+class TensorLayout {
+  static_assert(Rank > 0, "The tensor must have at least one dimension");
+
+ public:
+  /** Sizes or strides of the dimensions */
+  typedef std::array<size_t, Rank> Shape;
+
+  /**
+   * @brief Construct an empty layout
+   */
+  constexpr TensorLayout() noexcept : shape_{}, strides_{}, offset_{0} {}
+
+  /**
+   * @brief Construct a row-major (contiguous) layout
+   *
+   * @param shape sizes of the dimensions
+   * @param offset offset in bytes of the first element
+   */
+  constexpr explicit TensorLayout(const Shape &shape,
+                                  const size_t offset = 0) noexcept
+      : shape_{shape}, strides_{RowMajor(shape)}, offset_{offset} {}
+
+  /**
+   * @brief Construct a strided layout
+   *
+   * @param shape sizes of the dimensions
+   * @param strides distance in elements between consecutive elements of
+   * each dimension
+   * @param offset offset in bytes of the first element
+   */
+  constexpr TensorLayout(const Shape &shape, const Shape &strides,
+                         const size_t offset) noexcept
+      : shape_{shape}, strides_{strides}, offset_{offset} {}
+
+  /**
+   * @brief Row-major strides of a shape
+   *
+   * @param shape sizes of the dimensions
+   * @return Shape strides in elements
+   */
+  static constexpr Shape RowMajor(const Shape &shape) noexcept {
+    Shape strides{};
+    size_t stride = 1;
+    for (size_t i = Rank; i > 0; --i) {
+      strides[i - 1] = stride;
+      stride *= shape[i - 1];
+    }
+    return strides;
+  }
+
+  /** Sizes of the dimensions */
+  constexpr const Shape &Dimensions() const noexcept { return shape_; }
+  /** Strides in elements of the dimensions */
+  constexpr const Shape &Strides() const noexcept { return strides_; }
+  /** Size of a dimension */
+  constexpr size_t Dimension(const size_t dim) const noexcept {
+    return shape_[dim];
+  }
+  /** Offset in bytes of the first element within the memory */
+  constexpr size_t Offset() const noexcept { return offset_; }
+
+  /**
+   * @brief Number of elements
+   *
+   * @return size_t product of the dimensions
+   */
+  constexpr size_t Elements() const noexcept {
+    size_t elements = 1;
+    for (size_t i = 0; i < Rank; ++i) {
+      elements *= shape_[i];
+    }
+    return elements;
+  }
+
+  /**
+   * @brief Size in bytes of the region covered by the tensor
+   *
+   * It goes from the first to the last element. For non-contiguous layouts,
+   * it includes the gaps between elements.
+   *
+   * @return size_t size in bytes. 0 if the tensor is empty.
+   */
+  constexpr size_t Bytes() const noexcept {
+    size_t last = 0;
+    for (size_t i = 0; i < Rank; ++i) {
+      if (0 == shape_[i]) {
+        return 0;
+      }
+      last += (shape_[i] - 1) * strides_[i];
+    }
+    return (last + 1) * sizeof(T);
+  }
+
+  /**
+   * @brief Checks if the elements are contiguous in row-major order
+   *
+   * @return true if the region has no gaps
+   */
+  constexpr bool IsContiguous() const noexcept {
+    const Shape row_major = RowMajor(shape_);
+    for (size_t i = 0; i < Rank; ++i) {
+      if (shape_[i] > 1 && strides_[i] != row_major[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Alignment of the first element
+   *
+   * It is the largest power of two that divides the offset, up to 4096. It
+   * must be combined with the alignment of the memory (page-aligned for the
+   * XRT buffers).
+   *
+   * @return size_t alignment in bytes
+   */
+  constexpr size_t Alignment() const noexcept {
+    size_t alignment = 1;
+    while (alignment < 4096 && (offset_ % (alignment << 1)) == 0) {
+      alignment <<= 1;
+    }
+    return alignment;
+  }
+
+  /**
+   * @brief Offset in bytes of an element within the memory
+   *
+   * @param index position of the element in each dimension
+   * @return size_t offset in bytes
+   */
+  constexpr size_t OffsetOf(const Shape &index) const noexcept {
+    size_t element = 0;
+    for (size_t i = 0; i < Rank; ++i) {
+      element += index[i] * strides_[i];
+    }
+    return offset_ + element * sizeof(T);
+  }
+
+  /**
+   * @brief Restricts a dimension to a range
+   *
+   * @param dim dimension to restrict
+   * @param begin first position of the range
+   * @param end position past the last one of the range. It is clamped to
+   * the size of the dimension.
+   * @return TensorLayout layout of the sub-tensor. It is empty if the
+   * dimension does not exist.
+   */
+  constexpr TensorLayout Slice(const size_t dim, const size_t begin,
+                               const size_t end) const noexcept {
+    if (dim >= Rank) {
+      return TensorLayout{Shape{}, strides_, offset_};
+    }
+    Shape shape = shape_;
+    const size_t last = end < shape_[dim] ? end : shape_[dim];
+    shape[dim] = begin < last ? last - begin : 0;
+    const size_t first = begin < last ? begin : last;
+    return TensorLayout{shape, strides_,
+                        offset_ + first * strides_[dim] * sizeof(T)};
+  }
+
+  /**
+   * @brief Fixes a dimension to a position
+   *
+   * @param dim dimension to fix
+   * @param index position in the dimension
+   * @return TensorLayout<T, Rank - 1> layout of the sub-tensor without the
+   * dimension. It is empty if the dimension or the position do not exist.
+   */
+  template <size_t R = Rank, typename = std::enable_if_t<(R > 1)>>
+  constexpr TensorLayout<T, Rank - 1> Select(const size_t dim,
+                                             const size_t index) const
+      noexcept {
+    typename TensorLayout<T, Rank - 1>::Shape shape{};
+    typename TensorLayout<T, Rank - 1>::Shape strides{};
+    if (dim >= Rank || index >= shape_[dim]) {
+      return TensorLayout<T, Rank - 1>{shape, strides, offset_};
+    }
+    for (size_t i = 0, j = 0; i < Rank; ++i) {
+      if (i != dim) {
+        shape[j] = shape_[i];
+        strides[j] = strides_[i];
+        ++j;
+      }
+    }
+    return TensorLayout<T, Rank - 1>{
+        shape, strides, offset_ + index * strides_[dim] * sizeof(T)};
+  }
+
+ private:
+  /** Sizes of the dimensions */
+  Shape shape_;
+  /** Strides in elements of the dimensions */
+  Shape strides_;
+  /** Offset in bytes of the first element */
+  size_t offset_;
+};
+
+/**
+ * @brief Typed multi-dimensional view of an IMemory
+ *
+ * It combines a TensorLayout with the memory that holds the elements. The
+ * elements are accessed through the host address, and the region of the
+ * tensor can be transferred or synchronised without computing byte offsets
+ * and sizes by hand:
+ *
+ * @code
+ * Tensor<uint16_t, 2> a{mem, {rows, cols}};
+ * a(1, 2) = 5;
+ * a.Slice(0, 0, 2).Upload(mover);  // Uploads the first two rows
+ * @endcode
+ *
+ * The partial transfers cover the region from the first to the last element
+ * of the view (see TensorLayout::Bytes()). The view keeps the memory alive.
+ *
+ * @tparam T type of the elements
+ * @tparam Rank number of dimensions
+ */
+template <typename T, size_t Rank>
+class Tensor {
+ public:
+  /** Layout of the tensor */
+  typedef TensorLayout<T, Rank> Layout;
+  /** Sizes or strides of the dimensions */
+  typedef typename Layout::Shape Shape;
+
+  /**
+   * @brief Construct an empty tensor
+   */
+  Tensor() : mem_{}, data_{nullptr}, layout_{} {}
+
+  /**
+   * @brief Construct a tensor from a layout
+   *
+   * @param mem memory that holds the elements
+   * @param layout layout of the tensor within the memory
+   */
+  Tensor(std::shared_ptr<IMemory> mem, const Layout &layout)
+      : mem_{mem},
+        data_{mem ? mem->HostSpan<uint8_t>().Data() : nullptr},
+        layout_{layout} {}
+
+  /**
+   * @brief Construct a row-major tensor
+   *
+   * @param mem memory that holds the elements
+   * @param shape sizes of the dimensions
+   * @param offset offset in bytes of the first element
+   */
+  Tensor(std::shared_ptr<IMemory> mem, const Shape &shape,
+         const size_t offset = 0)
+      : Tensor{mem, Layout{shape, offset}} {}
+
+  /** Layout of the tensor */
+  const Layout &GetLayout() const { return layout_; }
+  /** Memory that holds the elements */
+  std::shared_ptr<IMemory> Memory() const { return mem_; }
+  /** Sizes of the dimensions */
+  const Shape &Dimensions() const { return layout_.Dimensions(); }
+  /** Size of a dimension */
+  size_t Dimension(const size_t dim) const { return layout_.Dimension(dim); }
+  /** Number of elements */
+  size_t Elements() const { return layout_.Elements(); }
+  /** Offset in bytes of the first element within the memory */
+  size_t Offset() const { return layout_.Offset(); }
+  /** Size in bytes of the region covered by the tensor */
+  size_t Bytes() const { return layout_.Bytes(); }
+
+  /**
+   * @brief Checks if the tensor fits in its memory
+   *
+   * @return true if the memory holds the region of the tensor
+   */
+  bool Valid() const {
+    return mem_ && layout_.Offset() + layout_.Bytes() <= mem_->Size();
+  }
+
+  /**
+   * @brief Pointer to the first element
+   *
+   * @return T* host address. nullptr if the memory does not have a host
+   * address.
+   */
+  T *Data() const {
+    return data_ ? reinterpret_cast<T *>(data_ + layout_.Offset()) : nullptr;
+  }
+
+  /**
+   * @brief Access an element without bounds checking
+   *
+   * @param index position of the element in each dimension
+   * @return T& element
+   */
+  template <typename... Index>
+  T &operator()(const Index... index) const {
+    static_assert(sizeof...(Index) == Rank,
+                  "The number of indices must match the rank");
+    return *reinterpret_cast<T *>(
+        data_ + layout_.OffsetOf(Shape{static_cast<size_t>(index)...}));
+  }
+
+  /**
+   * @brief Restricts a dimension to a range (see TensorLayout::Slice())
+   */
+  Tensor Slice(const size_t dim, const size_t begin, const size_t end) const {
+    return Tensor{mem_, data_, layout_.Slice(dim, begin, end)};
+  }
+
+  /**
+   * @brief Fixes a dimension to a position (see TensorLayout::Select())
+   *
+   * @return Tensor<T, Rank - 1> sub-tensor. It is not valid (see Valid())
+   * if the dimension or the position do not exist.
+   */
+  template <size_t R = Rank, typename = std::enable_if_t<(R > 1)>>
+  Tensor<T, Rank - 1> Select(const size_t dim, const size_t index) const {
+    if (dim >= Rank || index >= layout_.Dimension(dim)) {
+      return Tensor<T, Rank - 1>{};
+    }
+    return Tensor<T, Rank - 1>{mem_, layout_.Select(dim, index)};
+  }
+
+  /**
+   * @brief Uploads the region of the tensor
+   *
+   * @param mover data mover to use
+   * @param exetype synchronous or asynchronous execution
+   * @return Status INVALID_PARAMETER if the tensor is not valid or the
+   * mover is nullptr
+   */
+  Status Upload(std::shared_ptr<IDataMover> mover,
+                const ExecutionType exetype = ExecutionType::Sync) const {
+    if (!mover || !this->Valid()) {
+      return Status{Status::INVALID_PARAMETER, "The tensor is not valid"};
+    }
+    return mover->Upload(mem_, layout_.Bytes(), layout_.Offset(), exetype);
+  }
+
+  /**
+   * @brief Downloads the region of the tensor
+   *
+   * @param mover data mover to use
+   * @param exetype synchronous or asynchronous execution
+   * @return Status INVALID_PARAMETER if the tensor is not valid or the
+   * mover is nullptr
+   */
+  Status Download(std::shared_ptr<IDataMover> mover,
+                  const ExecutionType exetype = ExecutionType::Sync) const {
+    if (!mover || !this->Valid()) {
+      return Status{Status::INVALID_PARAMETER, "The tensor is not valid"};
+    }
+    return mover->Download(mem_, layout_.Bytes(), layout_.Offset(), exetype);
+  }
+
+  /**
+   * @brief Synchronises the region of the tensor
+   *
+   * @param type direction of the synchronisation
+   * @return Status INVALID_PARAMETER if the tensor is not valid
+   */
+  Status Sync(const SyncType type) const {
+    if (!this->Valid()) {
+      return Status{Status::INVALID_PARAMETER, "The tensor is not valid"};
+    }
+    return mem_->Sync(type, layout_.Bytes(), layout_.Offset());
+  }
+
+  /**
+   * @brief Splits the tensor into contiguous regions
+   *
+   * Each region is a run of the innermost contiguous dimensions, so a
+   * strided tensor is moved without its gaps by a single scatter-gather
+   * transfer:
+   *
+   * @code
+   * mover->Submit(a.Slice(1, 0, 4).Segments(), SyncType::HostToDevice);
+   * @endcode
+   *
+   * @return std::vector<TransferSegment> regions in row-major order. Empty
+   * if the tensor is empty or not valid.
+   */
+  std::vector<TransferSegment> Segments() const {
+    std::vector<TransferSegment> segments;
+    if (0 == layout_.Elements() || !this->Valid()) {
+      return segments;
+    }
+    const Shape &shape = layout_.Dimensions();
+    const Shape &strides = layout_.Strides();
+
+    /* Innermost dimensions that form a contiguous run */
+    size_t run = 1;
+    size_t outer = Rank;
+    while (outer > 0 &&
+           (1 == shape[outer - 1] || strides[outer - 1] == run)) {
+      run *= shape[outer - 1];
+      --outer;
+    }
+
+    Shape index{};
+    size_t dim = 0;
+    do {
+      /* The adjacent runs are merged */
+      const size_t offset = layout_.OffsetOf(index);
+      if (!segments.empty() &&
+          segments.back().offset + segments.back().size == offset) {
+        segments.back().size += run * sizeof(T);
+      } else {
+        segments.push_back(TransferSegment{mem_, run * sizeof(T), offset});
+      }
+
+      /* Next position of the outer dimensions */
+      for (dim = outer; dim > 0 && ++index[dim - 1] == shape[dim - 1];
+           --dim) {
+        index[dim - 1] = 0;
+      }
+    } while (dim > 0);
+    return segments;
+  }
+
+ private:
+  /** Construct a sub-tensor reusing the host address */
+  Tensor(std::shared_ptr<IMemory> mem, uint8_t *data, const Layout &layout)
+      : mem_{mem}, data_{data}, layout_{layout} {}
+
+  /** Memory that holds the elements */
+  std::shared_ptr<IMemory> mem_;
+  /** Host address of the memory */
+  uint8_t *data_;
+  /** Layout of the tensor */
+  Layout layout_;
+};
+}  // namespace cynq
@@ -0,0 +1,112 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cynq/datamover.hpp>
+#include <cynq/enums.hpp>
+#include <cynq/execution-future.hpp>
+#include <cynq/execution-graph.hpp>
+#include <cynq/memory.hpp>
+#include <cynq/status.hpp>
+#include <memory>
+
+namespace cynq {
+/**
+ * @brief Queue of transfers of one direction of a data mover
+ *
+ * The upload (MM2S) and the download (S2MM) channels of a DMA engine are
+ * independent, but IDataMover::Sync() waits for a whole direction and the
+ * asynchronous transfers are not tracked one by one. A channel owns an
+ * execution stream that moves its transfers in order, so an upload channel
+ * and a download channel of the same data mover run concurrently (full
+ * duplex). Each transfer gets a handle (ExecutionFuture) that is ready once
+ * the transfer is completed:
+ *
+ * @code
+ * TransferChannel tx{mover, SyncType::HostToDevice};
+ * TransferChannel rx{mover, SyncType::DeviceToHost};
+ * ExecutionFuture in = rx.Enqueue(out_mem, size);
+ * ExecutionFuture out = tx.Enqueue(in_mem, size);
+ * in.Get();
+ * @endcode
+ *
+ * There must be at most one channel per direction and data mover, and the
+ * direction of a channel must not be used directly (Upload(), Download()
+ * or Sync()) while the channel has transfers in flight.
+ */
+class TransferChannel {
+ public:
+  /**
+   * @brief Construct a new channel
+   *
+   * @param mover data mover that runs the transfers
+   * @param type direction of the channel: HostToDevice for the uploads and
+   * DeviceToHost for the downloads
+   * @param params parameters of the execution stream of the channel. If it
+   * is nullptr, the default parameters are used.
+   */
+  TransferChannel(std::shared_ptr<IDataMover> mover, const SyncType type,
+                  std::shared_ptr<ExecutionGraphParameters> params = nullptr);
+
+  /**
+   * @brief Destroy the channel
+   *
+   * It waits for the transfers in flight.
+   */
+  ~TransferChannel();
+
+  /** Direction of the channel */
+  SyncType Type() const;
+
+  /**
+   * @brief Enqueue a transfer
+   *
+   * The transfers of the channel are executed in order.
+   *
+   * @param mem memory to move
+   * @param size size in bytes
+   * @param offset offset in bytes within the memory
+   * @return ExecutionFuture handle of the transfer. It holds the Status of
+   * the transfer once it is completed.
+   */
+  ExecutionFuture Enqueue(const std::shared_ptr<IMemory> mem,
+                          const size_t size, const size_t offset = 0);
+
+  /**
+   * @brief Waits for all the transfers enqueued so far
+   *
+   * The errors of the transfers are reported by their handles.
+   *
+   * @return Status of the synchronisation of the stream
+   */
+  Status Sync();
+
+  /** Number of transfers enqueued and not completed yet */
+  size_t Pending() const;
+  /** Number of transfers completed */
+  uint64_t Completed() const;
+  /** Number of bytes moved by the completed transfers */
+  uint64_t Bytes() const;
+
+ private:
+  /** Data mover that runs the transfers */
+  std::shared_ptr<IDataMover> mover_;
+  /** Direction of the channel */
+  SyncType type_;
+  /** Stream that executes the transfers */
+  std::shared_ptr<IExecutionGraph> stream_;
+  /** Transfers enqueued and not completed yet */
+  std::atomic<size_t> pending_{0};
+  /** Transfers completed */
+  std::atomic<uint64_t> completed_{0};
+  /** Bytes moved */
+  std::atomic<uint64_t> bytes_{0};
+};
+}  // namespace cynq
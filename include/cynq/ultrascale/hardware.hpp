@@ -20,6 +20,7 @@
 #include <cynq/hardware.hpp>
 #include <cynq/mmio/accelerator.hpp>
 #include <cynq/status.hpp>
+#include <cynq/xrt/buffer-pool.hpp>
 #include <memory>
 #include <string>
 #include <vector>
@@ -58,6 +59,8 @@ struct UltraScaleParameters : public HardwareParameters {
   xrt::xclbin xclbin_;
   /** Information regarding the clocks */
   UltraScaleClocks clocks_;
+  /** Buffer pool and memory accounting shared by the data movers */
+  std::shared_ptr<XRTBufferPool> pool_ = std::make_shared<XRTBufferPool>();
   /** Virtual destructor required for the inheritance */
   virtual ~UltraScaleParameters() = default;
 };
@@ -179,6 +182,21 @@ class UltraScale : public IHardware {
    * @returns Status of the operation
    */
   Status SetClocks(const std::vector<float> &clocks) override;
+  /**
+   * @brief Get the memory accounting of the memory banks
+   *
+   * @param stats one entry per memory bank used so far (output)
+   * @returns Status of the operation
+   */
+  Status GetMemoryStatistics(std::vector<MemoryBankStatistics> &stats) override;
+  /**
+   * @brief Set the maximum number of bytes allocated in a memory bank
+   *
+   * @param memory_bank memory bank
+   * @param bytes budget in bytes. 0 removes the budget.
+   * @returns Status of the operation
+   */
+  Status SetMemoryBudget(const int memory_bank, const size_t bytes) override;
 
  private:
   /** Parameters used for internal hardware configuration */
@@ -13,6 +13,7 @@
 #include <cynq/status.hpp>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace cynq {
 /**
@@ -89,6 +90,19 @@ class XRTAccelerator : public IAccelerator {
    */
   int GetMemoryBank(const uint pos) override;
 
+  /**
+   * @brief Get all the memory banks connected to an argument
+   *
+   * The banks are taken from the connectivity of the loaded xclbin. If the
+   * kernel is not found in it, it falls back to GetMemoryBank().
+   *
+   * @param pos AXI Memory Mapped argument position within the kernel (argument
+   * number)
+   *
+   * @return std::vector<int> memory banks sorted by ID
+   */
+  std::vector<int> GetMemoryBanks(const uint pos) override;
+
   /**
    * @brief GetStatus method
    * This returns the accelerator state by using the DeviceStatus. This reads
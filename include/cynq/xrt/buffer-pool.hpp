@@ -0,0 +1,200 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#pragma once
+#include <xrt/xrt_bo.h>
+#include <xrt/xrt_device.h>
+
+#include <cstddef>
+#include <cynq/datamover.hpp>
+#include <cynq/enums.hpp>
+#include <cynq/status.hpp>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <tuple>
+#include <vector>
+
+namespace cynq {
+/**
+ * @brief Caching allocator of XRT buffer objects
+ *
+ * The buffers are allocated in size classes (four classes per power of two,
+ * starting from a page), so a released buffer can serve any request of the
+ * same class, memory bank and memory type. When an XRTMemory is released,
+ * its buffer object is returned to the pool instead of being freed, as long
+ * as the cached bytes do not exceed the limit (high-water mark).
+ *
+ * It also accounts the bytes allocated per memory bank, enforces the
+ * memory budgets of the banks and places the host memory of the host-only
+ * and dual buffers (see HostMemoryOptions). It is shared by the data movers
+ * of the same hardware and the memories they create, and it is thread-safe.
+ */
+class XRTBufferPool {
+ public:
+  /** Default limit of cached bytes */
+  static constexpr size_t kDefaultLimit = 64 << 20;
+  /** Smallest size class */
+  static constexpr size_t kMinimumClass = 4096;
+  /** Maximum number of NUMA nodes supported by the host placement */
+  static constexpr int kMaxNumaNodes = 1024;
+
+  /**
+   * @brief Construct a new pool
+   *
+   * @param limit maximum number of bytes kept in the pool. 0 disables the
+   * caching.
+   */
+  explicit XRTBufferPool(const size_t limit = kDefaultLimit);
+
+  /**
+   * @brief Rounds a size up to its size class
+   *
+   * @param size size in bytes
+   * @return size_t size of the buffer object allocated for the request
+   */
+  static size_t SizeClass(const size_t size);
+
+  /**
+   * @brief Gets a buffer object from the pool or allocates a new one
+   *
+   * If a new allocation exceeds the budget of the bank, the cached buffers
+   * of the bank are freed first.
+   *
+   * @param device XRT device where the buffer is allocated
+   * @param size requested size in bytes
+   * @param bank memory bank (XRT memory group)
+   * @param type memory type
+   * @param bo buffer object of SizeClass(size) bytes (output)
+   * @return Status OUT_OF_MEMORY if the allocation exceeds the budget or
+   * XRT cannot allocate it
+   */
+  Status Acquire(const xrt::device &device, const size_t size,
+                 const int bank, const MemoryType type,
+                 std::shared_ptr<xrt::bo> &bo);
+
+  /**
+   * @brief Returns a buffer object obtained from Acquire()
+   *
+   * The buffer is freed if keeping it would exceed the limit. It is not
+   * recycled either if it is still referenced somewhere else: it is freed
+   * once the last reference is dropped.
+   *
+   * @param bo buffer object
+   * @param size requested size given to Acquire()
+   * @param bank memory bank given to Acquire()
+   * @param type memory type given to Acquire()
+   */
+  void Release(std::shared_ptr<xrt::bo> bo, const size_t size, const int bank,
+               const MemoryType type);
+
+  /**
+   * @brief Sets the maximum number of cached bytes
+   *
+   * The cached buffers are trimmed down to the new limit.
+   *
+   * @param limit limit in bytes. 0 disables the caching.
+   */
+  void SetLimit(const size_t limit);
+
+  /**
+   * @brief Frees cached buffers until the cached bytes are below a target
+   *
+   * The largest buffers are freed first.
+   *
+   * @param target number of bytes to keep
+   * @return size_t number of bytes freed
+   */
+  size_t Trim(const size_t target);
+
+  /**
+   * @brief Gets the counters of the pool
+   *
+   * @param stats counters (output)
+   */
+  void GetStatistics(BufferPoolStatistics &stats);
+
+  /**
+   * @brief Sets the maximum number of bytes allocated in a memory bank
+   *
+   * The cached buffers of the bank are trimmed down to the budget.
+   *
+   * @param bank memory bank
+   * @param budget budget in bytes. 0 removes the budget.
+   */
+  void SetBudget(const int bank, const size_t budget);
+
+  /**
+   * @brief Gets the memory accounting of the banks
+   *
+   * @param stats one entry per memory bank used so far (output)
+   */
+  void GetBankStatistics(std::vector<MemoryBankStatistics> &stats);
+
+  /**
+   * @brief Sets the placement of the host memory
+   *
+   * The cached host-only and dual buffers are freed.
+   *
+   * @param options placement of the host memory
+   */
+  void SetHostOptions(const HostMemoryOptions &options);
+
+  /**
+   * @brief Flags of the buffer object for a memory type
+   *
+   * @param type memory type
+   * @return xrt::bo::flags flags for the allocation
+   */
+  static xrt::bo::flags Flags(const MemoryType type);
+
+ private:
+  /** Key of the cached buffers: size class, memory bank and memory type */
+  typedef std::tuple<size_t, int, MemoryType> Key;
+
+  /** Frees buffers until the cached bytes are below the target. It must be
+      called with the mutex locked */
+  size_t TrimLocked(const size_t target);
+
+  /** Frees cached buffers of a bank until the bank is below the target. It
+      must be called with the mutex locked */
+  size_t ReclaimLocked(const int bank, const size_t target);
+
+  /** Gets the accounting of a bank. It must be called with the mutex
+      locked */
+  MemoryBankStatistics &Account(const int bank);
+
+  /** Frees the last cached buffer object of a list. It must be called with
+      the mutex locked */
+  void EvictLocked(const Key &key, std::vector<std::shared_ptr<xrt::bo>> &list);
+
+  /** Accounts a freed buffer object. It must be called with the mutex
+      locked */
+  void FreedLocked(const Key &key);
+
+  /** Allocates a user-pointer buffer object on pages mapped according to
+      the options. The pages are unmapped with the buffer object. The
+      fallback flag tells if the options could not be fully honoured */
+  static Status AllocateHost(const xrt::device &device, const size_t size,
+                             const int bank, const MemoryType type,
+                             const HostMemoryOptions &options,
+                             std::shared_ptr<xrt::bo> &bo, bool &fallback);
+
+  /** Mutex of the pool */
+  std::mutex mutex_;
+  /** Cached buffers. The largest classes are the last ones */
+  std::map<Key, std::vector<std::shared_ptr<xrt::bo>>> buffers_;
+  /** Limit of cached bytes */
+  size_t limit_;
+  /** Counters */
+  BufferPoolStatistics stats_;
+  /** Accounting of the memory banks */
+  std::map<int, MemoryBankStatistics> banks_;
+  /** Placement of the host memory */
+  HostMemoryOptions host_options_;
+};
+}  // namespace cynq
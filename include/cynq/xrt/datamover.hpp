@@ -11,8 +11,10 @@
 #include <cynq/enums.hpp>
 #include <cynq/hardware.hpp>
 #include <cynq/status.hpp>
+#include <cynq/xrt/buffer-pool.hpp>
 #include <cynq/xrt/memory.hpp>
 #include <memory>
+#include <vector>
 
 namespace cynq {
 /**
@@ -23,6 +25,10 @@ struct XRTDataMoverMeta {
   std::shared_ptr<xrt::bo> bo_;
   /** Memory type */
   MemoryType type_;
+  /** Memory bank of the buffer object */
+  int bank_ = 0;
+  /** Pool where the buffer object is returned. It can be null */
+  std::shared_ptr<XRTBufferPool> pool_;
 };
 
 /**
@@ -33,6 +39,11 @@ struct XRTDataMoverMeta {
  */
 class XRTDataMover : public IDataMover {
  public:
+  /** Maximum number of asynchronous transfers in flight per direction. It
+      is also the number of workers that run them when XRT cannot
+      synchronise the buffer objects asynchronously */
+  static constexpr size_t kMaxTransfersInFlight = 8;
+
   /**
    * @brief Construct a new XRTDataMover object
    *
@@ -85,12 +96,29 @@ class XRTDataMover : public IDataMover {
   std::shared_ptr<IMemory> GetBuffer(
       const size_t size, const int memory_bank = 0,
       const MemoryType type = MemoryType::Dual) override;
+  /**
+   * @brief AllocateBuffer method
+   * Allocates a memory buffer from the buffer pool, checking the memory
+   * budget of the bank.
+   *
+   * @param size Size in bytes of the buffer.
+   * @param mem Allocated memory (output).
+   * @param memory_bank Memory bank corresponding to the memory.
+   * @param type One of the values in the MemoryType enum class.
+   * @return Status
+   */
+  Status AllocateBuffer(const size_t size, std::shared_ptr<IMemory> &mem,
+                        const int memory_bank = 0,
+                        const MemoryType type = MemoryType::Dual) override;
   /**
    * @brief Upload method
    *
    * This method moves the data from the host to the device using a XRT engine.
-   * In the case of XRT-based allocators. It invokes the IMemory::Sync if
-   * execution type is ExecutionType::Sync
+   * In the case of XRT-based allocators. It synchronises the buffer object
+   * if execution type is ExecutionType::Sync. Otherwise, it starts the
+   * synchronisation and returns: it uses the asynchronous synchronisation of
+   * XRT if available or a worker thread otherwise. If there are
+   * kMaxTransfersInFlight uploads in flight, it waits for the oldest one.
    *
    * @param mem XRTMemory instance to upload.
    *
@@ -110,9 +138,9 @@ class XRTDataMover : public IDataMover {
    * @brief Download method
    *
    * This method moves the data from the device to the host using a XRT engine.
-   * In the case of XRT-based allocators. It invokes the IMemory::Sync if
-   * execution type is ExecutionType::Sync
-   *
+   * In the case of XRT-based allocators. It synchronises the buffer object
+   * if execution type is ExecutionType::Sync. Otherwise, it works as
+   * Upload() in the other direction.
    *
    * @param mem IMemory instance to download.
    *
@@ -132,9 +160,11 @@ class XRTDataMover : public IDataMover {
    * @brief Sync method
    *
    * Synchronizes data movements in case of asynchronous Upload/Download.
+   * It only waits for the transfers of the given direction issued before
+   * the call.
    *
    * @param type sync type. Depending on the transaction, it will trigger sync
-   * @return Status
+   * @return Status of the first transfer that failed since the last Sync()
    */
   Status Sync(const SyncType type) override;
   /**
@@ -143,7 +173,69 @@ class XRTDataMover : public IDataMover {
    *
    * @return DeviceStatus
    */
+  /**
+   * @brief ImportBuffer method
+   * Wraps an existing host allocation into a user-pointer buffer object.
+   *
+   * @param ptr Host allocation aligned to the page size.
+   * @param size Size in bytes of the allocation.
+   * @param mem Memory wrapping the allocation (output).
+   * @param memory_bank Memory bank corresponding to the memory.
+   * @return Status
+   */
+  Status ImportBuffer(void *ptr, const size_t size,
+                      std::shared_ptr<IMemory> &mem,
+                      const int memory_bank = 0) override;
   DeviceStatus GetStatus() override;
+  /**
+   * @brief GetBufferPoolStatistics method
+   * Gets the counters of the pool of buffer objects.
+   *
+   * @param stats counters of the pool (output)
+   * @return Status
+   */
+  Status GetBufferPoolStatistics(BufferPoolStatistics &stats) override;
+  /**
+   * @brief SetBufferPoolLimit method
+   * Sets the maximum number of bytes cached by the pool of buffer objects.
+   *
+   * @param bytes limit in bytes. 0 disables the pool.
+   * @return Status
+   */
+  Status SetBufferPoolLimit(const size_t bytes) override;
+  /**
+   * @brief TrimBufferPool method
+   * Frees the buffer objects cached by the pool.
+   *
+   * @param bytes number of cached bytes to keep
+   * @return Status
+   */
+  Status TrimBufferPool(const size_t bytes = 0) override;
+  /**
+   * @brief GetMemoryStatistics method
+   * Gets the memory accounting of the memory banks.
+   *
+   * @param stats one entry per memory bank used so far (output)
+   * @return Status
+   */
+  Status GetMemoryStatistics(std::vector<MemoryBankStatistics> &stats) override;
+  /**
+   * @brief SetMemoryBudget method
+   * Sets the maximum number of bytes allocated in a memory bank.
+   *
+   * @param memory_bank memory bank
+   * @param bytes budget in bytes. 0 removes the budget.
+   * @return Status
+   */
+  Status SetMemoryBudget(const int memory_bank, const size_t bytes) override;
+  /**
+   * @brief SetHostMemoryOptions method
+   * Sets the NUMA node and page size of the host and dual buffers.
+   *
+   * @param options placement of the host memory
+   * @return Status
+   */
+  Status SetHostMemoryOptions(const HostMemoryOptions &options) override;
 
  private:
   /** Data Mover Parameters */
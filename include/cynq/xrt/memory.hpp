@@ -14,6 +14,9 @@
 #include <cynq/status.hpp>
 #include <cynq/xrt/datamover.hpp>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
 
 namespace cynq {
 /**
@@ -22,7 +25,8 @@ namespace cynq {
  * on the Buffer object from the xilinx runtime.
  *
  */
-class XRTMemory : public IMemory {
+class XRTMemory : public IMemory,
+                  public std::enable_shared_from_this<XRTMemory> {
  public:
   /**
    * @brief Construct a new XRTDataMover object
@@ -59,6 +63,34 @@ class XRTMemory : public IMemory {
    * @return Status
    */
   Status Sync(const SyncType type) override;
+  /**
+   * @brief Sync method (ranged)
+   * Synchronizes a region of the memory.
+   *
+   * @param type The orientation of the Synchronizaton
+   * @param size Size in bytes of the region
+   * @param offset Offset in bytes of the region
+   * @return Status
+   */
+  Status Sync(const SyncType type, const size_t size,
+              const size_t offset) override;
+  /**
+   * @brief SetDirtyTracking method
+   * Enables the tracking of the regions written by the host.
+   *
+   * @param enable true to enable the tracking
+   * @return Status
+   */
+  Status SetDirtyTracking(const bool enable) override;
+  /**
+   * @brief MarkDirty method
+   * Marks a region as written by the host.
+   *
+   * @param offset Offset in bytes of the region
+   * @param size Size in bytes of the region
+   * @return Status
+   */
+  Status MarkDirty(const size_t offset, const size_t size) override;
   /**
    * @brief Size method
    * Gives the value for the memory size in bytes.
@@ -66,6 +98,18 @@ class XRTMemory : public IMemory {
    * @return size_t
    */
   size_t Size() override;
+  /**
+   * @brief Slice method
+   * Creates a view of a region of the memory. The view is backed by an XRT
+   * sub-buffer of the buffer object, or by offset pointers if the memory
+   * does not have a buffer object.
+   *
+   * @param offset Offset in bytes of the region within the memory
+   * @param size Size in bytes of the region
+   * @return std::shared_ptr<IMemory>
+   */
+  std::shared_ptr<IMemory> Slice(const size_t offset,
+                                 const size_t size) override;
 
   /** Define the friend relacionship between the mover and the memory */
   friend class DMADataMover;
@@ -88,15 +132,39 @@ class XRTMemory : public IMemory {
    * @return std::shared_ptr<uint8_t>
    */
   std::shared_ptr<uint8_t> GetDeviceAddress() override;
+  /**
+   * @brief GetHostPointer method
+   * Get the cached Address that belongs to the host.
+   *
+   * @return uint8_t*
+   */
+  uint8_t* GetHostPointer() override;
+  /**
+   * @brief GetDevicePointer method
+   * Get the cached Address that belongs to the device.
+   *
+   * @return uint8_t*
+   */
+  uint8_t* GetDevicePointer() override;
 
  private:
   /** Memory region size */
   std::size_t size_;
-  /** Host memory pointer */
+  /** Host memory pointer. It caches the mapping of the buffer object */
   uint8_t* host_ptr_;
-  /** Device memory pointer */
+  /** Device memory pointer. It caches the address of the buffer object */
   uint8_t* dev_ptr_;
   /** Mover metadata pointer */
   void* mover_ptr_;
+  /** Flag to indicate that the dirty regions are tracked */
+  bool dirty_tracking_ = false;
+  /** Dirty regions as sorted and disjoint [begin, end) intervals */
+  std::vector<std::pair<std::size_t, std::size_t>> dirty_;
+  /** Mutex of the dirty regions */
+  std::mutex dirty_mutex_;
+  /** Memory that owns the allocation of a view. It is null otherwise */
+  std::shared_ptr<XRTMemory> parent_;
+  /** Offset of a view within the allocation of its parent */
+  std::size_t offset_ = 0;
 };
 }  // namespace cynq
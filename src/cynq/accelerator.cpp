@@ -8,9 +8,11 @@
  */
 #include <cynq/accelerator.hpp>
 #include <cynq/execution-graph.hpp>
+#include <cynq/execution-trace.hpp>
 #include <cynq/mmio/accelerator.hpp>
 #include <cynq/xrt/accelerator.hpp>
 #include <memory>
+#include <vector>
 
 namespace cynq {
 std::shared_ptr<IAccelerator> IAccelerator::Create(IAccelerator::Type impl,
@@ -40,8 +42,9 @@ std::shared_ptr<IAccelerator> IAccelerator::Create(
    platform but still require some implementable components
 */
 
-Status IAccelerator::Start(std::shared_ptr<IExecutionGraph> graph,
-                           const StartMode mode) {
+Status IAccelerator::Start(
+    std::shared_ptr<IExecutionGraph> graph, const StartMode mode,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
   Status st{};
 
   /* Check the stream */
@@ -55,11 +58,26 @@ Status IAccelerator::Start(std::shared_ptr<IExecutionGraph> graph,
   };
 
   /* Add function */
-  st.retval = graph->Add(func);
+  ExecutionTrace::Label label{"Start"};
+  st.retval = graph->Add(func, dependencies);
   return st;
 }
 
-Status IAccelerator::Stop(std::shared_ptr<IExecutionGraph> graph) {
+ExecutionFuture IAccelerator::StartAsync(
+    std::shared_ptr<IExecutionGraph> graph, const StartMode mode,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  /* Functor to execute  */
+  IExecutionGraph::Function func = [&, mode]() -> Status {
+    return this->Start(mode);
+  };
+
+  ExecutionTrace::Label label{"Start"};
+  return ExecutionFuture::Submit(graph, func, dependencies);
+}
+
+Status IAccelerator::Stop(
+    std::shared_ptr<IExecutionGraph> graph,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
   Status st{};
 
   /* Check the stream */
@@ -71,11 +89,14 @@ Status IAccelerator::Stop(std::shared_ptr<IExecutionGraph> graph) {
   IExecutionGraph::Function func = [&]() -> Status { return this->Stop(); };
 
   /* Add function */
-  st.retval = graph->Add(func);
+  ExecutionTrace::Label label{"Stop"};
+  st.retval = graph->Add(func, dependencies);
   return st;
 }
 
-Status IAccelerator::Sync(std::shared_ptr<IExecutionGraph> graph) {
+Status IAccelerator::Sync(
+    std::shared_ptr<IExecutionGraph> graph,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
   Status st{};
 
   /* Check the stream */
@@ -87,13 +108,25 @@ Status IAccelerator::Sync(std::shared_ptr<IExecutionGraph> graph) {
   IExecutionGraph::Function func = [&]() -> Status { return this->Sync(); };
 
   /* Add function */
-  st.retval = graph->Add(func);
+  ExecutionTrace::Label label{"Sync"};
+  st.retval = graph->Add(func, dependencies);
   return st;
 }
 
-Status IAccelerator::WriteRegister(std::shared_ptr<IExecutionGraph> graph,
-                                   const uint64_t address, const uint8_t *data,
-                                   const size_t size) {
+ExecutionFuture IAccelerator::SyncAsync(
+    std::shared_ptr<IExecutionGraph> graph,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  /* Functor to execute  */
+  IExecutionGraph::Function func = [&]() -> Status { return this->Sync(); };
+
+  ExecutionTrace::Label label{"Sync"};
+  return ExecutionFuture::Submit(graph, func, dependencies);
+}
+
+Status IAccelerator::WriteRegister(
+    std::shared_ptr<IExecutionGraph> graph, const uint64_t address,
+    const uint8_t *data, const size_t size,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
   Status st{};
 
   /* Check the stream */
@@ -107,13 +140,15 @@ Status IAccelerator::WriteRegister(std::shared_ptr<IExecutionGraph> graph,
   };
 
   /* Add function */
-  st.retval = graph->Add(func);
+  ExecutionTrace::Label label{"WriteRegister"};
+  st.retval = graph->Add(func, dependencies);
   return st;
 }
 
-Status IAccelerator::ReadRegister(std::shared_ptr<IExecutionGraph> graph,
-                                  const uint64_t address, uint8_t *data,
-                                  const size_t size) {
+Status IAccelerator::ReadRegister(
+    std::shared_ptr<IExecutionGraph> graph, const uint64_t address,
+    uint8_t *data, const size_t size,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
   Status st{};
 
   /* Check the stream */
@@ -127,8 +162,34 @@ Status IAccelerator::ReadRegister(std::shared_ptr<IExecutionGraph> graph,
   };
 
   /* Add function */
-  st.retval = graph->Add(func);
+  ExecutionTrace::Label label{"ReadRegister"};
+  st.retval = graph->Add(func, dependencies);
+  return st;
+}
+
+Status IAccelerator::Attach(
+    std::shared_ptr<IExecutionGraph> graph, const uint64_t addr,
+    std::shared_ptr<IMemory> mem,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  Status st{};
+
+  /* Check the stream */
+  if (!graph) {
+    return this->Attach(addr, mem);
+  }
+
+  /* Functor to execute  */
+  IExecutionGraph::Function func = [&, addr, mem]() -> Status {
+    return this->Attach(addr, mem);
+  };
+
+  /* Add function */
+  ExecutionTrace::Label label{"Attach"};
+  st.retval = graph->Add(func, dependencies);
   return st;
 }
 
+std::vector<int> IAccelerator::GetMemoryBanks(const uint pos) {
+  return std::vector<int>{this->GetMemoryBank(pos)};
+}
 }  // namespace cynq
@@ -21,6 +21,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace cynq {
 Alveo::Alveo(const std::string & /*bitstream_file*/,
@@ -83,6 +84,29 @@ std::shared_ptr<IAccelerator> Alveo::GetAccelerator(
   return IAccelerator::Create(IAccelerator::XRT, kernelname, parameters_);
 }
 
+Status Alveo::GetMemoryStatistics(
+    std::vector<MemoryBankStatistics> &stats) {
+  AlveoParameters *params =
+      dynamic_cast<AlveoParameters *>(this->parameters_.get());
+  if (!params) {
+    return Status{Status::INCOMPATIBLE_PARAMETER,
+                  "Hardware params incompatible"};
+  }
+  params->pool_->GetBankStatistics(stats);
+  return Status{};
+}
+
+Status Alveo::SetMemoryBudget(const int memory_bank, const size_t bytes) {
+  AlveoParameters *params =
+      dynamic_cast<AlveoParameters *>(this->parameters_.get());
+  if (!params) {
+    return Status{Status::INCOMPATIBLE_PARAMETER,
+                  "Hardware params incompatible"};
+  }
+  params->pool_->SetBudget(memory_bank, bytes);
+  return Status{};
+}
+
 Alveo::~Alveo() {}
 
 }  // namespace cynq
@@ -0,0 +1,176 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <condition_variable>  // NOLINT
+#include <cynq/buffer-ring.hpp>
+#include <cynq/execution-trace.hpp>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
+namespace cynq {
+BufferRing::BufferRing(
+    std::shared_ptr<IExecutionGraph> graph,
+    const std::vector<std::vector<std::shared_ptr<IMemory>>> &buffers)
+    : graph_{graph}, slots_(buffers.size()), stages_(buffers.size()) {
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    slots_[i].index = i;
+    slots_[i].buffers = buffers[i];
+  }
+}
+
+BufferRing::~BufferRing() {
+  /* The graph nodes refer to the ring */
+  std::unique_lock<std::mutex> lk(mutex_);
+  condition_.wait(lk, [&] {
+    for (const auto &slot : slots_) {
+      if (slot.state == BufferRingSlot::State::InFlight) {
+        return false;
+      }
+    }
+    return true;
+  });
+}
+
+std::shared_ptr<BufferRing> BufferRing::Create(
+    std::shared_ptr<IDataMover> mover, std::shared_ptr<IExecutionGraph> graph,
+    const size_t slots, const std::vector<size_t> &sizes,
+    const int memory_bank, const MemoryType type) {
+  if (!mover || 0 == slots || sizes.empty()) {
+    return nullptr;
+  }
+
+  std::vector<std::vector<std::shared_ptr<IMemory>>> buffers(slots);
+  for (auto &slot : buffers) {
+    for (const size_t size : sizes) {
+      slot.push_back(mover->GetBuffer(size, memory_bank, type));
+    }
+  }
+  return std::make_shared<BufferRing>(graph, buffers);
+}
+
+size_t BufferRing::Slots() const { return slots_.size(); }
+
+BufferRingSlot *BufferRing::AcquireWrite(const bool wait) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  if (slots_.empty()) {
+    return nullptr;
+  }
+
+  BufferRingSlot &slot = slots_[write_pos_];
+  auto free = [&] { return slot.state == BufferRingSlot::State::Free; };
+  if (wait) {
+    condition_.wait(lk, free);
+  } else if (!free()) {
+    return nullptr;
+  }
+
+  slot.state = BufferRingSlot::State::Filling;
+  slot.result = Status{};
+  write_pos_ = (write_pos_ + 1) % slots_.size();
+  return &slot;
+}
+
+Status BufferRing::Submit(
+    BufferRingSlot *slot, const Stage &stage,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  std::vector<IExecutionGraph::NodeID> deps{dependencies};
+  const size_t index = slot ? slot->index : 0;
+  {
+    std::scoped_lock<std::mutex> lk(mutex_);
+    if (!slot || index >= slots_.size() || &slots_[index] != slot ||
+        slot->state != BufferRingSlot::State::Filling) {
+      return Status{Status::INVALID_PARAMETER,
+                    "The slot is not owned by the producer"};
+    }
+
+    /* The stages are chained in submission order */
+    if (last_node_ >= 0) {
+      deps.push_back(last_node_);
+    }
+    slot->state = BufferRingSlot::State::InFlight;
+    slot->sequence = sequence_++;
+    stages_[index] = stage;
+    pending_++;
+  }
+
+  /* Without graph, the stage is synchronous */
+  if (!graph_) {
+    this->Complete(index, stages_[index](slots_[index]));
+    Status st = slots_[index].result;
+    st.retval = -1;
+    return st;
+  }
+
+  /* Functor to execute  */
+  IExecutionGraph::Function func = [this, index]() -> Status {
+    Status ret = stages_[index](slots_[index]);
+    this->Complete(index, ret);
+    return ret;
+  };
+
+  /* Add function */
+  ExecutionTrace::Label label{"BufferRingStage"};
+  const IExecutionGraph::NodeID id = graph_->Add(func, deps);
+  if (-1 == id) {
+    this->Complete(index, Status{Status::EXECUTION_FAILED,
+                                 "The stage could not be added to the graph"});
+    return slots_[index].result;
+  }
+
+  std::scoped_lock<std::mutex> lk(mutex_);
+  last_node_ = id;
+  Status st{};
+  st.retval = id;
+  return st;
+}
+
+void BufferRing::Complete(const size_t index, const Status &result) {
+  /* The notification is done with the lock held since the ring can be
+     destroyed as soon as the slot is not in flight */
+  std::scoped_lock<std::mutex> lk(mutex_);
+  slots_[index].result = result;
+  slots_[index].state = BufferRingSlot::State::Ready;
+  condition_.notify_all();
+}
+
+BufferRingSlot *BufferRing::AcquireRead(const bool wait) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  if (0 == pending_) {
+    return nullptr;
+  }
+
+  /* The slots are read in submission order */
+  BufferRingSlot &slot = slots_[read_pos_];
+  auto ready = [&] { return slot.state == BufferRingSlot::State::Ready; };
+  if (wait) {
+    condition_.wait(lk, ready);
+  } else if (!ready()) {
+    return nullptr;
+  }
+
+  slot.state = BufferRingSlot::State::Reading;
+  read_pos_ = (read_pos_ + 1) % slots_.size();
+  pending_--;
+  return &slot;
+}
+
+Status BufferRing::Release(BufferRingSlot *slot) {
+  {
+    std::scoped_lock<std::mutex> lk(mutex_);
+    if (!slot || slot->index >= slots_.size() ||
+        &slots_[slot->index] != slot ||
+        slot->state != BufferRingSlot::State::Reading) {
+      return Status{Status::INVALID_PARAMETER,
+                    "The slot is not owned by the consumer"};
+    }
+    slot->state = BufferRingSlot::State::Free;
+  }
+  condition_.notify_all();
+  return Status{};
+}
+}  // namespace cynq
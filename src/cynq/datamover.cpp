@@ -6,10 +6,14 @@
  *         Diego Arturo Avila Torres <diego.avila@uned.cr>
  *
  */
+#include <unistd.h>
+
 #include <cynq/datamover.hpp>
 #include <cynq/dma/datamover.hpp>
+#include <cynq/execution-trace.hpp>
 #include <cynq/xrt/datamover.hpp>
 #include <memory>
+#include <vector>
 
 namespace cynq {
 std::shared_ptr<IDataMover> IDataMover::Create(
@@ -31,9 +35,10 @@ std::shared_ptr<IDataMover> IDataMover::Create(
    platform but still require some implementable components
 */
 
-Status IDataMover::Upload(std::shared_ptr<IExecutionGraph> graph,
-                          const std::shared_ptr<IMemory> mem, const size_t size,
-                          const size_t offset, const ExecutionType exetype) {
+Status IDataMover::Upload(
+    std::shared_ptr<IExecutionGraph> graph, const std::shared_ptr<IMemory> mem,
+    const size_t size, const size_t offset, const ExecutionType exetype,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
   Status st{};
 
   /* Check the stream */
@@ -42,19 +47,20 @@ Status IDataMover::Upload(std::shared_ptr<IExecutionGraph> graph,
   }
 
   /* Functor to execute  */
-  IExecutionGraph::Function func = [&, mem, size, offset]() -> Status {
+  IExecutionGraph::Function func = [&, mem, size, offset, exetype]() -> Status {
     return this->Upload(mem, size, offset, exetype);
   };
 
   /* Add function */
-  st.retval = graph->Add(func);
+  ExecutionTrace::Label label{"Upload"};
+  st.retval = graph->Add(func, dependencies);
   return st;
 }
 
-Status IDataMover::Download(std::shared_ptr<IExecutionGraph> graph,
-                            const std::shared_ptr<IMemory> mem,
-                            const size_t size, const size_t offset,
-                            const ExecutionType exetype) {
+Status IDataMover::Download(
+    std::shared_ptr<IExecutionGraph> graph, const std::shared_ptr<IMemory> mem,
+    const size_t size, const size_t offset, const ExecutionType exetype,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
   Status st{};
 
   /* Check the stream */
@@ -68,12 +74,40 @@ Status IDataMover::Download(std::shared_ptr<IExecutionGraph> graph,
   };
 
   /* Add function */
-  st.retval = graph->Add(func);
+  ExecutionTrace::Label label{"Download"};
+  st.retval = graph->Add(func, dependencies);
   return st;
 }
 
-Status IDataMover::Sync(std::shared_ptr<IExecutionGraph> graph,
-                        const SyncType type) {
+ExecutionFuture IDataMover::UploadAsync(
+    std::shared_ptr<IExecutionGraph> graph, const std::shared_ptr<IMemory> mem,
+    const size_t size, const size_t offset, const ExecutionType exetype,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  /* Functor to execute  */
+  IExecutionGraph::Function func = [&, mem, size, offset, exetype]() -> Status {
+    return this->Upload(mem, size, offset, exetype);
+  };
+
+  ExecutionTrace::Label label{"Upload"};
+  return ExecutionFuture::Submit(graph, func, dependencies);
+}
+
+ExecutionFuture IDataMover::DownloadAsync(
+    std::shared_ptr<IExecutionGraph> graph, const std::shared_ptr<IMemory> mem,
+    const size_t size, const size_t offset, const ExecutionType exetype,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  /* Functor to execute  */
+  IExecutionGraph::Function func = [&, mem, size, offset, exetype]() -> Status {
+    return this->Download(mem, size, offset, exetype);
+  };
+
+  ExecutionTrace::Label label{"Download"};
+  return ExecutionFuture::Submit(graph, func, dependencies);
+}
+
+Status IDataMover::Sync(
+    std::shared_ptr<IExecutionGraph> graph, const SyncType type,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
   Status st{};
 
   /* Check the stream */
@@ -87,7 +121,92 @@ Status IDataMover::Sync(std::shared_ptr<IExecutionGraph> graph,
   };
 
   /* Add function */
-  st.retval = graph->Add(func);
+  ExecutionTrace::Label label{"DataMoverSync"};
+  st.retval = graph->Add(func, dependencies);
   return st;
 }
+
+Status IDataMover::AllocateBuffer(const size_t /*size*/,
+                                  std::shared_ptr<IMemory> &mem,
+                                  const int /*memory_bank*/,
+                                  const MemoryType /*type*/) {
+  mem = nullptr;
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover does not report allocation failures"};
+}
+
+Status IDataMover::ImportBuffer(void * /*ptr*/, const size_t /*size*/,
+                                std::shared_ptr<IMemory> &mem,
+                                const int /*memory_bank*/) {
+  mem = nullptr;
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover cannot import host allocations"};
+}
+
+size_t IDataMover::ImportAlignment() {
+  static const size_t alignment = sysconf(_SC_PAGESIZE);
+  return alignment;
+}
+
+Status IDataMover::GetBufferPoolStatistics(BufferPoolStatistics & /*stats*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover does not have a buffer pool"};
+}
+
+Status IDataMover::SetBufferPoolLimit(const size_t /*bytes*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover does not have a buffer pool"};
+}
+
+Status IDataMover::TrimBufferPool(const size_t /*bytes*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover does not have a buffer pool"};
+}
+
+Status IDataMover::GetMemoryStatistics(
+    std::vector<MemoryBankStatistics> & /*stats*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover does not account the memory"};
+}
+
+Status IDataMover::SetMemoryBudget(const int /*memory_bank*/,
+                                   const size_t /*bytes*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover does not account the memory"};
+}
+
+Status IDataMover::SetHostMemoryOptions(
+    const HostMemoryOptions & /*options*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover cannot place the host memory"};
+}
+
+Status IDataMover::SetCompletionOptions(
+    const CompletionOptions & /*options*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover has no completion modes"};
+}
+
+Status IDataMover::SetScatterGather(
+    const ScatterGatherOptions & /*options*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover has no scatter-gather mode"};
+}
+
+Status IDataMover::SetTransferChunking(
+    const TransferChunkOptions & /*options*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover does not split the transfers"};
+}
+
+Status IDataMover::Submit(const std::vector<TransferSegment> & /*segments*/,
+                          const SyncType /*type*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover has no scatter-gather mode"};
+}
+
+Status IDataMover::Reap(const SyncType /*type*/, size_t & /*completed*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The data mover has no scatter-gather mode"};
+}
 }  // namespace cynq
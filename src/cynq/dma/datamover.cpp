@@ -7,16 +7,28 @@
  *
  */
 
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
 #include <xrt/xrt_bo.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <chrono>  // NOLINT
 #include <cynq/datamover.hpp>
 #include <cynq/dma/datamover.hpp>
+#include <cynq/dma/descriptor-ring.hpp>
 #include <cynq/enums.hpp>
 #include <cynq/hardware.hpp>
 #include <cynq/memory.hpp>
 #include <cynq/status.hpp>
 #include <cynq/ultrascale/hardware.hpp>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
 
 extern "C" {
 #include <pynq_api.h> /* FIXME: to be removed in future releases */
@@ -32,10 +44,353 @@ struct DMADataMoverParameters : public DataMoverParameters {
   PYNQ_AXI_DMA dma_;
   /** DMA address */
   uint64_t addr_;
+  /** Pool of buffer objects shared with the memories */
+  std::shared_ptr<XRTBufferPool> pool_;
+  /** Completion of the transfers */
+  CompletionOptions completion_;
+  /** UIO descriptors of the channels, indexed by AXI_DMA_DIRECTION. -1 if
+      the channel polls */
+  int uio_fds_[2] = {-1, -1};
+  /** Scatter-gather mode */
+  ScatterGatherOptions sg_;
+  /** Descriptor memory of both channels */
+  std::shared_ptr<xrt::bo> sg_bo_;
+  /** Descriptor rings, indexed by AXI_DMA_DIRECTION. Null in simple mode */
+  std::unique_ptr<DMADescriptorRing> rings_[2];
+  /** Regions completed and not reported by Reap() yet */
+  size_t completed_[2] = {0, 0};
+  /** Splitting of the transfers in simple mode */
+  TransferChunkOptions chunking_;
+  /** Calibrated chunk sizes, indexed by MemoryType. 0 if not calibrated */
+  size_t calibrated_[4] = {0, 0, 0, 0};
+  /** Protects the calibration, since the channels can be used by different
+      threads (see TransferChannel) */
+  std::mutex chunk_mutex_;
   /** Virtual destructor required for the inheritance */
   virtual ~DMADataMoverParameters() = default;
 };
 
+/* Registers within the channel registers (PG021) */
+static constexpr unsigned int kDMAControlOffset = 0x00;
+static constexpr unsigned int kDMAStatusOffset = 0x04;
+static constexpr unsigned int kDMACurrentDescriptorOffset = 0x08;
+static constexpr unsigned int kDMATailDescriptorOffset = 0x10;
+/* Run/stop and interrupt on complete enable bits of DMACR */
+static constexpr uint32_t kDMAControlRun = 0x1;
+static constexpr uint32_t kDMAControlIOC = 0x1000;
+/* Interrupt threshold of DMACR: one interrupt per descriptor */
+static constexpr uint32_t kDMAControlThreshold = 0x10000;
+/* Halted and scatter-gather included bits of DMASR */
+static constexpr uint32_t kDMAStatusHalted = 0x1;
+static constexpr uint32_t kDMAStatusSG = 0x8;
+/* Interrupt on complete bit of DMASR. It is cleared by writing one */
+static constexpr uint32_t kDMAStatusIOC = 0x1000;
+/* Reads of DMASR before giving up on halting a channel */
+static constexpr int kDMAHaltRetries = 100000;
+
+/* Smallest chunk size of the calibration */
+static constexpr size_t kMinChunkSize = 64 << 10;
+/* Largest chunk size of the calibration */
+static constexpr size_t kMaxChunkSize = 16 << 20;
+/* Throughput of the cache maintenance of the selected chunk size with
+   respect to the best one */
+static constexpr double kChunkEfficiency = 0.9;
+/* Repetitions of the calibration of each chunk size */
+static constexpr int kCalibrationRuns = 3;
+
+/**
+ * @brief Calibrates the chunk size of a memory type
+ *
+ * The cache maintenance of a buffer is timed with chunks from kMinChunkSize
+ * to kMaxChunkSize. The smaller chunks overlap better with the transfers,
+ * but each synchronisation has a fixed cost. The selected chunk is the
+ * smallest one within kChunkEfficiency of the best throughput. If the
+ * memory needs no maintenance, the throughput grows with the chunk size and
+ * the largest chunk is selected.
+ *
+ * @param params parameters of the data mover
+ * @param device XRT device
+ * @param type memory type
+ * @param max_length longest transfer of the engine
+ * @return size_t chunk size in bytes
+ */
+static size_t CalibrateDMAChunkSize(DMADataMoverParameters *params,
+                                    const xrt::device &device,
+                                    const MemoryType type,
+                                    const size_t max_length) {
+  size_t largest = kMinChunkSize;
+  while ((largest << 1) <= std::min(max_length, kMaxChunkSize)) {
+    largest <<= 1;
+  }
+  /* The device-only buffers have no cache maintenance */
+  if (largest > max_length || MemoryType::Device == type) {
+    return max_length;
+  }
+
+  std::shared_ptr<xrt::bo> bo;
+  if (params->pool_->Acquire(device, largest, 0, type, bo).code !=
+      Status::OK) {
+    return largest;
+  }
+  uint8_t *host = bo->map<uint8_t *>();
+
+  size_t selected = largest;
+  std::vector<std::pair<size_t, double>> throughputs;
+  double best = 0;
+  for (size_t chunk = kMinChunkSize; chunk <= largest; chunk <<= 1) {
+    double fastest = 0;
+    for (int run = 0; run < kCalibrationRuns; ++run) {
+      /* Dirty the cache lines, so they have to be written back */
+      std::fill(host, host + largest, static_cast<uint8_t>(run));
+      auto start = std::chrono::steady_clock::now();
+      for (size_t offset = 0; offset < largest; offset += chunk) {
+        bo->sync(XCL_BO_SYNC_BO_TO_DEVICE, chunk, offset);
+      }
+      std::chrono::duration<double> elapsed =
+          std::chrono::steady_clock::now() - start;
+      if (0 == run || elapsed.count() < fastest) {
+        fastest = elapsed.count();
+      }
+    }
+    const double throughput = largest / std::max(fastest, 1e-9);
+    throughputs.emplace_back(chunk, throughput);
+    best = std::max(best, throughput);
+  }
+
+  for (const auto &entry : throughputs) {
+    if (entry.second >= kChunkEfficiency * best) {
+      selected = entry.first;
+      break;
+    }
+  }
+
+  params->pool_->Release(std::move(bo), largest, 0, type);
+  return selected;
+}
+
+/* Offset of the registers of a channel */
+static unsigned int DMAChannelOffset(const PYNQ_AXI_DMA &dma,
+                                     const AXI_DMA_DIRECTION direction) {
+  return AXI_DMA_WRITE == direction ? dma.write_channel_offset
+                                    : dma.read_channel_offset;
+}
+
+static uint32_t ReadDMARegister(PYNQ_AXI_DMA &dma,
+                                const unsigned int offset) {
+  uint32_t value = 0;
+  PYNQ_readMMIO(&dma.mmio_window, &value, offset, sizeof(value));
+  return value;
+}
+
+static int WriteDMARegister(PYNQ_AXI_DMA &dma, const unsigned int offset,
+                            uint32_t value) {
+  return PYNQ_writeMMIO(&dma.mmio_window, &value, offset, sizeof(value));
+}
+
+/* The descriptor registers take effect when the LSB is written */
+static int WriteDMAAddress(PYNQ_AXI_DMA &dma, const unsigned int offset,
+                           const uint64_t address) {
+  if (PYNQ_SUCCESS != WriteDMARegister(dma, offset + 4, address >> 32)) {
+    return PYNQ_ERROR;
+  }
+  return WriteDMARegister(dma, offset, address & 0xFFFFFFFF);
+}
+
+/**
+ * @brief Restarts a channel in the mode of the data mover
+ *
+ * The channel is halted first, since the current descriptor can only be
+ * set while halted. In scatter-gather mode, the ring is rewound and the
+ * engine fetches from its head once the tail is written.
+ *
+ * @param params parameters of the data mover
+ * @param direction channel to restart
+ * @return Status
+ */
+static Status StartDMAChannel(DMADataMoverParameters *params,
+                              const AXI_DMA_DIRECTION direction) {
+  PYNQ_AXI_DMA &dma = params->dma_;
+  const unsigned int channel = DMAChannelOffset(dma, direction);
+  DMADescriptorRing *ring = params->rings_[direction].get();
+
+  if (ring &&
+      !(ReadDMARegister(dma, channel + kDMAStatusOffset) & kDMAStatusSG)) {
+    return Status{Status::INCOMPATIBLE_PARAMETER,
+                  "The DMA engine does not include scatter-gather"};
+  }
+
+  WriteDMARegister(dma, channel + kDMAControlOffset, 0);
+  int retries = kDMAHaltRetries;
+  while (!(ReadDMARegister(dma, channel + kDMAStatusOffset) &
+           kDMAStatusHalted)) {
+    if (0 == --retries) {
+      return Status{Status::REGISTER_IO_ERROR,
+                    "The DMA channel does not halt"};
+    }
+  }
+
+  uint32_t control = kDMAControlRun;
+  if (dma.interrupt_mode) {
+    control |= kDMAControlIOC;
+  }
+  if (ring) {
+    ring->Reset();
+    WriteDMAAddress(dma, channel + kDMACurrentDescriptorOffset, ring->Head());
+    control |= kDMAControlThreshold;
+  }
+  if (PYNQ_SUCCESS !=
+      WriteDMARegister(dma, channel + kDMAControlOffset, control)) {
+    return Status{Status::REGISTER_IO_ERROR, "Cannot start the DMA channel"};
+  }
+
+  /* The channel is not idle until its first transfer completes */
+  dma.first_transfer[direction] = 1;
+  return Status{};
+}
+
+/**
+ * @brief Drops the descriptor rings and returns their memory to the pool
+ *
+ * @param params parameters of the data mover. The scatter-gather options
+ * must be the ones used to acquire the memory.
+ */
+static void ReleaseDMADescriptors(DMADataMoverParameters *params) {
+  for (auto &ring : params->rings_) {
+    ring.reset();
+  }
+  if (params->sg_bo_) {
+    const size_t bytes =
+        params->sg_.descriptors * DMADescriptorRing::kDescriptorSize;
+    params->pool_->Release(std::move(params->sg_bo_), 2 * bytes, 0,
+                           MemoryType::Dual);
+  }
+}
+
+/**
+ * @brief Hands the pushed descriptors to the engine
+ *
+ * @param params parameters of the data mover
+ * @param direction channel of the descriptors
+ * @return Status
+ */
+static Status RingDMADoorbell(DMADataMoverParameters *params,
+                              const AXI_DMA_DIRECTION direction) {
+  DMADescriptorRing *ring = params->rings_[direction].get();
+  const size_t bytes = ring->Capacity() * DMADescriptorRing::kDescriptorSize;
+  params->sg_bo_->sync(XCL_BO_SYNC_BO_TO_DEVICE, bytes, direction * bytes);
+
+  const unsigned int channel = DMAChannelOffset(params->dma_, direction);
+  if (PYNQ_SUCCESS != WriteDMAAddress(params->dma_,
+                                      channel + kDMATailDescriptorOffset,
+                                      ring->Tail())) {
+    return Status{Status::REGISTER_IO_ERROR, "Cannot issue the transfer"};
+  }
+  return Status{};
+}
+
+/**
+ * @brief Opens the UIO device of a channel
+ *
+ * The descriptor is kept open across the transfers: the UIO driver counts
+ * the interrupts per descriptor, so an interrupt raised before the wait is
+ * not lost (PYNQ_waitForUIO() opens the device on each wait instead).
+ *
+ * @param irq IRQ as given to PYNQ_openUIO(). Used if the device is empty
+ * @param device path of the UIO device
+ * @param fd descriptor (output). -1 if the channel has no interrupt
+ * @return Status
+ */
+static Status OpenCompletionUIO(const int irq, const std::string &device,
+                                int &fd) {
+  fd = -1;
+  std::string path = device;
+  if (path.empty() && irq >= 0) {
+    PYNQ_UIO uio;
+    uio.filename = nullptr;
+    if (PYNQ_SUCCESS != PYNQ_openUIO(&uio, irq) || !uio.filename) {
+      return Status{Status::CONFIGURATION_ERROR,
+                    "Cannot find the UIO device of the IRQ " +
+                        std::to_string(irq)};
+    }
+    path = uio.filename;
+    PYNQ_closeUIO(&uio);
+  }
+  if (path.empty()) {
+    return Status{};
+  }
+
+  fd = open(path.c_str(), O_RDWR | O_CLOEXEC);
+  if (fd < 0) {
+    return Status{Status::CONFIGURATION_ERROR,
+                  "Cannot open the UIO device " + path};
+  }
+  return Status{};
+}
+
+/**
+ * @brief Waits for a channel with its completion interrupt
+ *
+ * In the hybrid mode, the status register is polled during the spinning
+ * time first. Then, the interrupt is unmasked and the thread blocks on the
+ * UIO descriptor. The status register is checked after each wake-up since
+ * the count of the descriptor may come from a previous transfer.
+ *
+ * @param params parameters of the data mover
+ * @param direction channel to wait for
+ * @return int PYNQ_SUCCESS or PYNQ_ERROR
+ */
+static int WaitForDMAInterrupt(DMADataMoverParameters *params,
+                               const AXI_DMA_DIRECTION direction) {
+  const int fd = params->uio_fds_[direction];
+  const CompletionOptions &options = params->completion_;
+  const int timeout = 0 == options.timeout.count()
+                          ? -1
+                          : static_cast<int>(options.timeout.count());
+
+  /* The transfers shorter than the interrupt round trip finish spinning */
+  int busy = 1;
+  auto end = std::chrono::steady_clock::now();
+  if (CompletionMode::Hybrid == options.mode) {
+    end += options.spin;
+  }
+  do {
+    if (PYNQ_SUCCESS != PYNQ_testForDMAComplete(&params->dma_, direction,
+                                                &busy)) {
+      return PYNQ_ERROR;
+    }
+  } while (busy && std::chrono::steady_clock::now() < end);
+
+  while (busy) {
+    /* The driver masks the interrupt after raising it */
+    uint32_t unmask = 1;
+    if (write(fd, &unmask, sizeof(unmask)) != sizeof(unmask)) {
+      return PYNQ_ERROR;
+    }
+
+    struct pollfd request = {fd, POLLIN, 0};
+    const int ready = poll(&request, 1, timeout);
+    if (ready < 0 && EINTR != errno) {
+      return PYNQ_ERROR;
+    }
+    if (ready > 0) {
+      uint32_t count = 0;
+      if (read(fd, &count, sizeof(count)) != sizeof(count)) {
+        return PYNQ_ERROR;
+      }
+    }
+
+    if (PYNQ_SUCCESS != PYNQ_testForDMAComplete(&params->dma_, direction,
+                                                &busy)) {
+      return PYNQ_ERROR;
+    }
+  }
+
+  /* Acknowledge the interrupt, so the line is low for the next transfer */
+  const unsigned int offset = DMAChannelOffset(params->dma_, direction);
+  return WriteDMARegister(params->dma_, offset + kDMAStatusOffset,
+                          kDMAStatusIOC);
+}
+
 DMADataMover::DMADataMover(const uint64_t addr,
                            std::shared_ptr<HardwareParameters> hwparams)
     : data_mover_params_{std::make_unique<DMADataMoverParameters>()} {
@@ -46,60 +401,512 @@ DMADataMover::DMADataMover(const uint64_t addr,
   params->addr_ = addr;
   params->hw_params_ = hwparams;
 
+  /* The pool is shared by the data movers of the hardware, so the memory
+     accounting covers all of them */
+  auto hw_params = dynamic_cast<UltraScaleParameters *>(hwparams.get());
+  params->pool_ = hw_params ? hw_params->pool_
+                            : std::make_shared<XRTBufferPool>();
+
   /* Create the DMA accessor */
   if (static_cast<uint64_t>(0ul) != addr) {
     PYNQ_openDMA(&params->dma_, addr);
   }
 }
 
-std::shared_ptr<IMemory> DMADataMover::GetBuffer(const size_t size, const int,
+std::shared_ptr<IMemory> DMADataMover::GetBuffer(const size_t size,
+                                                 const int memory_bank,
                                                  const MemoryType type) {
-  const xrt::memory_group group = (xrt::memory_group)(0);
+  std::shared_ptr<IMemory> mem;
+  Status st = this->AllocateBuffer(size, mem, memory_bank, type);
+  if (st.code != Status::OK) {
+    throw std::runtime_error(st.msg);
+  }
+  return mem;
+}
+
+Status DMADataMover::AllocateBuffer(const size_t size,
+                                    std::shared_ptr<IMemory> &mem, const int,
+                                    const MemoryType type) {
+  mem = nullptr;
 
   /* The assumption is that at this point, it is ok */
   auto hw_params_ = dynamic_cast<UltraScaleParameters *>(
       data_mover_params_->hw_params_.get());
   if (!hw_params_) {
-    throw std::runtime_error("Hardware params are incompatible");
+    return Status{Status::INCOMPATIBLE_PARAMETER,
+                  "Hardware params are incompatible"};
   }
 
-  xrt::bo::flags flags;
-  switch (type) {
-    case MemoryType::Cacheable:
-      flags = xrt::bo::flags::cacheable;
-      break;
-    case MemoryType::Device:
-      flags = xrt::bo::flags::device_only;
-      break;
-    case MemoryType::Host:
-      flags = xrt::bo::flags::host_only;
-      break;
-    default:
-      flags = xrt::bo::flags::normal;
-      break;
-  }
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
 
-  /* Create the buffer object and encapsulate it into the meta. The meta is FULL
-   * TRANSFER */
-  auto buffer_object =
-      std::make_shared<xrt::bo>(hw_params_->device_, size, flags, group);
+  /* Get the buffer object from the pool and encapsulate it into the meta.
+   * The meta is FULL TRANSFER. The buffer returns to the pool once the memory
+   * is released */
+  std::shared_ptr<xrt::bo> buffer_object;
+  Status st =
+      params->pool_->Acquire(hw_params_->device_, size, 0, type, buffer_object);
+  if (st.code != Status::OK) {
+    return st;
+  }
   DMADataMoverMeta *meta = new DMADataMoverMeta;
   meta->bo_ = buffer_object;
   meta->type_ = type;
+  meta->bank_ = 0;
+  meta->pool_ = params->pool_;
 
-  return IMemory::Create(IMemory::XRT, size, nullptr, nullptr,
-                         reinterpret_cast<void *>(meta));
+  mem = IMemory::Create(IMemory::XRT, size, nullptr, nullptr,
+                        reinterpret_cast<void *>(meta));
+  return Status{};
+}
+
+Status DMADataMover::ImportBuffer(void *ptr, const size_t size,
+                                std::shared_ptr<IMemory> &mem,
+                                const int /*memory_bank*/) {
+  mem = nullptr;
+
+  if (!ptr || 0 == size) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The allocation is null or has zero size"};
+  }
+  if (reinterpret_cast<uintptr_t>(ptr) % ImportAlignment() != 0) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The allocation is not aligned to the page size"};
+  }
+
+  /* The pages of a user-pointer buffer object are not physically
+     contiguous and XRT only exposes the address of the first one, whereas
+     the DMA engine walks the physical addresses from it (and the
+     descriptors would need the address of each page) */
+  return Status{Status::NOT_IMPLEMENTED,
+                "The DMA engine cannot address host allocations: their "
+                "pages are not physically contiguous"};
 }
 
 DeviceStatus DMADataMover::GetStatus() { return DeviceStatus::Idle; }
 
+Status DMADataMover::GetBufferPoolStatistics(BufferPoolStatistics &stats) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  params->pool_->GetStatistics(stats);
+  return Status{};
+}
+
+Status DMADataMover::SetBufferPoolLimit(const size_t bytes) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  params->pool_->SetLimit(bytes);
+  return Status{};
+}
+
+Status DMADataMover::TrimBufferPool(const size_t bytes) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  params->pool_->Trim(bytes);
+  return Status{};
+}
+
+Status DMADataMover::GetMemoryStatistics(
+    std::vector<MemoryBankStatistics> &stats) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  params->pool_->GetBankStatistics(stats);
+  return Status{};
+}
+
+Status DMADataMover::SetMemoryBudget(const int memory_bank,
+                                     const size_t bytes) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  params->pool_->SetBudget(memory_bank, bytes);
+  return Status{};
+}
+
+Status DMADataMover::SetCompletionOptions(const CompletionOptions &options) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+
+  /* Open the new devices before releasing the current ones */
+  int fds[2] = {-1, -1};
+  if (CompletionMode::Polling != options.mode) {
+    Status st = OpenCompletionUIO(options.write_irq, options.write_uio,
+                                  fds[AXI_DMA_WRITE]);
+    if (Status::OK == st.code) {
+      st = OpenCompletionUIO(options.read_irq, options.read_uio,
+                             fds[AXI_DMA_READ]);
+    }
+    if (Status::OK == st.code && fds[AXI_DMA_WRITE] < 0 &&
+        fds[AXI_DMA_READ] < 0) {
+      st = Status{Status::INVALID_PARAMETER,
+                  "The completion mode requires the interrupt of a channel"};
+    }
+    if (st.code != Status::OK) {
+      for (const int fd : fds) {
+        if (fd >= 0) {
+          close(fd);
+        }
+      }
+      return st;
+    }
+  }
+
+  for (int &fd : params->uio_fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    fd = -1;
+  }
+  params->completion_ = options;
+  params->uio_fds_[AXI_DMA_WRITE] = fds[AXI_DMA_WRITE];
+  params->uio_fds_[AXI_DMA_READ] = fds[AXI_DMA_READ];
+
+  /* The engine raises the IOC interrupts only if they are enabled. It
+     restarts the channels */
+  if (static_cast<uint64_t>(0ul) != params->addr_) {
+    const int interrupts = CompletionMode::Polling != options.mode;
+    const bool restart = interrupts != params->dma_.interrupt_mode;
+    if (PYNQ_SUCCESS !=
+        PYNQ_setDMATransferInterruptMode(&params->dma_, interrupts)) {
+      return Status{Status::REGISTER_IO_ERROR,
+                    "Cannot set the interrupts of the DMA engine"};
+    }
+    /* The channels are not idle until their first transfer completes */
+    if (restart) {
+      params->dma_.first_transfer[AXI_DMA_WRITE] = 1;
+      params->dma_.first_transfer[AXI_DMA_READ] = 1;
+    }
+  }
+
+  /* The restart above leaves the channels in simple mode */
+  if (params->rings_[AXI_DMA_WRITE]) {
+    for (const AXI_DMA_DIRECTION direction : {AXI_DMA_WRITE, AXI_DMA_READ}) {
+      Status st = StartDMAChannel(params, direction);
+      if (st.code != Status::OK) {
+        return st;
+      }
+    }
+  }
+  return Status{};
+}
+
+Status DMADataMover::SetScatterGather(const ScatterGatherOptions &options) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  if (static_cast<uint64_t>(0ul) == params->addr_) {
+    return Status{Status::NOT_IMPLEMENTED, "The data mover has no DMA engine"};
+  }
+  if (options.length_width < 8 ||
+      options.length_width > DMADescriptorRing::kMaxLengthWidth) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The buffer length width must be between 8 and 26 bits"};
+  }
+
+  auto hw_params_ = dynamic_cast<UltraScaleParameters *>(
+      data_mover_params_->hw_params_.get());
+  if (!hw_params_) {
+    return Status{Status::INCOMPATIBLE_PARAMETER,
+                  "Hardware params are incompatible"};
+  }
+
+  ReleaseDMADescriptors(params);
+  params->completed_[AXI_DMA_WRITE] = 0;
+  params->completed_[AXI_DMA_READ] = 0;
+  params->sg_ = options;
+
+  /* Both rings share a buffer object: the write ring goes first */
+  Status st{};
+  if (options.descriptors > 0) {
+    const size_t bytes =
+        options.descriptors * DMADescriptorRing::kDescriptorSize;
+    st = params->pool_->Acquire(hw_params_->device_, 2 * bytes, 0,
+                                MemoryType::Dual, params->sg_bo_);
+    if (Status::OK == st.code) {
+      uint8_t *host = params->sg_bo_->map<uint8_t *>();
+      const uint64_t device = params->sg_bo_->address();
+      for (const AXI_DMA_DIRECTION direction :
+           {AXI_DMA_WRITE, AXI_DMA_READ}) {
+        params->rings_[direction] = std::make_unique<DMADescriptorRing>(
+            host + direction * bytes, device + direction * bytes,
+            options.descriptors);
+      }
+    }
+  }
+
+  for (const AXI_DMA_DIRECTION direction : {AXI_DMA_WRITE, AXI_DMA_READ}) {
+    if (Status::OK == st.code) {
+      st = StartDMAChannel(params, direction);
+    }
+  }
+
+  /* Go back to the simple mode if the rings cannot be used */
+  if (st.code != Status::OK && options.descriptors > 0) {
+    ReleaseDMADescriptors(params);
+    params->sg_ = ScatterGatherOptions{};
+    StartDMAChannel(params, AXI_DMA_WRITE);
+    StartDMAChannel(params, AXI_DMA_READ);
+  }
+  return st;
+}
+
+Status DMADataMover::SetTransferChunking(
+    const TransferChunkOptions &options) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  if (options.length_width < 8 ||
+      options.length_width > DMADescriptorRing::kMaxLengthWidth) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The length width must be between 8 and 26 bits"};
+  }
+  if (options.chunk_size != 0 &&
+      options.chunk_size != TransferChunkOptions::kAutomatic &&
+      options.chunk_size < 4096) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The chunk size must be at least 4 KiB"};
+  }
+
+  std::scoped_lock<std::mutex> lk(params->chunk_mutex_);
+  params->chunking_ = options;
+  std::fill(std::begin(params->calibrated_), std::end(params->calibrated_),
+            0);
+  return Status{};
+}
+
+size_t DMADataMover::ChunkSize(const MemoryType type) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+
+  /* The options can be changed from other threads */
+  std::scoped_lock<std::mutex> lk(params->chunk_mutex_);
+  const TransferChunkOptions options = params->chunking_;
+
+  /* Longest transfer, keeping the split points aligned */
+  const size_t max_length =
+      ((1ul << options.length_width) - 1) & ~static_cast<size_t>(63);
+  size_t chunk = options.chunk_size;
+  if (0 == chunk) {
+    return max_length;
+  }
+
+  if (TransferChunkOptions::kAutomatic == chunk) {
+    size_t &calibrated = params->calibrated_[static_cast<int>(type)];
+    auto hw_params_ = dynamic_cast<UltraScaleParameters *>(
+        data_mover_params_->hw_params_.get());
+    if (0 == calibrated && hw_params_) {
+      calibrated = CalibrateDMAChunkSize(params, hw_params_->device_, type,
+                                         max_length);
+    }
+    chunk = 0 == calibrated ? max_length : calibrated;
+  }
+
+  /* The chunks are page-aligned if possible */
+  chunk = std::min(chunk, max_length);
+  return chunk >= 4096 ? chunk & ~static_cast<size_t>(4095) : chunk;
+}
+
+Status DMADataMover::TransferChunks(const std::shared_ptr<IMemory> mem,
+                                    const size_t size, const size_t offset,
+                                    const SyncType type, const size_t chunk) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  auto xrtmem = dynamic_cast<XRTMemory *>(mem.get());
+  auto meta = (DMADataMoverMeta *)(xrtmem->mover_ptr_);  // NOLINT
+  const AXI_DMA_DIRECTION direction =
+      SyncType::HostToDevice == type ? AXI_DMA_WRITE : AXI_DMA_READ;
+
+  uint8_t *ptr = mem->DeviceSpan<uint8_t>().Data();
+  if (!ptr) {
+    return Status{Status::INVALID_PARAMETER, "Device pointer is null"};
+  }
+  PYNQ_SHARED_MEMORY pmem;
+  pmem.physical_address = (uint64_t)(ptr);  // NOLINT
+  pmem.pointer = nullptr;
+
+  const size_t chunks = (size + chunk - 1) / chunk;
+  auto length = [&](const size_t i) {
+    return std::min(chunk, size - i * chunk);
+  };
+  auto maintain = [&](const size_t i) {
+    if (meta) {
+      meta->bo_->sync(SyncType::HostToDevice == type
+                          ? XCL_BO_SYNC_BO_TO_DEVICE
+                          : XCL_BO_SYNC_BO_FROM_DEVICE,
+                      length(i), offset + i * chunk);
+    }
+  };
+  auto issue = [&](const size_t i) -> Status {
+    if (PYNQ_SUCCESS != PYNQ_issueDMATransfer(&params->dma_, &pmem,
+                                              offset + i * chunk, length(i),
+                                              direction)) {
+      return Status{Status::REGISTER_IO_ERROR, "Cannot issue the transfer"};
+    }
+    return Status{};
+  };
+
+  Status st{};
+  if (SyncType::HostToDevice == type) {
+    /* The chunk N + 1 is written back while the chunk N is moved */
+    maintain(0);
+    for (size_t i = 0; i < chunks && Status::OK == st.code; ++i) {
+      st = issue(i);
+      if (Status::OK == st.code) {
+        if (i + 1 < chunks) {
+          maintain(i + 1);
+        }
+        st = this->Sync(type);
+      }
+    }
+  } else {
+    /* The chunk N is invalidated while the chunk N + 1 is moved */
+    st = issue(0);
+    for (size_t i = 0; i < chunks && Status::OK == st.code; ++i) {
+      st = this->Sync(type);
+      if (Status::OK == st.code) {
+        if (i + 1 < chunks) {
+          st = issue(i + 1);
+        }
+        maintain(i);
+      }
+    }
+  }
+  return st;
+}
+
+Status DMADataMover::Submit(const std::vector<TransferSegment> &segments,
+                            const SyncType type) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  const AXI_DMA_DIRECTION direction =
+      SyncType::HostToDevice == type ? AXI_DMA_WRITE : AXI_DMA_READ;
+  DMADescriptorRing *ring = params->rings_[direction].get();
+
+  if (!ring) {
+    return Status{Status::NOT_IMPLEMENTED,
+                  "The scatter-gather mode is not enabled"};
+  }
+  if (segments.empty()) {
+    return Status{Status::INVALID_PARAMETER, "There are no segments"};
+  }
+
+  /* Validate all the segments before queueing any of them */
+  for (const auto &segment : segments) {
+    if (!segment.mem || 0 == segment.size ||
+        (segment.size + segment.offset) > segment.mem->Size()) {
+      return Status{Status::INVALID_PARAMETER,
+                    "The segment exceeds the memory size"};
+    }
+    if (!segment.mem->DeviceSpan<uint8_t>().Data()) {
+      return Status{Status::INVALID_PARAMETER, "Device pointer is null"};
+    }
+  }
+
+  /* Longest descriptor, keeping the split points aligned */
+  const size_t max_length =
+      ((1ul << params->sg_.length_width) - 1) & ~static_cast<size_t>(63);
+
+  size_t queued = 0;
+  for (size_t i = 0; i < segments.size(); ++i) {
+    const TransferSegment &segment = segments[i];
+    auto xrtmem = dynamic_cast<XRTMemory *>(segment.mem.get());
+    auto meta = xrtmem ? (DMADataMoverMeta *)(xrtmem->mover_ptr_)  // NOLINT
+                       : nullptr;
+    if (meta && AXI_DMA_WRITE == direction) {
+      meta->bo_->sync(XCL_BO_SYNC_BO_TO_DEVICE, segment.size, segment.offset);
+    }
+
+    const uint64_t address = reinterpret_cast<uint64_t>(
+        segment.mem->DeviceSpan<uint8_t>().Data() + segment.offset);
+    for (size_t done = 0; done < segment.size;) {
+      /* Full ring: hand the queued descriptors and wait for the oldest */
+      while (0 == ring->Available()) {
+        if (queued > 0) {
+          Status st = RingDMADoorbell(params, direction);
+          if (st.code != Status::OK) {
+            return st;
+          }
+          queued = 0;
+        }
+        Status st = this->ReapDescriptors(type);
+        if (st.code != Status::OK) {
+          return st;
+        }
+        if (0 == ring->Available()) {
+          std::this_thread::yield();
+        }
+      }
+
+      const size_t length = std::min(max_length, segment.size - done);
+      const bool last = (done + length) == segment.size;
+      const bool sof = 0 == i && 0 == done;
+      const bool eof = (segments.size() - 1) == i && last;
+      Status st = ring->Push(address + done, length, sof, eof,
+                             last ? segment : TransferSegment{});
+      if (st.code != Status::OK) {
+        return st;
+      }
+      queued++;
+      done += length;
+    }
+  }
+
+  return RingDMADoorbell(params, direction);
+}
+
+Status DMADataMover::ReapDescriptors(const SyncType type) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  const AXI_DMA_DIRECTION direction =
+      SyncType::HostToDevice == type ? AXI_DMA_WRITE : AXI_DMA_READ;
+  DMADescriptorRing *ring = params->rings_[direction].get();
+  const size_t bytes = ring->Capacity() * DMADescriptorRing::kDescriptorSize;
+  params->sg_bo_->sync(XCL_BO_SYNC_BO_FROM_DEVICE, bytes, direction * bytes);
+
+  /* The regions moved from the device are synchronised for the host */
+  std::vector<TransferSegment> segments;
+  Status st = ring->Reap(segments);
+  for (const auto &segment : segments) {
+    auto xrtmem = dynamic_cast<XRTMemory *>(segment.mem.get());
+    auto meta = xrtmem ? (DMADataMoverMeta *)(xrtmem->mover_ptr_)  // NOLINT
+                       : nullptr;
+    if (meta && AXI_DMA_READ == direction) {
+      meta->bo_->sync(XCL_BO_SYNC_BO_FROM_DEVICE, segment.size,
+                      segment.offset);
+    }
+  }
+  params->completed_[direction] += segments.size();
+  return st;
+}
+
+Status DMADataMover::Reap(const SyncType type, size_t &completed) {
+  auto params =
+      dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  const AXI_DMA_DIRECTION direction =
+      SyncType::HostToDevice == type ? AXI_DMA_WRITE : AXI_DMA_READ;
+  completed = 0;
+
+  if (!params->rings_[direction]) {
+    return Status{Status::NOT_IMPLEMENTED,
+                  "The scatter-gather mode is not enabled"};
+  }
+
+  Status st = this->ReapDescriptors(type);
+  completed = params->completed_[direction];
+  params->completed_[direction] = 0;
+  return st;
+}
+
 DMADataMover::~DMADataMover() {
   /* The assumption is that at this point, it is ok */
   auto params =
       dynamic_cast<DMADataMoverParameters *>(data_mover_params_.get());
+  for (const int fd : params->uio_fds_) {
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
   if (static_cast<uint64_t>(0ul) != params->addr_) {
     PYNQ_closeDMA(&params->dma_);
   }
+  ReleaseDMADescriptors(params);
 }
 
 /* TODO: All implementations below can be implemented cleverly. However, it
@@ -123,9 +930,35 @@ Status DMADataMover::Upload(const std::shared_ptr<IMemory> mem,
                   "The offset and size exceeds the memory size"};
   }
 
+  /* In scatter-gather mode, the transfer goes through the ring */
+  if (params->rings_[AXI_DMA_WRITE]) {
+    Status st = this->Submit({TransferSegment{mem, size, offset}},
+                             SyncType::HostToDevice);
+    if (st.code != Status::OK || ExecutionType::Async == exetype) {
+      return st;
+    }
+    return this->Sync(SyncType::HostToDevice);
+  }
+
   /* Get the actual memory and the meta */
   auto xrtmem = dynamic_cast<XRTMemory *>(mem.get());
   auto meta = (DMADataMoverMeta *)(xrtmem->mover_ptr_);  // NOLINT
+
+  /* The transfers longer than a chunk are split */
+  if (static_cast<uint64_t>(0ul) != params->addr_) {
+    const size_t chunk =
+        this->ChunkSize(meta ? meta->type_ : MemoryType::Dual);
+    if (size > chunk) {
+      if (ExecutionType::Async == exetype) {
+        return Status{Status::INCOMPATIBLE_PARAMETER,
+                      "The transfer is split into chunks, so it cannot be "
+                      "asynchronous"};
+      }
+      return this->TransferChunks(mem, size, offset, SyncType::HostToDevice,
+                                  chunk);
+    }
+  }
+
   if (meta) {
     meta->bo_->sync(XCL_BO_SYNC_BO_TO_DEVICE, size, offset);
   }
@@ -133,13 +966,13 @@ Status DMADataMover::Upload(const std::shared_ptr<IMemory> mem,
   /* Issue transaction */
   if (static_cast<uint64_t>(0ul) != params->addr_) {
     /* Get device pointer */
-    std::shared_ptr<uint8_t> ptr = mem->DeviceAddress<uint8_t>();
+    uint8_t *ptr = mem->DeviceSpan<uint8_t>().Data();
     if (!ptr) {
       return Status{Status::INVALID_PARAMETER, "Device pointer is null"};
     }
 
     PYNQ_SHARED_MEMORY pmem;
-    pmem.physical_address = (uint64_t)(ptr.get());  // NOLINT
+    pmem.physical_address = (uint64_t)(ptr);  // NOLINT
     pmem.pointer = nullptr;
 
     ret = PYNQ_issueDMATransfer(&params->dma_, &pmem, offset, size,
@@ -176,16 +1009,42 @@ Status DMADataMover::Download(const std::shared_ptr<IMemory> mem,
                   "The offset and size exceeds the memory size"};
   }
 
+  /* In scatter-gather mode, the transfer goes through the ring */
+  if (params->rings_[AXI_DMA_READ]) {
+    Status st = this->Submit({TransferSegment{mem, size, offset}},
+                             SyncType::DeviceToHost);
+    if (st.code != Status::OK || ExecutionType::Async == exetype) {
+      return st;
+    }
+    return this->Sync(SyncType::DeviceToHost);
+  }
+
   /* Get the actual memory and the meta */
   auto xrtmem = dynamic_cast<XRTMemory *>(mem.get());
   auto meta = (DMADataMoverMeta *)(xrtmem->mover_ptr_);  // NOLINT
+
+  /* The transfers longer than a chunk are split */
+  if (static_cast<uint64_t>(0ul) != params->addr_) {
+    const size_t chunk =
+        this->ChunkSize(meta ? meta->type_ : MemoryType::Dual);
+    if (size > chunk) {
+      if (ExecutionType::Async == exetype) {
+        return Status{Status::INCOMPATIBLE_PARAMETER,
+                      "The transfer is split into chunks, so it cannot be "
+                      "asynchronous"};
+      }
+      return this->TransferChunks(mem, size, offset, SyncType::DeviceToHost,
+                                  chunk);
+    }
+  }
+
   if (meta) {
     meta->bo_->sync(XCL_BO_SYNC_BO_FROM_DEVICE, size, offset);
   }
 
   /* Issue transaction */
   if (static_cast<uint64_t>(0ul) != params->addr_) {
-    std::shared_ptr<uint8_t> ptr = mem->DeviceAddress<uint8_t>();
+    uint8_t *ptr = mem->DeviceSpan<uint8_t>().Data();
 
     /* Get device pointer */
     if (!ptr) {
@@ -193,7 +1052,7 @@ Status DMADataMover::Download(const std::shared_ptr<IMemory> mem,
     }
 
     PYNQ_SHARED_MEMORY pmem;
-    pmem.physical_address = (uint64_t)(ptr.get());  // NOLINT
+    pmem.physical_address = (uint64_t)(ptr);  // NOLINT
     pmem.pointer = nullptr;
     ret =
         PYNQ_issueDMATransfer(&params->dma_, &pmem, offset, size, AXI_DMA_READ);
@@ -221,17 +1080,42 @@ Status DMADataMover::Sync(const SyncType type) {
   }
 
   int ret = PYNQ_SUCCESS;
+  const AXI_DMA_DIRECTION direction =
+      SyncType::HostToDevice == type ? AXI_DMA_WRITE : AXI_DMA_READ;
 
-  if (SyncType::HostToDevice == type) {
-    ret = PYNQ_waitForDMAComplete(&params->dma_, AXI_DMA_WRITE);
+  /* In scatter-gather mode, the channel is only idle after reaching the
+     tail, so there must be pending descriptors */
+  DMADescriptorRing *ring = params->rings_[direction].get();
+  if (ring && 0 == ring->Pending()) {
+    return Status{};
+  }
+
+  /* In simple mode, a restarted channel is not idle until its first
+     transfer, so there is nothing to wait for */
+  if (!ring && params->dma_.first_transfer[direction]) {
+    return Status{};
+  }
+
+  /* The channels without interrupt poll */
+  if (CompletionMode::Polling == params->completion_.mode ||
+      params->uio_fds_[direction] < 0) {
+    ret = PYNQ_waitForDMAComplete(&params->dma_, direction);
   } else {
-    ret = PYNQ_waitForDMAComplete(&params->dma_, AXI_DMA_READ);
+    ret = WaitForDMAInterrupt(params, direction);
   }
 
   if (PYNQ_SUCCESS != ret) {
     return Status{Status::REGISTER_IO_ERROR, "Cannot synchronise"};
   }
 
+  if (ring) {
+    Status st = this->ReapDescriptors(type);
+    if (Status::OK == st.code && ring->Pending() != 0) {
+      st = Status{Status::REGISTER_IO_ERROR,
+                  "The DMA channel is idle with pending descriptors"};
+    }
+    return st;
+  }
   return Status{};
 }
 }  // namespace cynq
@@ -0,0 +1,119 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <cynq/dma/descriptor-ring.hpp>
+#include <vector>
+
+namespace cynq {
+/* Words of a descriptor (PG021: scatter-gather descriptor) */
+static constexpr size_t kNextDescriptor = 0;
+static constexpr size_t kNextDescriptorMsb = 1;
+static constexpr size_t kBufferAddress = 2;
+static constexpr size_t kBufferAddressMsb = 3;
+static constexpr size_t kControl = 6;
+static constexpr size_t kStatus = 7;
+
+/* Fields of the control and status words */
+static constexpr uint32_t kControlSof = 1u << 27;
+static constexpr uint32_t kControlEof = 1u << 26;
+static constexpr uint32_t kStatusComplete = 1u << 31;
+static constexpr uint32_t kStatusErrors = 0x7u << 28;
+
+DMADescriptorRing::DMADescriptorRing(uint8_t *host, const uint64_t device,
+                                     const size_t descriptors)
+    : host_{host}, device_{device}, segments_(descriptors) {
+  for (size_t i = 0; i < descriptors; ++i) {
+    volatile uint32_t *desc = this->Descriptor(i);
+    for (size_t word = 0; word < kDescriptorSize / sizeof(uint32_t); ++word) {
+      desc[word] = 0;
+    }
+    const uint64_t next = this->Address((i + 1) % descriptors);
+    desc[kNextDescriptor] = static_cast<uint32_t>(next & 0xFFFFFFFF);
+    desc[kNextDescriptorMsb] = static_cast<uint32_t>(next >> 32);
+  }
+}
+
+void DMADescriptorRing::Reset() {
+  for (auto &segment : segments_) {
+    segment = TransferSegment{};
+  }
+  head_ = 0;
+  pending_ = 0;
+}
+
+size_t DMADescriptorRing::Capacity() const { return segments_.size(); }
+
+size_t DMADescriptorRing::Pending() const { return pending_; }
+
+size_t DMADescriptorRing::Available() const {
+  return segments_.size() - pending_;
+}
+
+uint64_t DMADescriptorRing::Head() const { return this->Address(head_); }
+
+uint64_t DMADescriptorRing::Tail() const {
+  const size_t size = segments_.size();
+  return this->Address((head_ + pending_ + size - 1) % size);
+}
+
+Status DMADescriptorRing::Push(const uint64_t address, const size_t length,
+                               const bool sof, const bool eof,
+                               const TransferSegment &segment) {
+  if (0 == this->Available()) {
+    return Status{Status::INVALID_PARAMETER, "The descriptor ring is full"};
+  }
+  if (0 == length || length >= (1ul << kMaxLengthWidth)) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The length does not fit in a descriptor"};
+  }
+
+  const size_t index = (head_ + pending_) % segments_.size();
+  volatile uint32_t *desc = this->Descriptor(index);
+  desc[kBufferAddress] = static_cast<uint32_t>(address & 0xFFFFFFFF);
+  desc[kBufferAddressMsb] = static_cast<uint32_t>(address >> 32);
+  desc[kControl] = static_cast<uint32_t>(length) | (sof ? kControlSof : 0) |
+                   (eof ? kControlEof : 0);
+  /* The engine sets the completion in the status */
+  desc[kStatus] = 0;
+
+  segments_[index] = segment;
+  pending_++;
+  return Status{};
+}
+
+Status DMADescriptorRing::Reap(std::vector<TransferSegment> &segments) {
+  Status st{};
+  while (pending_ > 0) {
+    volatile uint32_t *desc = this->Descriptor(head_);
+    const uint32_t status = desc[kStatus];
+    if (!(status & kStatusComplete)) {
+      break;
+    }
+    if (status & kStatusErrors) {
+      st = Status{Status::REGISTER_IO_ERROR,
+                  "The DMA engine reported an error in a descriptor"};
+    }
+
+    if (segments_[head_].mem) {
+      segments.push_back(segments_[head_]);
+      segments_[head_] = TransferSegment{};
+    }
+    head_ = (head_ + 1) % segments_.size();
+    pending_--;
+  }
+  return st;
+}
+
+volatile uint32_t *DMADescriptorRing::Descriptor(const size_t index) const {
+  return reinterpret_cast<volatile uint32_t *>(host_ +
+                                               index * kDescriptorSize);
+}
+
+uint64_t DMADescriptorRing::Address(const size_t index) const {
+  return device_ + index * kDescriptorSize;
+}
+}  // namespace cynq
@@ -0,0 +1,152 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cynq/execution-event.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+namespace cynq {
+std::shared_ptr<ExecutionEvent> ExecutionEvent::Create() {
+  return std::make_shared<ExecutionEvent>();
+}
+
+Status ExecutionEvent::Query() {
+  std::scoped_lock<std::mutex> lk(mutex_);
+  if (completed_ < recorded_) {
+    return Status{Status::RESOURCE_BUSY, "The event is pending"};
+  }
+  if (this->Discarded(recorded_)) {
+    return Status{Status::EXECUTION_FAILED, "The record was discarded"};
+  }
+  return Status{};
+}
+
+Status ExecutionEvent::Synchronize() { return this->Wait(this->Generation()); }
+
+Status ExecutionEvent::ElapsedTime(const std::shared_ptr<ExecutionEvent> start,
+                                   const std::shared_ptr<ExecutionEvent> end,
+                                   float &ms) {
+  std::chrono::steady_clock::time_point timestamps[2];
+  const std::shared_ptr<ExecutionEvent> events[2] = {start, end};
+
+  for (int i = 0; i < 2; ++i) {
+    if (!events[i]) {
+      return Status{Status::INVALID_PARAMETER, "The event is null"};
+    }
+    std::scoped_lock<std::mutex> lk(events[i]->mutex_);
+    if (0 == events[i]->recorded_) {
+      return Status{Status::INVALID_PARAMETER, "The event was not recorded"};
+    }
+    if (events[i]->completed_ < events[i]->recorded_) {
+      return Status{Status::RESOURCE_BUSY, "The event is pending"};
+    }
+    if (events[i]->Discarded(events[i]->recorded_)) {
+      return Status{Status::EXECUTION_FAILED, "The record was discarded"};
+    }
+    timestamps[i] = events[i]->timestamp_;
+  }
+
+  std::chrono::duration<float, std::milli> elapsed =
+      timestamps[1] - timestamps[0];
+  ms = elapsed.count();
+  return Status{};
+}
+
+uint64_t ExecutionEvent::Arm() {
+  std::scoped_lock<std::mutex> lk(mutex_);
+  return ++recorded_;
+}
+
+void ExecutionEvent::Signal(const uint64_t generation) {
+  auto now = std::chrono::steady_clock::now();
+  std::vector<std::function<void()>> callbacks;
+  {
+    std::scoped_lock<std::mutex> lk(mutex_);
+    if (generation <= completed_) {
+      return;
+    }
+    completed_ = generation;
+    timestamp_ = now;
+    callbacks = this->TakeCallbacks();
+  }
+  condition_.notify_all();
+  for (auto &callback : callbacks) {
+    callback();
+  }
+}
+
+void ExecutionEvent::Abort(const uint64_t generation) {
+  std::vector<std::function<void()>> callbacks;
+  {
+    std::scoped_lock<std::mutex> lk(mutex_);
+    if (generation <= completed_) {
+      return;
+    }
+    /* The pending records up to this one are discarded */
+    aborted_.emplace_back(completed_ + 1, generation);
+    completed_ = generation;
+    callbacks = this->TakeCallbacks();
+  }
+  condition_.notify_all();
+  for (auto &callback : callbacks) {
+    callback();
+  }
+}
+
+bool ExecutionEvent::OnCompletion(const uint64_t generation,
+                                  const std::function<void()> &callback) {
+  std::scoped_lock<std::mutex> lk(mutex_);
+  if (completed_ >= generation) {
+    return false;
+  }
+  callbacks_.emplace_back(generation, callback);
+  return true;
+}
+
+std::vector<std::function<void()>> ExecutionEvent::TakeCallbacks() {
+  std::vector<std::function<void()>> ready;
+  auto it = callbacks_.begin();
+  while (it != callbacks_.end()) {
+    if (it->first <= completed_) {
+      ready.push_back(std::move(it->second));
+      it = callbacks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return ready;
+}
+
+bool ExecutionEvent::Discarded(const uint64_t generation) const {
+  /* First range whose last generation is not below the given one */
+  auto it = std::lower_bound(
+      aborted_.begin(), aborted_.end(), generation,
+      [](const std::pair<uint64_t, uint64_t> &range, const uint64_t gen) {
+        return range.second < gen;
+      });
+  return it != aborted_.end() && it->first <= generation;
+}
+
+uint64_t ExecutionEvent::Generation() {
+  std::scoped_lock<std::mutex> lk(mutex_);
+  return recorded_;
+}
+
+Status ExecutionEvent::Wait(const uint64_t generation) {
+  std::unique_lock<std::mutex> lk(mutex_);
+  condition_.wait(lk, [&] { return completed_ >= generation; });
+  if (this->Discarded(generation)) {
+    return Status{Status::EXECUTION_FAILED, "The record was discarded"};
+  }
+  return Status{};
+}
+}  // namespace cynq
@@ -0,0 +1,163 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <condition_variable>  // NOLINT
+#include <cynq/execution-future.hpp>
+#include <functional>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
+
+namespace cynq {
+
+/**
+ * @brief State shared by the futures and the node that runs the operation
+ */
+struct ExecutionFutureState {
+  /** Operation. It is released once executed */
+  IExecutionGraph::Function function;
+  /** ID of the node that runs the operation */
+  IExecutionGraph::NodeID node = -1;
+  /** Mutex of the state */
+  std::mutex mutex;
+  /** Condition variable to wait for the completion */
+  std::condition_variable condition;
+  /** Flag to indicate that the operation is completed */
+  bool completed = false;
+  /** Result of the operation */
+  Status result;
+  /** Callback registered for the completion */
+  std::function<void()> callback;
+
+  /** Publishes the result and runs the callback */
+  void Complete(const Status &status) {
+    std::function<void()> cb;
+    {
+      std::scoped_lock<std::mutex> lk(mutex);
+      result = status;
+      completed = true;
+      cb = std::move(callback);
+      callback = nullptr;
+    }
+    condition.notify_all();
+    if (cb) {
+      cb();
+    }
+  }
+
+  /** Completes the operation with an error if it did not run */
+  void Discard() {
+    {
+      std::scoped_lock<std::mutex> lk(mutex);
+      if (completed) {
+        return;
+      }
+    }
+    function = nullptr;
+    Complete(Status{Status::EXECUTION_FAILED, "The operation was discarded"});
+  }
+};
+
+/* Completion held by the function of the node. If the function is destroyed
+   without running (i.e. the graph is destroyed with pending nodes), the
+   operation is completed with an error, so the waiters are released */
+class ExecutionFutureCompletion {
+ public:
+  explicit ExecutionFutureCompletion(
+      std::shared_ptr<ExecutionFutureState> state)
+      : state_{state} {}
+
+  Status Run() {
+    Status ret = state_->function();
+    state_->function = nullptr;
+    state_->Complete(ret);
+    return ret;
+  }
+
+  ~ExecutionFutureCompletion() { state_->Discard(); }
+
+ private:
+  std::shared_ptr<ExecutionFutureState> state_;
+};
+
+ExecutionFuture ExecutionFuture::Submit(
+    std::shared_ptr<IExecutionGraph> graph,
+    const IExecutionGraph::Function &function,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  ExecutionFuture future{};
+  future.state_ = std::make_shared<ExecutionFutureState>();
+  auto state = future.state_;
+
+  /* Without graph, the operation is synchronous */
+  if (!graph) {
+    state->Complete(function());
+    return future;
+  }
+
+  /* The operation is kept in the state, so the node only captures the
+     completion and fits in the graph function */
+  state->function = function;
+  auto completion = std::make_shared<ExecutionFutureCompletion>(state);
+  IExecutionGraph::Function func = [completion]() -> Status {
+    return completion->Run();
+  };
+
+  const IExecutionGraph::NodeID id = graph->Add(func, dependencies);
+  {
+    std::scoped_lock<std::mutex> lk(state->mutex);
+    state->node = id;
+  }
+
+  if (-1 == id) {
+    state->function = nullptr;
+    state->Complete(Status{Status::INVALID_PARAMETER,
+                           "The operation could not be added to the graph"});
+  }
+  return future;
+}
+
+bool ExecutionFuture::Valid() const { return static_cast<bool>(state_); }
+
+IExecutionGraph::NodeID ExecutionFuture::Node() const {
+  if (!state_) {
+    return -1;
+  }
+  std::scoped_lock<std::mutex> lk(state_->mutex);
+  return state_->node;
+}
+
+bool ExecutionFuture::Ready() const {
+  if (!state_) {
+    return false;
+  }
+  std::scoped_lock<std::mutex> lk(state_->mutex);
+  return state_->completed;
+}
+
+Status ExecutionFuture::Get() const {
+  if (!state_) {
+    return Status{Status::INVALID_PARAMETER, "The future is invalid"};
+  }
+  std::unique_lock<std::mutex> lk(state_->mutex);
+  state_->condition.wait(lk, [&] { return state_->completed; });
+  return state_->result;
+}
+
+bool ExecutionFuture::OnCompletion(
+    const std::function<void()> &callback) const {
+  if (!state_) {
+    return false;
+  }
+  std::scoped_lock<std::mutex> lk(state_->mutex);
+  if (state_->completed) {
+    return false;
+  }
+  state_->callback = callback;
+  return true;
+}
+}  // namespace cynq
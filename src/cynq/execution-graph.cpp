@@ -5,9 +5,14 @@
  * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
  *
  */
+#include <atomic>
 #include <cynq/execution-graph.hpp>
+#include <cynq/execution-graph/graph.hpp>
 #include <cynq/execution-graph/stream.hpp>
+#include <cynq/execution-trace.hpp>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace cynq {
 std::shared_ptr<IExecutionGraph> IExecutionGraph::Create(
@@ -16,8 +21,273 @@ std::shared_ptr<IExecutionGraph> IExecutionGraph::Create(
   switch (impl) {
     case IExecutionGraph::Type::STREAM:
       return std::make_shared<ExecutionStream>(params);
+    case IExecutionGraph::Type::SHARED_STREAM: {
+      auto shared_params = std::make_shared<ExecutionGraphParameters>();
+      if (params) {
+        *shared_params = *params;
+      }
+      if (!shared_params->pool) {
+        shared_params->pool = ExecutionPool::Default();
+      }
+      return std::make_shared<ExecutionStream>(shared_params);
+    }
+    case IExecutionGraph::Type::GRAPH:
+      return std::make_shared<ExecutionGraph>(params);
     default:
       return nullptr;
   }
 }
+
+/*
+   -- Scheduling --
+   Default implementations. The deadlines and the statistics require the
+   support of the implementation
+*/
+
+IExecutionGraph::NodeID IExecutionGraph::Add(
+    const IExecutionGraph::Function &function,
+    const std::vector<IExecutionGraph::NodeID> &dependencies,
+    const IExecutionGraph::Clock::time_point /*deadline*/) {
+  return this->Add(function, dependencies);
+}
+
+Status IExecutionGraph::GetStatistics(ExecutionGraphStatistics & /*stats*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The execution graph does not collect statistics"};
+}
+
+/*
+   -- Capture and replay --
+   Default implementations. BeginCapture() and EndCapture() require the
+   support of the implementation. Launch() only relies on Add()
+*/
+
+Status IExecutionGraph::BeginCapture() {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The execution graph does not support captures"};
+}
+
+std::shared_ptr<ExecutableGraph> IExecutionGraph::EndCapture() {
+  return nullptr;
+}
+
+IExecutionGraph::NodeID IExecutionGraph::Launch(
+    std::shared_ptr<ExecutableGraph> exec,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  if (!exec) {
+    return -1;
+  }
+
+  /* The launch holds the captured graph. Without events, the functions of
+     the captured graph are run directly, so launching does not allocate */
+  IExecutionGraph::Function func;
+  if (0 == exec->Events()) {
+    func = [exec]() -> Status { return exec->Run(); };
+  } else {
+    auto functions = std::make_shared<std::vector<IExecutionGraph::Function>>(
+        exec->Instantiate());
+    func = [exec, functions]() -> Status {
+      for (auto &function : *functions) {
+        Status st = function();
+        if (Status::OK != st.code) {
+          return st;
+        }
+      }
+      return Status{};
+    };
+  }
+
+  ExecutionTrace::Label label{"Launch"};
+  return this->Add(func, dependencies);
+}
+
+/*
+   -- Events --
+   The record and the wait are regular nodes, so they work with any
+   implementation of the graph
+*/
+
+/* Record of an event held by the function of a record node. The record is
+   discarded if the function is destroyed without running */
+class EventRecord {
+ public:
+  EventRecord(std::shared_ptr<ExecutionEvent> event, const uint64_t generation)
+      : event_{event}, generation_{generation} {}
+
+  void Signal() {
+    event_->Signal(generation_);
+    signalled_ = true;
+  }
+
+  ~EventRecord() {
+    if (!signalled_) {
+      event_->Abort(generation_);
+    }
+  }
+
+ private:
+  std::shared_ptr<ExecutionEvent> event_;
+  uint64_t generation_;
+  std::atomic<bool> signalled_{false};
+};
+
+IExecutionGraph::NodeID IExecutionGraph::RecordEvent(
+    std::shared_ptr<ExecutionEvent> event,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  if (!event) {
+    return -1;
+  }
+
+  /* The generation is taken when scheduling, so the waits scheduled from
+     now on refer to this record. If the node is dropped without running
+     (i.e. it was not added or the graph is destroyed), the last copy of the
+     function discards the record and releases the waiters */
+  auto record = std::make_shared<EventRecord>(event, event->Arm());
+  IExecutionGraph::Function func = [record]() -> Status {
+    record->Signal();
+    return Status{};
+  };
+
+  ExecutionTrace::Label label{"RecordEvent"};
+  return this->Add(func, dependencies);
+}
+
+IExecutionGraph::NodeID IExecutionGraph::WaitEvent(
+    std::shared_ptr<ExecutionEvent> event,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  if (!event) {
+    return -1;
+  }
+
+  const uint64_t generation = event->Generation();
+  IExecutionGraph::Function func = [event, generation]() -> Status {
+    return event->Wait(generation);
+  };
+
+  ExecutionTrace::Label label{"WaitEvent"};
+  return this->Add(func, dependencies);
+}
+
+IExecutionGraph::NodeID ExecutableGraph::Record(
+    const IExecutionGraph::Function &function,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  if (!function) {
+    return -1;
+  }
+  return this->Record(function, dependencies, nullptr, false);
+}
+
+IExecutionGraph::NodeID ExecutableGraph::RecordEvent(
+    std::shared_ptr<ExecutionEvent> event,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  if (!event) {
+    return -1;
+  }
+  return this->Record(nullptr, dependencies, event, true);
+}
+
+IExecutionGraph::NodeID ExecutableGraph::WaitEvent(
+    std::shared_ptr<ExecutionEvent> event,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  if (!event) {
+    return -1;
+  }
+  return this->Record(nullptr, dependencies, event, false);
+}
+
+IExecutionGraph::NodeID ExecutableGraph::Record(
+    const IExecutionGraph::Function &function,
+    const std::vector<IExecutionGraph::NodeID> &dependencies,
+    std::shared_ptr<ExecutionEvent> event, const bool record) {
+  const auto id = static_cast<IExecutionGraph::NodeID>(nodes_.size());
+  if (frozen_) {
+    return -1;
+  }
+
+  /* The dependencies must be captured before */
+  for (const IExecutionGraph::NodeID dep : dependencies) {
+    if (dep < 0 || dep >= id) {
+      return -1;
+    }
+  }
+
+  IExecutionGraph::Node node{};
+  node.id = id;
+  node.function = function;
+  node.dependencies = dependencies;
+  nodes_.push_back(std::move(node));
+  records_.push_back(record);
+  if (event) {
+    ++event_nodes_;
+  }
+  events_.push_back(std::move(event));
+  return id;
+}
+
+Status ExecutableGraph::Run() {
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    Status st{};
+    if (!events_[i]) {
+      st = nodes_[i].function();
+    } else if (records_[i]) {
+      events_[i]->Signal(events_[i]->Arm());
+    } else {
+      st = events_[i]->Wait(events_[i]->Generation());
+    }
+    if (Status::OK != st.code) {
+      return st;
+    }
+  }
+  return Status{};
+}
+
+std::vector<IExecutionGraph::Function> ExecutableGraph::Instantiate() const {
+  std::vector<IExecutionGraph::Function> functions;
+  functions.reserve(nodes_.size());
+
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    auto event = events_[i];
+    if (!event) {
+      functions.push_back(nodes_[i].function);
+    } else if (records_[i]) {
+      auto record = std::make_shared<EventRecord>(event, event->Arm());
+      functions.push_back([record]() -> Status {
+        record->Signal();
+        return Status{};
+      });
+    } else {
+      const uint64_t generation = event->Generation();
+      functions.push_back([event, generation]() -> Status {
+        return event->Wait(generation);
+      });
+    }
+  }
+  return functions;
+}
+
+Status ExecutableGraph::Update(const IExecutionGraph::NodeID node,
+                               const IExecutionGraph::Function &function) {
+  if (node < 0 || static_cast<size_t>(node) >= nodes_.size()) {
+    return Status{Status::INVALID_PARAMETER, "The node ID is invalid"};
+  }
+  if (events_[node]) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The event nodes cannot be updated"};
+  }
+  if (!function) {
+    return Status{Status::INVALID_PARAMETER, "The function is empty"};
+  }
+  nodes_[node].function = function;
+  return Status{};
+}
+
+size_t ExecutableGraph::Size() const { return nodes_.size(); }
+
+size_t ExecutableGraph::Events() const { return event_nodes_; }
+
+const std::vector<IExecutionGraph::Node> &ExecutableGraph::Nodes() const {
+  return nodes_;
+}
+
+void ExecutableGraph::Freeze() { frozen_ = true; }
 }  // namespace cynq
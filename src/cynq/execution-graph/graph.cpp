@@ -0,0 +1,508 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cynq/execution-graph/graph.hpp>
+#include <cynq/execution-trace.hpp>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+namespace cynq {
+
+/** Dependencies reserved per node of the arena. The vectors keep their
+    capacity when the slots are recycled, so they only allocate while warming
+    up or for nodes with more dependencies */
+static constexpr size_t kReservedDependencies = 4;
+
+/**
+ * @brief Define the parameters for the ExecutionGraph class
+ */
+struct ExecutionGraphInternalParameters : public ExecutionGraphParameters {
+  /** Arena of nodes. The node with ID n lives in the slot n & graph_mask, so
+      the parents and children pointers are stable while the nodes are
+      pending. The IDs whose slot is busy when adding are skipped */
+  std::unique_ptr<IExecutionGraph::Node[]> graph_nodes;
+  /** Flags to indicate that the slot holds a pending node */
+  std::unique_ptr<bool[]> graph_used;
+  /** Mask to compute the slot of a NodeID */
+  size_t graph_mask = 0;
+  /** Number of slots without a pending node */
+  size_t graph_free = 0;
+  /** Heap of nodes whose dependencies are completed, ready for execution.
+      The top is the node with the earliest deadline */
+  std::unique_ptr<IExecutionGraph::Node *[]> graph_ready;
+  /** Number of ready nodes */
+  size_t graph_ready_size = 0;
+  /** ID of the next node to add */
+  IExecutionGraph::NodeID graph_next_id = 0;
+  /** ID of the oldest node that is not completed yet */
+  IExecutionGraph::NodeID graph_oldest_id = 0;
+  /** Mutex for the graph */
+  std::mutex graph_mutex;
+  /** Condition variable to wake up the workers */
+  std::condition_variable graph_condition;
+  /** Condition variable used for synchronisation */
+  std::condition_variable graph_sync_condition;
+  /** Condition variable used by the producers when the graph is full */
+  std::condition_variable graph_full_condition;
+  /** Worker pool */
+  std::vector<std::thread> graph_threads;
+  /** Mutex for the last error */
+  std::mutex error_mutex;
+  /** Last error */
+  Status last_error;
+  /** Counters of the execution. They are protected by the graph mutex */
+  ExecutionGraphStatistics stats;
+  /** Identifier of the graph in the trace */
+  uint32_t trace_id = 0;
+  /** Terminate the workers */
+  bool graph_terminate = false;
+  /** Graph under capture. It is protected by the graph mutex */
+  std::shared_ptr<ExecutableGraph> capture;
+
+  /** Gets the slot of a node within the arena */
+  IExecutionGraph::Node &Slot(const IExecutionGraph::NodeID id) {
+    return graph_nodes[static_cast<size_t>(id) & graph_mask];
+  }
+  /** Checks if the node is pending. It requires the graph mutex */
+  bool IsPending(const IExecutionGraph::NodeID id) const {
+    const size_t slot = static_cast<size_t>(id) & graph_mask;
+    return graph_used[slot] && graph_nodes[slot].id == id;
+  }
+  /** Pushes a ready node. It requires the graph mutex */
+  void PushReady(IExecutionGraph::Node *node) {
+    graph_ready[graph_ready_size++] = node;
+    std::push_heap(graph_ready.get(), graph_ready.get() + graph_ready_size,
+                   IsLessUrgent);
+  }
+  /** Pops the most urgent ready node. It requires the graph mutex */
+  IExecutionGraph::Node *PopReady() {
+    std::pop_heap(graph_ready.get(), graph_ready.get() + graph_ready_size,
+                  IsLessUrgent);
+    return graph_ready[--graph_ready_size];
+  }
+  /** Order of the ready nodes: earliest deadline first. The ties are broken
+      by ID, so the nodes without deadline keep the order of addition */
+  static bool IsLessUrgent(const IExecutionGraph::Node *a,
+                           const IExecutionGraph::Node *b) {
+    if (a->deadline != b->deadline) {
+      return a->deadline > b->deadline;
+    }
+    return a->id > b->id;
+  }
+  /** Virtual destructor required for the inheritance */
+  virtual ~ExecutionGraphInternalParameters() = default;
+};
+
+ExecutionGraph::ExecutionGraph(std::shared_ptr<ExecutionGraphParameters> params)
+    : params_{std::make_shared<ExecutionGraphInternalParameters>()} {
+  /* Copy assigment */
+  if (params) {
+    *params_ = *params;
+  }
+  auto internal_params =
+      std::dynamic_pointer_cast<ExecutionGraphInternalParameters>(
+          this->params_);
+
+  /* Preallocate the arena. Its size is rounded up to a power of two */
+  size_t slots = 1;
+  while (slots < std::max<uint64_t>(internal_params->capacity, 1)) {
+    slots <<= 1;
+  }
+  internal_params->graph_mask = slots - 1;
+  internal_params->graph_free = slots;
+  internal_params->graph_nodes =
+      std::make_unique<IExecutionGraph::Node[]>(slots);
+  internal_params->graph_used = std::make_unique<bool[]>(slots);
+  internal_params->graph_ready =
+      std::make_unique<IExecutionGraph::Node *[]>(slots);
+  for (size_t i = 0; i < slots; ++i) {
+    IExecutionGraph::Node &node = internal_params->graph_nodes[i];
+    node.id = -1;
+    node.dependencies.reserve(kReservedDependencies);
+    node.parents.reserve(kReservedDependencies);
+    node.children.reserve(kReservedDependencies);
+    internal_params->graph_used[i] = false;
+  }
+
+  internal_params->trace_id = ExecutionTrace::RegisterGraph(
+      internal_params->name.empty() ? "graph" : internal_params->name);
+
+  uint64_t workers = internal_params->workers;
+  if (0 == workers) {
+    workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+  internal_params->graph_terminate = false;
+  for (uint64_t i = 0; i < workers; ++i) {
+    internal_params->graph_threads.emplace_back(&ExecutionGraph::Worker, this);
+  }
+}
+
+IExecutionGraph::NodeID ExecutionGraph::Add(
+    const IExecutionGraph::Function &function,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  return this->Add(function, dependencies,
+                   IExecutionGraph::Clock::time_point::max());
+}
+
+IExecutionGraph::NodeID ExecutionGraph::Add(
+    const IExecutionGraph::Function &function,
+    const std::vector<IExecutionGraph::NodeID> &dependencies,
+    const IExecutionGraph::Clock::time_point deadline) {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionGraphInternalParameters>(
+          this->params_);
+  bool ready = false;
+  IExecutionGraph::NodeID id = -1;
+
+  {
+    std::unique_lock<std::mutex> lk(params->graph_mutex);
+
+    /* Record the node instead of executing it while capturing */
+    if (params->capture) {
+      return params->capture->Record(function, dependencies);
+    }
+
+    /* Check the dependencies: they must have been added before */
+    for (const IExecutionGraph::NodeID dep : dependencies) {
+      if (dep < 0 || dep >= params->graph_next_id) {
+        return -1;
+      }
+    }
+
+    /* Wait until any slot is recycled. Waiting for the slot of the next ID
+       would block behind a long-running node, or forever if that node waits
+       for an event recorded by a later node */
+    params->graph_full_condition.wait(lk, [&] {
+      return params->graph_free != 0 || params->graph_terminate;
+    });
+    if (params->graph_terminate) {
+      return -1;
+    }
+
+    /* Skip the IDs whose slots are busy. The skipped IDs are never pending,
+       so they behave as completed nodes */
+    while (params->graph_used[static_cast<size_t>(params->graph_next_id) &
+                              params->graph_mask]) {
+      ++params->graph_next_id;
+    }
+
+    /* Construct the node in place. The copies reuse the slot storage */
+    id = params->graph_next_id++;
+    IExecutionGraph::Node &node = params->Slot(id);
+    node.id = id;
+    node.function = function;
+    node.dependencies.assign(dependencies.begin(), dependencies.end());
+    if (params->statistics || ExecutionTrace::Enabled()) {
+      node.enqueued = IExecutionGraph::Clock::now();
+    }
+    node.label = ExecutionTrace::CurrentLabel();
+    node.deadline = deadline;
+    params->graph_used[static_cast<size_t>(id) & params->graph_mask] = true;
+    --params->graph_free;
+
+    /* Link the pending parents. The completed ones are not in the arena */
+    for (const IExecutionGraph::NodeID dep : dependencies) {
+      if (!params->IsPending(dep)) {
+        continue;
+      }
+      IExecutionGraph::Node *parent = &params->Slot(dep);
+      if (std::find(node.parents.begin(), node.parents.end(), parent) !=
+          node.parents.end()) {
+        continue;
+      }
+      node.parents.push_back(parent);
+      parent->children.push_back(&node);
+    }
+
+    ready = node.parents.empty();
+    if (ready) {
+      params->PushReady(&node);
+    }
+  }
+
+  if (ready) {
+    params->graph_condition.notify_one();
+  }
+  return id;
+}
+
+Status ExecutionGraph::Sync(const IExecutionGraph::NodeID node) {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionGraphInternalParameters>(
+          this->params_);
+
+  std::unique_lock<std::mutex> lk(params->graph_mutex);
+
+  /* Filter the input argument */
+  if (node >= params->graph_next_id || node < -1) {
+    return Status{Status::INVALID_PARAMETER, "The node ID is invalid"};
+  }
+
+  if (node == -1) {
+    /* Wait until all the nodes added so far are completed. It is enough to
+       check the oldest pending node */
+    const IExecutionGraph::NodeID target_id = params->graph_next_id - 1;
+    params->graph_sync_condition.wait(lk, [&] {
+      return params->graph_oldest_id > target_id || params->graph_terminate;
+    });
+  } else {
+    params->graph_sync_condition.wait(lk, [&] {
+      return !params->IsPending(node) || params->graph_terminate;
+    });
+  }
+
+  return Status{Status::OK, "Synchronisation successful"};
+}
+
+Status ExecutionGraph::GetLastError() {
+  Status ret{};
+
+  auto params =
+      std::dynamic_pointer_cast<ExecutionGraphInternalParameters>(
+          this->params_);
+
+  {
+    /* Safe scope */
+    std::scoped_lock lock(params->error_mutex);
+    ret = params->last_error;
+  }
+
+  return ret;
+}
+
+Status ExecutionGraph::GetStatistics(ExecutionGraphStatistics &stats) {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionGraphInternalParameters>(
+          this->params_);
+
+  std::scoped_lock<std::mutex> lk(params->graph_mutex);
+  stats = params->stats;
+  return Status{};
+}
+
+Status ExecutionGraph::BeginCapture() {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionGraphInternalParameters>(
+          this->params_);
+
+  std::scoped_lock<std::mutex> lk(params->graph_mutex);
+  if (params->capture) {
+    return Status{Status::RESOURCE_BUSY, "There is a capture in progress"};
+  }
+  params->capture = std::make_shared<ExecutableGraph>();
+  return Status{};
+}
+
+std::shared_ptr<ExecutableGraph> ExecutionGraph::EndCapture() {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionGraphInternalParameters>(
+          this->params_);
+
+  std::scoped_lock<std::mutex> lk(params->graph_mutex);
+  auto exec = std::move(params->capture);
+  params->capture = nullptr;
+  if (exec) {
+    exec->Freeze();
+  }
+  return exec;
+}
+
+IExecutionGraph::NodeID ExecutionGraph::Launch(
+    std::shared_ptr<ExecutableGraph> exec,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  if (!exec) {
+    return -1;
+  }
+
+  /* Map the captured nodes to new nodes of the graph. The captured nodes
+     are ordered by their dependencies, so the parents are always mapped */
+  const auto &nodes = exec->Nodes();
+  std::vector<IExecutionGraph::Function> functions = exec->Instantiate();
+  std::vector<IExecutionGraph::NodeID> ids(nodes.size(), -1);
+  std::vector<bool> parents(nodes.size(), false);
+
+  ExecutionTrace::Label label{"Launch"};
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    std::vector<IExecutionGraph::NodeID> node_deps;
+    for (const IExecutionGraph::NodeID dep : nodes[i].dependencies) {
+      node_deps.push_back(ids[dep]);
+      parents[dep] = true;
+    }
+    if (node_deps.empty()) {
+      node_deps = dependencies;
+    }
+
+    ids[i] = this->Add(functions[i], node_deps);
+    if (-1 == ids[i]) {
+      return -1;
+    }
+  }
+
+  /* Join the captured nodes without children, so the launch is synchronised
+     through a single node */
+  std::vector<IExecutionGraph::NodeID> leaves;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    if (!parents[i]) {
+      leaves.push_back(ids[i]);
+    }
+  }
+  if (leaves.empty()) {
+    leaves = dependencies;
+  }
+  return this->Add([]() -> Status { return Status{}; }, leaves);
+}
+
+IExecutionGraph::NodeID ExecutionGraph::RecordEvent(
+    std::shared_ptr<ExecutionEvent> event,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionGraphInternalParameters>(
+          this->params_);
+
+  /* The captured records are armed when launching */
+  if (event) {
+    std::scoped_lock<std::mutex> lk(params->graph_mutex);
+    if (params->capture) {
+      return params->capture->RecordEvent(event, dependencies);
+    }
+  }
+
+  return IExecutionGraph::RecordEvent(event, dependencies);
+}
+
+IExecutionGraph::NodeID ExecutionGraph::WaitEvent(
+    std::shared_ptr<ExecutionEvent> event,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionGraphInternalParameters>(
+          this->params_);
+
+  /* The captured waits take the record when launching */
+  if (event) {
+    std::scoped_lock<std::mutex> lk(params->graph_mutex);
+    if (params->capture) {
+      return params->capture->WaitEvent(event, dependencies);
+    }
+  }
+
+  return IExecutionGraph::WaitEvent(event, dependencies);
+}
+
+void ExecutionGraph::Worker() {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionGraphInternalParameters>(
+          this->params_);
+
+  for (;;) {
+    IExecutionGraph::Node *node = nullptr;
+    const bool tracing = ExecutionTrace::Enabled();
+    IExecutionGraph::Clock::time_point start{};
+    {
+      std::unique_lock<std::mutex> lk(params->graph_mutex);
+      params->graph_condition.wait(lk, [&] {
+        return params->graph_ready_size != 0 || params->graph_terminate;
+      });
+      if (params->graph_terminate) {
+        break;
+      }
+      node = params->PopReady();
+
+      /* Account the queueing delay */
+      params->stats.nodes++;
+      if (params->statistics || tracing) {
+        start = IExecutionGraph::Clock::now();
+      }
+      if (params->statistics) {
+        const uint64_t delay = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                start - node->enqueued)
+                .count());
+        params->stats.total_queue_delay += delay;
+        params->stats.max_queue_delay =
+            std::max(params->stats.max_queue_delay, delay);
+      }
+    }
+
+    /* Execute the function inside. The failed nodes still release their
+       children, as in the ExecutionStream. The error is kept as last error */
+    Status ret = node->function();
+    if (Status::OK != ret.code) {
+      std::scoped_lock<std::mutex> lk(params->error_mutex);
+      params->last_error = ret;
+    }
+    const bool missed =
+        node->deadline != IExecutionGraph::Clock::time_point::max() &&
+        IExecutionGraph::Clock::now() > node->deadline;
+    if (tracing) {
+      ExecutionTrace::Record(params->trace_id, node->id, node->label,
+                             node->enqueued, start,
+                             IExecutionGraph::Clock::now());
+    }
+
+    /* Retire the node and release the children without pending parents */
+    size_t released = 0;
+    {
+      std::scoped_lock<std::mutex> lk(params->graph_mutex);
+      params->stats.deadline_misses += missed ? 1 : 0;
+      for (IExecutionGraph::Node *child : node->children) {
+        auto &parents = child->parents;
+        parents.erase(std::remove(parents.begin(), parents.end(), node),
+                      parents.end());
+        if (parents.empty()) {
+          params->PushReady(child);
+          ++released;
+        }
+      }
+
+      /* Recycle the slot. The vectors keep their capacity */
+      node->function = nullptr;
+      node->dependencies.clear();
+      node->children.clear();
+      params->graph_used[static_cast<size_t>(node->id) & params->graph_mask] =
+          false;
+      ++params->graph_free;
+      while (params->graph_oldest_id < params->graph_next_id &&
+             !params->IsPending(params->graph_oldest_id)) {
+        ++params->graph_oldest_id;
+      }
+    }
+
+    /* The current worker takes one of the released nodes in the next
+       iteration. Wake up the others only if there is more work */
+    if (released > 1) {
+      params->graph_condition.notify_all();
+    }
+    params->graph_sync_condition.notify_all();
+    params->graph_full_condition.notify_all();
+  }
+}
+
+ExecutionGraph::~ExecutionGraph() {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionGraphInternalParameters>(
+          this->params_);
+
+  {
+    /* Safe scope */
+    std::scoped_lock lock(params->graph_mutex);
+    params->graph_terminate = true;
+  }
+  params->graph_condition.notify_all();
+  params->graph_sync_condition.notify_all();
+  params->graph_full_condition.notify_all();
+
+  for (auto &thread : params->graph_threads) {
+    thread.join();
+  }
+}
+}  // namespace cynq
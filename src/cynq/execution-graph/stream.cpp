@@ -5,22 +5,32 @@
  * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
  */
 
-#include <chrono>              // NOLINT
+#include <atomic>
+#include <chrono>  // NOLINT
 #include <condition_variable>  // NOLINT
+#include <cynq/execution-graph/node-queue.hpp>
 #include <cynq/execution-graph/stream.hpp>
+#include <cynq/execution-pool.hpp>
+#include <cynq/execution-trace.hpp>
+#include <memory>
 #include <mutex>  // NOLINT
-#include <queue>
 #include <thread>  // NOLINT
+#include <utility>
+#include <vector>
 
 namespace cynq {
 
+/** Maximum number of nodes executed by a stream each time it is scheduled in
+    a shared pool. It bounds the time that other streams wait for a worker */
+static constexpr size_t kPoolBatchSize = 64;
+
 /**
  * @brief Define the parameters for the ExecutionStream class
  */
 struct ExecutionStreamParameters : public ExecutionGraphParameters {
-  /** Execution queue */
-  std::queue<IExecutionGraph::Node> stream_queue;
-  /** Mutex for the queue */
+  /** Execution queue: lock-free ring of preallocated nodes */
+  std::unique_ptr<NodeQueue<IExecutionGraph::Node>> stream_queue;
+  /** Mutex for the queue: only used to put the worker to sleep */
   std::mutex stream_mutex;
   /** Mutex for the queue synchronisation */
   std::mutex stream_sync_mutex;
@@ -28,20 +38,234 @@ struct ExecutionStreamParameters : public ExecutionGraphParameters {
   std::condition_variable stream_condition;
   /** Condition variable used for synchronisation */
   std::condition_variable stream_sync_condition;
-  /** Current ID to add */
-  IExecutionGraph::NodeID current_id = 0;
+  /** Condition variable used by the producers when the queue is full */
+  std::condition_variable stream_full_condition;
+  /** Completion counter: number of nodes retired by the worker. Since the
+      stream is FIFO, node N is completed iff retired_count > N */
+  std::atomic<IExecutionGraph::NodeID> retired_count{0};
+  /** Number of threads blocked in Sync() */
+  std::atomic<int> sync_waiters{0};
+  /** Number of producers waiting for a free slot */
+  std::atomic<int> full_waiters{0};
+  /** Flag to indicate that the worker is sleeping */
+  std::atomic<bool> worker_sleeping{false};
   /** Stream thread */
   std::thread stream_thread;
+  /** Mutex for the last error */
+  std::mutex error_mutex;
   /** Last error */
   Status last_error;
+  /** Accumulated queueing delay in nanoseconds. Only the worker writes the
+      counters, so they do not need read-modify-write operations */
+  std::atomic<uint64_t> stats_total_delay{0};
+  /** Maximum queueing delay in nanoseconds */
+  std::atomic<uint64_t> stats_max_delay{0};
+  /** Number of nodes completed after their deadline */
+  std::atomic<uint64_t> stats_deadline_misses{0};
+  /** Identifier of the stream in the trace */
+  uint32_t trace_id = 0;
   /** Terminate the worker */
-  bool stream_terminate = false;
-  /** Flag to indicate that it is running */
-  bool running = false;
+  std::atomic<bool> stream_terminate{false};
+  /** Flag to indicate that the worker has finished */
+  bool stopped = false;
+  /** Flag to indicate that the stream is capturing */
+  std::atomic<bool> capturing{false};
+  /** Mutex for the capture */
+  std::mutex capture_mutex;
+  /** Graph under capture */
+  std::shared_ptr<ExecutableGraph> capture;
+  /** Task that runs the stream in a shared pool */
+  struct PoolTask : public ExecutionPool::Task {
+    /** Parameters of the stream */
+    ExecutionStreamParameters *params = nullptr;
+    /** Executes a batch of nodes of the stream */
+    void Run() override;
+    /** Priority of the stream */
+    int Priority() const override { return params->priority; }
+    /** Deadline of the next node of the stream */
+    std::chrono::steady_clock::time_point Deadline() const override;
+  } pool_task;
+  /** Flag to indicate that the stream is scheduled in the pool. Only one
+      worker runs the stream at a time, so the FIFO order is kept */
+  std::atomic<bool> scheduled{false};
+  /** Flag to indicate that the stream waits for the event of its next node
+      without holding a worker of the pool */
+  std::atomic<bool> parked{false};
+  /** Reference to the parameters for the callbacks of the parked stream */
+  std::weak_ptr<ExecutionStreamParameters> self;
   /** Virtual destructor required for the inheritance */
   virtual ~ExecutionStreamParameters() = default;
 };
 
+/**
+ * @brief Parks a stream of a shared pool
+ *
+ * The stream releases its worker until the event waited by its next node
+ * completes. Then, the callback of the event schedules it again.
+ *
+ * @param params parameters of the stream
+ * @param node next node of the stream
+ * @return true if the stream is parked. false if the event is already
+ * completed, so the node does not block.
+ */
+static bool Park(ExecutionStreamParameters *params,
+                 const IExecutionGraph::Node &node) {
+  if (params->parked.exchange(true)) {
+    /* The callback is already registered */
+    return true;
+  }
+
+  std::weak_ptr<ExecutionStreamParameters> weak = params->self;
+  auto resume = [weak]() {
+    auto params = weak.lock();
+    if (!params) {
+      return;
+    }
+    /* The worker releases the stream under the same mutex, so either the
+       worker or the callback reschedules it */
+    std::scoped_lock<std::mutex> lk(params->stream_mutex);
+    params->parked.store(false);
+    if (!params->stream_terminate.load() &&
+        !params->scheduled.exchange(true)) {
+      params->pool->Schedule(&params->pool_task);
+    }
+  };
+
+  if (!node.event->OnCompletion(node.generation, resume)) {
+    params->parked.store(false);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Executes the nodes of the stream in FIFO order
+ *
+ * @param params parameters of the stream
+ * @param budget maximum number of nodes to execute
+ * @return size_t number of nodes executed. It is less than the budget if the
+ * queue is empty, the stream is terminated or it yields the worker of the
+ * shared pool
+ */
+static size_t ProcessNodes(ExecutionStreamParameters *params,
+                           const size_t budget) {
+  auto &queue = *params->stream_queue;
+  IExecutionGraph::Node node{};
+  size_t executed = 0;
+
+  while (executed < budget && !params->stream_terminate.load()) {
+    /* Give the worker of the shared pool to the streams with higher
+       priority. The stream is rescheduled afterwards */
+    if (params->pool && params->pool->ShouldYield(params->priority)) {
+      break;
+    }
+
+    /* Do not block the worker of the shared pool waiting for an event */
+    if (params->pool) {
+      const IExecutionGraph::Node *next = queue.Front();
+      if (next && next->event && Park(params, *next)) {
+        break;
+      }
+    }
+
+    bool popped = queue.Pop(node);
+
+    /* Wake up the producers waiting for a slot once half of the queue is
+       free. It avoids waking them up for every single slot */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (params->full_waiters.load() > 0 &&
+        queue.Size() <= queue.Capacity() / 2) {
+      { std::scoped_lock<std::mutex> lk(params->stream_mutex); }
+      params->stream_full_condition.notify_all();
+    }
+
+    if (!popped) {
+      break;
+    }
+
+    /* Account the queueing delay */
+    const bool tracing = ExecutionTrace::Enabled();
+    IExecutionGraph::Clock::time_point start{};
+    if (params->statistics || tracing) {
+      start = IExecutionGraph::Clock::now();
+    }
+    if (params->statistics) {
+      const uint64_t delay = static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(start -
+                                                               node.enqueued)
+              .count());
+      const auto relaxed = std::memory_order_relaxed;
+      params->stats_total_delay.store(
+          params->stats_total_delay.load(relaxed) + delay, relaxed);
+      if (delay > params->stats_max_delay.load(relaxed)) {
+        params->stats_max_delay.store(delay, relaxed);
+      }
+    }
+
+    /* Execute the function inside */
+    Status ret = node.function();
+    if (Status::OK != ret.code) {
+      std::scoped_lock<std::mutex> lk(params->error_mutex);
+      params->last_error = ret;
+    }
+    if (node.deadline != IExecutionGraph::Clock::time_point::max() &&
+        IExecutionGraph::Clock::now() > node.deadline) {
+      params->stats_deadline_misses.store(
+          params->stats_deadline_misses.load(std::memory_order_relaxed) + 1,
+          std::memory_order_relaxed);
+    }
+    if (tracing) {
+      ExecutionTrace::Record(params->trace_id, node.id, node.label,
+                             node.enqueued, start,
+                             IExecutionGraph::Clock::now());
+    }
+    /* Release the resources captured by the function */
+    node.function = nullptr;
+    node.event = nullptr;
+
+    /* Publish the completion. Only wake up the waiters if there is any */
+    params->retired_count.store(node.id + 1);
+    if (params->sync_waiters.load() > 0) {
+      { std::scoped_lock<std::mutex> lk(params->stream_sync_mutex); }
+      params->stream_sync_condition.notify_all();
+    }
+    ++executed;
+  }
+
+  return executed;
+}
+
+void ExecutionStreamParameters::PoolTask::Run() {
+  ProcessNodes(params, kPoolBatchSize);
+
+  /* Release the stream and reschedule it if there is pending work. The
+     destructor waits under the same mutex until the stream is released, so
+     the parameters are not touched after releasing it */
+  bool reschedule = false;
+  {
+    std::scoped_lock<std::mutex> lk(params->stream_mutex);
+    params->scheduled.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (params->stream_terminate.load()) {
+      params->stream_condition.notify_all();
+    } else if (!params->stream_queue->Empty() && !params->parked.load()) {
+      reschedule = !params->scheduled.exchange(true);
+    }
+  }
+
+  if (reschedule) {
+    params->pool->Schedule(this);
+  }
+}
+
+std::chrono::steady_clock::time_point
+ExecutionStreamParameters::PoolTask::Deadline() const {
+  /* It is called before scheduling the stream, so the worker is not
+     consuming the queue */
+  const IExecutionGraph::Node *node = params->stream_queue->Front();
+  return node ? node->deadline : IExecutionGraph::Clock::time_point::max();
+}
+
 ExecutionStream::ExecutionStream(
     std::shared_ptr<ExecutionGraphParameters> params)
     : params_{std::make_shared<ExecutionStreamParameters>()} {
@@ -52,52 +276,158 @@ ExecutionStream::ExecutionStream(
   auto internal_params =
       std::dynamic_pointer_cast<ExecutionStreamParameters>(this->params_);
 
-  internal_params->current_id = 0;
+  internal_params->stream_queue =
+      std::make_unique<NodeQueue<IExecutionGraph::Node>>(
+          internal_params->capacity);
+  internal_params->retired_count = 0;
   internal_params->stream_terminate = false;
-  internal_params->running = false;
-  internal_params->stream_thread = std::thread(&ExecutionStream::Worker, this);
+  internal_params->stopped = false;
+  internal_params->pool_task.params = internal_params.get();
+  internal_params->self = internal_params;
+  internal_params->trace_id = ExecutionTrace::RegisterGraph(
+      internal_params->name.empty() ? "stream" : internal_params->name);
+
+  /* The stream runs on the shared pool if given. Otherwise, it has its own
+     worker thread */
+  if (!internal_params->pool) {
+    internal_params->stream_thread =
+        std::thread(&ExecutionStream::Worker, this);
+  }
 }
 
 IExecutionGraph::NodeID ExecutionStream::Add(
     const IExecutionGraph::Function& function,
-    const std::vector<IExecutionGraph::NodeID> /*dependencies*/) {
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  return this->Add(function, dependencies,
+                   IExecutionGraph::Clock::time_point::max());
+}
+
+IExecutionGraph::NodeID ExecutionStream::Add(
+    const IExecutionGraph::Function& function,
+    const std::vector<IExecutionGraph::NodeID> &dependencies,
+    const IExecutionGraph::Clock::time_point deadline) {
   auto params =
       std::dynamic_pointer_cast<ExecutionStreamParameters>(this->params_);
-  NodeID ret;
-  {
-    /* Safe scope */
-    std::scoped_lock lock(params->stream_mutex);
 
-    /* Construct a new node: others are not needed */
-    IExecutionGraph::Node node{};
-    ret = params->current_id++;
-    node.id = ret;
+  /* Record the node instead of executing it while capturing */
+  if (params->capturing.load()) {
+    std::scoped_lock<std::mutex> lk(params->capture_mutex);
+    if (params->capture) {
+      return params->capture->Record(function, dependencies);
+    }
+  }
+
+  return this->Enqueue(function, deadline, nullptr, 0);
+}
+
+IExecutionGraph::NodeID ExecutionStream::RecordEvent(
+    std::shared_ptr<ExecutionEvent> event,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionStreamParameters>(this->params_);
+
+  /* The captured records are armed when launching */
+  if (event && params->capturing.load()) {
+    std::scoped_lock<std::mutex> lk(params->capture_mutex);
+    if (params->capture) {
+      return params->capture->RecordEvent(event, dependencies);
+    }
+  }
+
+  return IExecutionGraph::RecordEvent(event, dependencies);
+}
+
+IExecutionGraph::NodeID ExecutionStream::WaitEvent(
+    std::shared_ptr<ExecutionEvent> event,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionStreamParameters>(this->params_);
+
+  if (!event) {
+    return -1;
+  }
+
+  /* The captured waits take the record when launching */
+  if (params->capturing.load()) {
+    std::scoped_lock<std::mutex> lk(params->capture_mutex);
+    if (params->capture) {
+      return params->capture->WaitEvent(event, dependencies);
+    }
+  }
+
+  const uint64_t generation = event->Generation();
+  IExecutionGraph::Function func = [event, generation]() -> Status {
+    return event->Wait(generation);
+  };
+
+  ExecutionTrace::Label label{"WaitEvent"};
+  return this->Enqueue(func, IExecutionGraph::Clock::time_point::max(), event,
+                       generation);
+}
+
+IExecutionGraph::NodeID ExecutionStream::Enqueue(
+    const IExecutionGraph::Function &function,
+    const IExecutionGraph::Clock::time_point deadline,
+    std::shared_ptr<ExecutionEvent> event, const uint64_t generation) {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionStreamParameters>(this->params_);
+
+  /* Construct the node in place within the preallocated ring. The ticket
+     given by the queue keeps the FIFO order, so it is used as the ID */
+  IExecutionGraph::Clock::time_point enqueued{};
+  if (params->statistics || ExecutionTrace::Enabled()) {
+    enqueued = IExecutionGraph::Clock::now();
+  }
+  const char *label = ExecutionTrace::CurrentLabel();
+  auto writer = [&](IExecutionGraph::Node& node, const size_t pos) {
+    node.id = static_cast<IExecutionGraph::NodeID>(pos);
     node.function = function;
+    node.enqueued = enqueued;
+    node.deadline = deadline;
+    node.label = label;
+    node.event = event;
+    node.generation = generation;
+  };
+  size_t ticket = 0;
+  while (!params->stream_queue->TryPush(writer, ticket)) {
+    /* Full: wait until the worker releases a slot */
+    std::unique_lock<std::mutex> lk(params->stream_mutex);
+    params->full_waiters++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    params->stream_full_condition.wait(lk, [&] {
+      return !params->stream_queue->Full() || params->stream_terminate.load();
+    });
+    params->full_waiters--;
+    if (params->stream_terminate.load()) {
+      return -1;
+    }
+  }
 
-    /* Enqueue for work */
-    params->stream_queue.push(node);
+  /* Schedule the stream in the pool unless it is already scheduled */
+  if (params->pool) {
+    if (!params->scheduled.exchange(true)) {
+      params->pool->Schedule(&params->pool_task);
+    }
+    return static_cast<IExecutionGraph::NodeID>(ticket);
   }
 
-  /* Notify in case the worker was empty */
-  params->stream_condition.notify_one();
-  return ret;
+  /* Notify in case the worker was sleeping */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (params->worker_sleeping.load()) {
+    { std::scoped_lock<std::mutex> lk(params->stream_mutex); }
+    params->stream_condition.notify_one();
+  }
+  return static_cast<IExecutionGraph::NodeID>(ticket);
 }
 
 Status ExecutionStream::Sync(const IExecutionGraph::NodeID node) {
   NodeID current_id = -1;
   NodeID target_id = -1;
-  NodeID executing_id = -1;
-  bool empty = true;
-  bool running = true;
 
   auto params =
       std::dynamic_pointer_cast<ExecutionStreamParameters>(this->params_);
 
-  params->stream_mutex.lock();
-  current_id = params->current_id;
-  empty = params->stream_queue.empty();
-  executing_id = params->stream_queue.front().id;
-  params->stream_mutex.unlock();
+  current_id = static_cast<NodeID>(params->stream_queue->Tickets());
 
   /* Filter the input argument */
   if (node >= current_id) {
@@ -106,27 +436,23 @@ Status ExecutionStream::Sync(const IExecutionGraph::NodeID node) {
   } else if (node == -1) {
     /* In case of not defining it, just place the last one */
     target_id = current_id - 1;
-  } else if (empty) {
-    /* In case the queue is empty */
-    return Status{Status::OK, "No pending actions"};
   } else {
     target_id = node;
   }
 
-  /* Synchronise */
-  while (executing_id <= target_id && running) {
-    std::unique_lock<std::mutex> lk(params->stream_sync_mutex);
-    params->stream_sync_condition.wait_for(
-        lk, std::chrono::microseconds(params->timeout));
+  /* Fast path: the target already retired */
+  if (params->retired_count.load() > target_id) {
+    return Status{Status::OK, "No pending actions"};
+  }
 
-    params->stream_mutex.lock();
-    if (!params->stream_queue.empty()) {
-      executing_id = params->stream_queue.front().id - 1;
-    } else {
-      executing_id = params->current_id - 1;
-    }
-    running = params->running;
-    params->stream_mutex.unlock();
+  /* Synchronise: the worker notifies every time a node retires */
+  {
+    std::unique_lock<std::mutex> lk(params->stream_sync_mutex);
+    params->sync_waiters++;
+    params->stream_sync_condition.wait(lk, [&] {
+      return params->retired_count.load() > target_id || params->stopped;
+    });
+    params->sync_waiters--;
   }
 
   return Status{Status::OK, "Synchronisation successful"};
@@ -140,57 +466,76 @@ Status ExecutionStream::GetLastError() {
 
   {
     /* Safe scope */
-    std::scoped_lock lock(params->stream_mutex);
+    std::scoped_lock lock(params->error_mutex);
     ret = params->last_error;
   }
 
   return ret;
 }
 
-void ExecutionStream::Worker() {
-  bool finish = false;
+Status ExecutionStream::GetStatistics(ExecutionGraphStatistics &stats) {
   auto params =
       std::dynamic_pointer_cast<ExecutionStreamParameters>(this->params_);
 
-  while (!finish) {
-    bool empty = false;
-    IExecutionGraph::Node node{};
-    node.id = -1;
+  stats.nodes = static_cast<uint64_t>(params->retired_count.load());
+  stats.total_queue_delay = params->stats_total_delay.load();
+  stats.max_queue_delay = params->stats_max_delay.load();
+  stats.deadline_misses = params->stats_deadline_misses.load();
+  return Status{};
+}
 
-    /* Check if there is a node: if there is no node, waits until the condition
-       variable timeouts. Once the notification is done, it reiterates
-       again. If it is not empty, just proceed */
+Status ExecutionStream::BeginCapture() {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionStreamParameters>(this->params_);
 
-    params->stream_mutex.lock();
-    empty = params->stream_queue.empty();
-    params->running = !empty;
-    params->stream_mutex.unlock();
+  std::scoped_lock<std::mutex> lk(params->capture_mutex);
+  if (params->capture) {
+    return Status{Status::RESOURCE_BUSY, "There is a capture in progress"};
+  }
+  params->capture = std::make_shared<ExecutableGraph>();
+  params->capturing.store(true);
+  return Status{};
+}
 
-    if (empty) {
-      std::unique_lock<std::mutex> lk(params->stream_mutex);
-      params->stream_condition.wait_for(
-          lk, std::chrono::microseconds(params->timeout));
-    } else {
-      std::scoped_lock<std::mutex> lk(params->stream_mutex);
-      node = params->stream_queue.front();
-      params->stream_queue.pop();
-    }
+std::shared_ptr<ExecutableGraph> ExecutionStream::EndCapture() {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionStreamParameters>(this->params_);
 
-    /* Execute the function inside */
-    if (node.id != -1) {
-      Status ret = node.function();
-      if (Status::OK != ret.code) {
-        std::scoped_lock<std::mutex> lk(params->stream_mutex);
-        params->last_error = ret;
-      }
+  std::scoped_lock<std::mutex> lk(params->capture_mutex);
+  auto exec = std::move(params->capture);
+  params->capture = nullptr;
+  params->capturing.store(false);
+  if (exec) {
+    exec->Freeze();
+  }
+  return exec;
+}
+
+void ExecutionStream::Worker() {
+  auto params =
+      std::dynamic_pointer_cast<ExecutionStreamParameters>(this->params_);
+  auto& queue = *params->stream_queue;
+
+  while (!params->stream_terminate.load()) {
+    /* Wait until there is a node or the stream is terminated. There is no
+       polling: Add() and the destructor notify the worker if sleeping */
+    if (0 == ProcessNodes(params.get(), kPoolBatchSize)) {
+      std::unique_lock<std::mutex> lk(params->stream_mutex);
+      params->worker_sleeping.store(true);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      params->stream_condition.wait(lk, [&] {
+        return !queue.Empty() || params->stream_terminate.load();
+      });
+      params->worker_sleeping.store(false);
     }
+  }
 
-    /* Check for termination */
-    params->stream_mutex.lock();
-    finish = params->stream_terminate;
-    params->stream_mutex.unlock();
-    params->stream_sync_condition.notify_one();
+  /* Release any waiter since no more nodes will be retired */
+  {
+    std::scoped_lock<std::mutex> lk(params->stream_sync_mutex);
+    params->stopped = true;
   }
+  params->stream_sync_condition.notify_all();
 }
 
 ExecutionStream::~ExecutionStream() {
@@ -199,10 +544,27 @@ ExecutionStream::~ExecutionStream() {
 
   {
     /* Safe scope */
-    std::scoped_lock lock(params->stream_mutex);
+    std::unique_lock<std::mutex> lock(params->stream_mutex);
     params->stream_terminate = true;
+    if (params->pool) {
+      /* Wait until the pool releases the stream */
+      params->stream_condition.wait(lock,
+                                    [&] { return !params->scheduled.load(); });
+    }
   }
 
-  params->stream_thread.join();
+  if (!params->pool) {
+    params->stream_condition.notify_one();
+    params->stream_thread.join();
+    return;
+  }
+
+  /* Release any waiter since no more nodes will be retired */
+  {
+    std::scoped_lock<std::mutex> lk(params->stream_sync_mutex);
+    params->stopped = true;
+  }
+  params->stream_sync_condition.notify_all();
+  params->stream_full_condition.notify_all();
 }
 }  // namespace cynq
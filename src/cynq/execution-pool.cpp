@@ -0,0 +1,227 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cynq/execution-pool.hpp>
+#include <deque>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace cynq {
+
+/**
+ * @brief Define the parameters for the ExecutionPool class
+ */
+struct ExecutionPoolParameters {
+  /** Task with the scheduling keys taken when it was scheduled */
+  struct Entry {
+    /** Task to run */
+    ExecutionPool::Task *task;
+    /** Priority of the task */
+    int priority;
+    /** Deadline of the task */
+    std::chrono::steady_clock::time_point deadline;
+  };
+  /** Queue of tasks sorted by urgency */
+  struct WorkerQueue {
+    /** Mutex of the queue. It is only contended when stealing */
+    std::mutex mutex;
+    /** Tasks sorted by priority and deadline. The ties keep the FIFO order.
+        Both the owner and the thieves pop from the front */
+    std::deque<Entry> tasks;
+  };
+  /** One queue per worker */
+  std::vector<std::unique_ptr<WorkerQueue>> queues;
+  /** Queue of the tasks with positive priority, shared by all workers */
+  WorkerQueue urgent;
+  /** Number of tasks in the shared queue */
+  std::atomic<size_t> urgent_count{0};
+  /** Worker threads */
+  std::vector<std::thread> threads;
+  /** Number of tasks scheduled and not taken yet */
+  std::atomic<size_t> pending{0};
+  /** Number of sleeping workers */
+  std::atomic<size_t> sleeping{0};
+  /** Queue for the next task scheduled from outside of the pool */
+  std::atomic<size_t> next_queue{0};
+  /** Mutex to put the workers to sleep */
+  std::mutex sleep_mutex;
+  /** Condition variable to wake up the workers */
+  std::condition_variable sleep_condition;
+  /** Terminate the workers */
+  std::atomic<bool> terminate{false};
+};
+
+/** Checks if the entry a must run before the entry b */
+static bool IsMoreUrgent(const ExecutionPoolParameters::Entry &a,
+                         const ExecutionPoolParameters::Entry &b) {
+  if (a.priority != b.priority) {
+    return a.priority > b.priority;
+  }
+  return a.deadline < b.deadline;
+}
+
+/** Inserts the entry after the ones with the same or more urgency */
+static void Insert(ExecutionPoolParameters::WorkerQueue &queue,
+                   const ExecutionPoolParameters::Entry &entry) {
+  std::scoped_lock<std::mutex> lk(queue.mutex);
+  auto pos = std::upper_bound(queue.tasks.begin(), queue.tasks.end(), entry,
+                              IsMoreUrgent);
+  queue.tasks.insert(pos, entry);
+}
+
+/** Pops the most urgent task of the queue. nullptr if empty */
+static ExecutionPool::Task *PopFront(
+    ExecutionPoolParameters::WorkerQueue &queue) {
+  std::scoped_lock<std::mutex> lk(queue.mutex);
+  if (queue.tasks.empty()) {
+    return nullptr;
+  }
+  ExecutionPool::Task *task = queue.tasks.front().task;
+  queue.tasks.pop_front();
+  return task;
+}
+
+/** Pool that owns the current thread, if it is a worker */
+static thread_local const ExecutionPoolParameters *current_pool = nullptr;
+/** Index of the current worker within its pool */
+static thread_local size_t current_worker = 0;
+
+ExecutionPool::ExecutionPool(const size_t workers)
+    : params_{std::make_shared<ExecutionPoolParameters>()} {
+  size_t num_workers = workers;
+  if (0 == num_workers) {
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  for (size_t i = 0; i < num_workers; ++i) {
+    params_->queues.emplace_back(
+        std::make_unique<ExecutionPoolParameters::WorkerQueue>());
+  }
+  for (size_t i = 0; i < num_workers; ++i) {
+    params_->threads.emplace_back(&ExecutionPool::Worker, this, i);
+  }
+}
+
+std::shared_ptr<ExecutionPool> ExecutionPool::Create(const size_t workers) {
+  return std::make_shared<ExecutionPool>(workers);
+}
+
+std::shared_ptr<ExecutionPool> ExecutionPool::Default() {
+  static std::shared_ptr<ExecutionPool> pool = ExecutionPool::Create();
+  return pool;
+}
+
+void ExecutionPool::Schedule(ExecutionPool::Task *task) {
+  const ExecutionPoolParameters::Entry entry{task, task->Priority(),
+                                             task->Deadline()};
+
+  params_->pending.fetch_add(1);
+  if (entry.priority > 0) {
+    params_->urgent_count.fetch_add(1);
+    Insert(params_->urgent, entry);
+  } else {
+    const size_t num_queues = params_->queues.size();
+    size_t index = 0;
+    if (current_pool == params_.get()) {
+      index = current_worker;
+    } else {
+      index = params_->next_queue.fetch_add(1) % num_queues;
+    }
+    Insert(*params_->queues[index], entry);
+  }
+
+  /* Wake up a worker only if there is any sleeping */
+  if (params_->sleeping.load() > 0) {
+    { std::scoped_lock<std::mutex> lk(params_->sleep_mutex); }
+    params_->sleep_condition.notify_one();
+  }
+}
+
+/** Checks if the most urgent task of the queue has a higher priority */
+static bool HasHigherPriority(ExecutionPoolParameters::WorkerQueue &queue,
+                              const int priority) {
+  std::scoped_lock<std::mutex> lk(queue.mutex);
+  return !queue.tasks.empty() && queue.tasks.front().priority > priority;
+}
+
+bool ExecutionPool::ShouldYield(const int priority) const {
+  if (params_->urgent_count.load() > 0 &&
+      HasHigherPriority(params_->urgent, priority)) {
+    return true;
+  }
+
+  /* The worker queues only hold priorities up to 0, so only the background
+     tasks (negative priority) have to look at them */
+  if (priority >= 0 || 0 == params_->pending.load()) {
+    return false;
+  }
+  for (auto &queue : params_->queues) {
+    if (HasHigherPriority(*queue, priority)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t ExecutionPool::Workers() const { return params_->threads.size(); }
+
+void ExecutionPool::Worker(const size_t index) {
+  const size_t num_queues = params_->queues.size();
+  current_pool = params_.get();
+  current_worker = index;
+
+  while (!params_->terminate.load()) {
+    Task *task = nullptr;
+
+    /* Take the high-priority tasks first. Then, take from the own queue and
+       steal from the others */
+    if (params_->urgent_count.load() > 0) {
+      task = PopFront(params_->urgent);
+      if (task) {
+        params_->urgent_count.fetch_sub(1);
+      }
+    }
+    for (size_t i = 0; i < num_queues && !task; ++i) {
+      task = PopFront(*params_->queues[(index + i) % num_queues]);
+    }
+
+    if (task) {
+      params_->pending.fetch_sub(1);
+      task->Run();
+      continue;
+    }
+
+    /* No work: sleep until a task is scheduled */
+    std::unique_lock<std::mutex> lk(params_->sleep_mutex);
+    params_->sleeping.fetch_add(1);
+    params_->sleep_condition.wait(lk, [&] {
+      return params_->pending.load() > 0 || params_->terminate.load();
+    });
+    params_->sleeping.fetch_sub(1);
+  }
+
+  current_pool = nullptr;
+}
+
+ExecutionPool::~ExecutionPool() {
+  {
+    std::scoped_lock<std::mutex> lk(params_->sleep_mutex);
+    params_->terminate.store(true);
+  }
+  params_->sleep_condition.notify_all();
+
+  for (auto &thread : params_->threads) {
+    thread.join();
+  }
+}
+}  // namespace cynq
@@ -0,0 +1,257 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cynq/execution-trace.hpp>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+namespace cynq {
+
+/**
+ * @brief Buffer of events owned by a worker thread
+ */
+struct ExecutionTraceBuffer {
+  /** Execution of a node */
+  struct Event {
+    /** Identifier of the graph */
+    uint32_t graph;
+    /** ID of the node */
+    int64_t node;
+    /** Label of the node */
+    const char *label;
+    /** Time when the node was added */
+    std::chrono::steady_clock::time_point enqueued;
+    /** Time when the node started */
+    std::chrono::steady_clock::time_point start;
+    /** Time when the node finished */
+    std::chrono::steady_clock::time_point end;
+  };
+  /** Preallocated events */
+  std::unique_ptr<Event[]> events;
+  /** Number of events of the buffer */
+  size_t capacity = 0;
+  /** Number of events written. It is published after writing the event */
+  std::atomic<size_t> size{0};
+  /** Number of events dropped because the buffer was full */
+  std::atomic<uint64_t> dropped{0};
+  /** Identifier of the thread in the trace */
+  uint32_t thread = 0;
+};
+
+/**
+ * @brief Process-wide state of the tracer
+ */
+struct ExecutionTraceRegistry {
+  /** Flag to indicate that the recording is enabled */
+  std::atomic<bool> enabled{false};
+  /** Capacity of the new buffers */
+  std::atomic<size_t> capacity{65536};
+  /** Mutex for the buffers and the graph names */
+  std::mutex mutex;
+  /** Buffers of the worker threads. They outlive the threads */
+  std::vector<std::shared_ptr<ExecutionTraceBuffer>> buffers;
+  /** Identifiers of the graphs by name */
+  std::map<std::string, uint32_t> graph_ids;
+  /** Names of the graphs by identifier */
+  std::vector<std::string> graph_names;
+  /** Origin of the timestamps of the trace */
+  std::chrono::steady_clock::time_point epoch =
+      std::chrono::steady_clock::now();
+};
+
+/** Gets the process-wide state. It is created on the first use */
+static ExecutionTraceRegistry &Registry() {
+  static ExecutionTraceRegistry registry;
+  return registry;
+}
+
+/** Buffer of the current thread */
+static thread_local std::shared_ptr<ExecutionTraceBuffer> current_buffer;
+/** Label of the nodes added by the current thread */
+static thread_local const char *current_label = nullptr;
+
+/** Escapes a string for JSON */
+static std::string Escape(const std::string &str) {
+  std::string out;
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      out += ' ';
+    } else {
+      out += c;
+    }
+  }
+  return out;
+}
+
+/** Converts a time point into microseconds since the epoch of the trace */
+static double ToMicroseconds(
+    const std::chrono::steady_clock::time_point point,
+    const std::chrono::steady_clock::time_point epoch) {
+  std::chrono::duration<double, std::micro> elapsed = point - epoch;
+  return elapsed.count();
+}
+
+ExecutionTrace::Label::Label(const char *name) : previous_{current_label} {
+  current_label = name;
+}
+
+ExecutionTrace::Label::~Label() { current_label = previous_; }
+
+void ExecutionTrace::Enable(const size_t capacity) {
+  auto &registry = Registry();
+  registry.capacity.store(capacity);
+  registry.enabled.store(true);
+}
+
+void ExecutionTrace::Disable() { Registry().enabled.store(false); }
+
+bool ExecutionTrace::Enabled() {
+  return Registry().enabled.load(std::memory_order_relaxed);
+}
+
+void ExecutionTrace::Clear() {
+  auto &registry = Registry();
+  std::scoped_lock<std::mutex> lk(registry.mutex);
+  for (auto &buffer : registry.buffers) {
+    buffer->size.store(0);
+    buffer->dropped.store(0);
+  }
+}
+
+const char *ExecutionTrace::CurrentLabel() { return current_label; }
+
+uint32_t ExecutionTrace::RegisterGraph(const std::string &name) {
+  auto &registry = Registry();
+  std::scoped_lock<std::mutex> lk(registry.mutex);
+  auto it = registry.graph_ids.find(name);
+  if (it != registry.graph_ids.end()) {
+    return it->second;
+  }
+  const auto id = static_cast<uint32_t>(registry.graph_names.size());
+  registry.graph_names.push_back(name);
+  registry.graph_ids.emplace(name, id);
+  return id;
+}
+
+void ExecutionTrace::Record(
+    const uint32_t graph, const int64_t node, const char *label,
+    const std::chrono::steady_clock::time_point enqueued,
+    const std::chrono::steady_clock::time_point start,
+    const std::chrono::steady_clock::time_point end) {
+  auto &registry = Registry();
+  if (!registry.enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+
+  /* The buffer is created on the first event of the thread */
+  if (!current_buffer) {
+    auto buffer = std::make_shared<ExecutionTraceBuffer>();
+    buffer->capacity = registry.capacity.load();
+    buffer->events =
+        std::make_unique<ExecutionTraceBuffer::Event[]>(buffer->capacity);
+    std::scoped_lock<std::mutex> lk(registry.mutex);
+    buffer->thread = static_cast<uint32_t>(registry.buffers.size());
+    registry.buffers.push_back(buffer);
+    current_buffer = buffer;
+  }
+
+  /* Only this thread writes into the buffer */
+  ExecutionTraceBuffer &buffer = *current_buffer;
+  const size_t pos = buffer.size.load(std::memory_order_relaxed);
+  if (pos >= buffer.capacity) {
+    buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.events[pos] = {graph, node, label, enqueued, start, end};
+  buffer.size.store(pos + 1, std::memory_order_release);
+}
+
+Status ExecutionTrace::Dump(const std::string &filename) {
+  auto &registry = Registry();
+  std::ofstream file{filename};
+  if (!file.is_open()) {
+    return Status{Status::FILE_ERROR, "Cannot open the trace file"};
+  }
+
+  std::scoped_lock<std::mutex> lk(registry.mutex);
+  const auto epoch = registry.epoch;
+  bool first = true;
+  auto separator = [&]() -> const char * {
+    const char *sep = first ? "\n" : ",\n";
+    first = false;
+    return sep;
+  };
+
+  file << std::fixed << std::setprecision(3);
+  file << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  for (const auto &buffer : registry.buffers) {
+    const uint32_t tid = buffer->thread;
+    file << separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+         << "\"tid\":" << tid << ",\"args\":{\"name\":\"cynq worker " << tid
+         << "\"}}";
+
+    const size_t size = buffer->size.load(std::memory_order_acquire);
+    for (size_t i = 0; i < size; ++i) {
+      const auto &event = buffer->events[i];
+      const std::string name = Escape(event.label ? event.label : "Node");
+      const std::string graph =
+          event.graph < registry.graph_names.size()
+              ? Escape(registry.graph_names[event.graph])
+              : std::string{};
+      const bool queued = event.enqueued.time_since_epoch().count() != 0;
+      const double start = ToMicroseconds(event.start, epoch);
+      const double end = ToMicroseconds(event.end, epoch);
+      const double enqueued =
+          queued ? ToMicroseconds(event.enqueued, epoch) : start;
+      const uint64_t id = (static_cast<uint64_t>(tid) << 32) | i;
+
+      /* Execution of the node in the worker */
+      file << separator() << "{\"name\":\"" << name << "\",\"cat\":\""
+           << graph << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+           << ",\"ts\":" << start << ",\"dur\":" << end - start
+           << ",\"args\":{\"graph\":\"" << graph << "\",\"node\":"
+           << event.node << ",\"queue_us\":" << start - enqueued << "}}";
+
+      /* Queueing time of the node. The nodes added before enabling the
+         recording do not have it */
+      if (queued) {
+        file << separator() << "{\"name\":\"" << name << " (queued)\","
+             << "\"cat\":\"" << graph << "\",\"ph\":\"b\",\"pid\":1,"
+             << "\"tid\":" << tid << ",\"id\":" << id
+             << ",\"ts\":" << enqueued << "}";
+        file << separator() << "{\"name\":\"" << name << " (queued)\","
+             << "\"cat\":\"" << graph << "\",\"ph\":\"e\",\"pid\":1,"
+             << "\"tid\":" << tid << ",\"id\":" << id << ",\"ts\":" << start
+             << "}";
+      }
+    }
+
+    const uint64_t dropped = buffer->dropped.load();
+    if (dropped > 0) {
+      file << separator() << "{\"name\":\"dropped events\",\"ph\":\"i\","
+           << "\"s\":\"t\",\"pid\":1,\"tid\":" << tid
+           << ",\"ts\":0,\"args\":{\"count\":" << dropped << "}}";
+    }
+  }
+  file << "\n]}\n";
+
+  if (!file.good()) {
+    return Status{Status::FILE_ERROR, "Cannot write the trace file"};
+  }
+  return Status{};
+}
+}  // namespace cynq
@@ -62,6 +62,14 @@ std::shared_ptr<IExecutionGraph> IHardware::GetExecutionStream(
   return IExecutionGraph::Create(type, output_params);
 }
 
+std::shared_ptr<IExecutionGraph> IHardware::GetExecutionStream(
+    const std::string& name, const IExecutionGraph::Type type,
+    const int priority) {
+  auto params = std::make_shared<ExecutionGraphParameters>();
+  params->priority = priority;
+  return this->GetExecutionStream(name, type, params);
+}
+
 std::vector<float> IHardware::GetClocks() noexcept {
   return std::vector<float>(0);
 }
@@ -70,4 +78,13 @@ Status IHardware::SetClocks(const std::vector<float>& /*clocks*/) {
   return Status{Status::NOT_IMPLEMENTED, "Cannot adjust clocks"};
 }
 
+Status IHardware::GetMemoryStatistics(
+    std::vector<MemoryBankStatistics>& /*stats*/) {
+  return Status{Status::NOT_IMPLEMENTED, "Cannot account the memory"};
+}
+
+Status IHardware::SetMemoryBudget(const int /*memory_bank*/,
+                                  const size_t /*bytes*/) {
+  return Status{Status::NOT_IMPLEMENTED, "Cannot account the memory"};
+}
 }  // namespace cynq
@@ -6,9 +6,11 @@
  *         Diego Arturo Avila Torres <diego.avila@uned.cr>
  *
  */
+#include <cynq/execution-trace.hpp>
 #include <cynq/memory.hpp>
 #include <cynq/xrt/memory.hpp>
 #include <memory>
+#include <vector>
 
 namespace cynq {
 std::shared_ptr<IMemory> IMemory::Create(IMemory::Type impl,
@@ -23,8 +25,39 @@ std::shared_ptr<IMemory> IMemory::Create(IMemory::Type impl,
   }
 }
 
+Status IMemory::Sync(const SyncType type, const size_t size,
+                     const size_t offset) {
+  if (offset > this->Size() || size > this->Size() - offset) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The offset and size exceeds the memory size"};
+  }
+  return this->Sync(type);
+}
+
+uint8_t *IMemory::GetHostPointer() { return this->GetHostAddress().get(); }
+
+uint8_t *IMemory::GetDevicePointer() {
+  return this->GetDeviceAddress().get();
+}
+
+Status IMemory::SetDirtyTracking(const bool /*enable*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The memory does not track the dirty regions"};
+}
+
+Status IMemory::MarkDirty(const size_t /*offset*/, const size_t /*size*/) {
+  return Status{Status::NOT_IMPLEMENTED,
+                "The memory does not track the dirty regions"};
+}
+
+std::shared_ptr<IMemory> IMemory::Slice(const size_t /*offset*/,
+                                        const size_t /*size*/) {
+  return nullptr;
+}
+
 Status IMemory::Sync(std::shared_ptr<IExecutionGraph> graph,
-                     const SyncType type) {
+                     const SyncType type,
+                     const std::vector<IExecutionGraph::NodeID> &dependencies) {
   Status st{};
 
   /* Check the stream */
@@ -38,7 +71,42 @@ Status IMemory::Sync(std::shared_ptr<IExecutionGraph> graph,
   };
 
   /* Add function */
-  st.retval = graph->Add(func);
+  ExecutionTrace::Label label{"MemorySync"};
+  st.retval = graph->Add(func, dependencies);
   return st;
 }
+
+Status IMemory::Sync(std::shared_ptr<IExecutionGraph> graph,
+                     const SyncType type, const size_t size,
+                     const size_t offset,
+                     const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  Status st{};
+
+  /* Check the stream */
+  if (!graph) {
+    return this->Sync(type, size, offset);
+  }
+
+  /* Functor to execute  */
+  IExecutionGraph::Function func = [&, type, size, offset]() -> Status {
+    return this->Sync(type, size, offset);
+  };
+
+  /* Add function */
+  ExecutionTrace::Label label{"MemorySync"};
+  st.retval = graph->Add(func, dependencies);
+  return st;
+}
+
+ExecutionFuture IMemory::SyncAsync(
+    std::shared_ptr<IExecutionGraph> graph, const SyncType type,
+    const std::vector<IExecutionGraph::NodeID> &dependencies) {
+  /* Functor to execute  */
+  IExecutionGraph::Function func = [&, type]() -> Status {
+    return this->Sync(type);
+  };
+
+  ExecutionTrace::Label label{"MemorySync"};
+  return ExecutionFuture::Submit(graph, func, dependencies);
+}
 }  // namespace cynq
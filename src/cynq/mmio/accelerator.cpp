@@ -209,7 +209,7 @@ Status MMIOAccelerator::Attach(const uint64_t addr,
     return Status{Status::INVALID_PARAMETER, "The pointer is null"};
   }
 
-  auto ptr = mem->DeviceAddress<uint8_t>().get();
+  auto ptr = mem->DeviceSpan<uint8_t>().Data();
   if (!ptr) {
     return Status{
         Status::INVALID_PARAMETER,
@@ -0,0 +1,203 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <algorithm>
+#include <cynq/placement.hpp>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace cynq {
+Status PlacementPlanner::AddTensor(
+    const std::string &name, const size_t size,
+    const std::vector<PlacementArgument> &arguments, const size_t traffic,
+    const MemoryType type) {
+  if (arguments.empty()) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The tensor " + name + " is not accessed by any argument"};
+  }
+
+  /* The tensor can only go to the banks reachable by all the arguments */
+  std::vector<int> banks;
+  for (size_t i = 0; i < arguments.size(); ++i) {
+    if (!arguments[i].accelerator) {
+      return Status{Status::INVALID_PARAMETER,
+                    "The tensor " + name + " has a null accelerator"};
+    }
+    std::vector<int> reachable =
+        arguments[i].accelerator->GetMemoryBanks(arguments[i].pos);
+    std::sort(reachable.begin(), reachable.end());
+    reachable.erase(std::unique(reachable.begin(), reachable.end()),
+                    reachable.end());
+    if (0 == i) {
+      banks = reachable;
+      continue;
+    }
+    std::vector<int> common;
+    std::set_intersection(banks.begin(), banks.end(), reachable.begin(),
+                          reachable.end(), std::back_inserter(common));
+    banks = common;
+  }
+
+  if (banks.empty()) {
+    return Status{Status::INCOMPATIBLE_PARAMETER,
+                  "The arguments of the tensor " + name +
+                      " are not connected to a common memory bank"};
+  }
+  return this->AddTensor(name, size, banks, traffic, type);
+}
+
+Status PlacementPlanner::AddTensor(const std::string &name, const size_t size,
+                                   const std::vector<int> &banks,
+                                   const size_t traffic,
+                                   const MemoryType type) {
+  if (0 == size || banks.empty()) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The tensor " + name + " has no size or no banks"};
+  }
+
+  PlacementTensor tensor;
+  tensor.name = name;
+  tensor.size = size;
+  tensor.traffic = 0 == traffic ? size : traffic;
+  tensor.type = type;
+  tensor.candidates = banks;
+  std::sort(tensor.candidates.begin(), tensor.candidates.end());
+  tensor.candidates.erase(
+      std::unique(tensor.candidates.begin(), tensor.candidates.end()),
+      tensor.candidates.end());
+
+  tensors_.push_back(tensor);
+  planned_ = false;
+
+  Status st{};
+  st.retval = static_cast<int>(tensors_.size() - 1);
+  return st;
+}
+
+void PlacementPlanner::SetBankCapacity(const int bank, const size_t bytes) {
+  if (0 == bytes) {
+    capacities_.erase(bank);
+  } else {
+    capacities_[bank] = bytes;
+  }
+  planned_ = false;
+}
+
+Status PlacementPlanner::Plan(std::vector<PlacementBankUsage> &usage) {
+  usage.clear();
+  planned_ = false;
+  if (tensors_.empty()) {
+    return Status{Status::INVALID_PARAMETER, "There are no tensors to place"};
+  }
+
+  /* The tensors with the most traffic (and fewer candidates, as they are
+     harder to place) go first */
+  std::vector<size_t> order(tensors_.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    const PlacementTensor &ta = tensors_[a];
+    const PlacementTensor &tb = tensors_[b];
+    if (ta.traffic != tb.traffic) {
+      return ta.traffic > tb.traffic;
+    }
+    return ta.candidates.size() < tb.candidates.size();
+  });
+
+  /* Greedy: each tensor goes to its candidate with the least traffic so far
+     and room for it. The ties are broken by the allocated bytes and then by
+     the bank ID */
+  std::map<int, PlacementBankUsage> banks;
+  for (const size_t index : order) {
+    PlacementTensor &tensor = tensors_[index];
+    int best = -1;
+    for (const int bank : tensor.candidates) {
+      const PlacementBankUsage &candidate = banks[bank];
+      auto capacity = capacities_.find(bank);
+      if (capacity != capacities_.end() &&
+          candidate.bytes + tensor.size > capacity->second) {
+        continue;
+      }
+      if (-1 == best) {
+        best = bank;
+        continue;
+      }
+      const PlacementBankUsage &current = banks[best];
+      if (candidate.traffic < current.traffic ||
+          (candidate.traffic == current.traffic &&
+           candidate.bytes < current.bytes)) {
+        best = bank;
+      }
+    }
+
+    if (-1 == best) {
+      for (auto &entry : tensors_) {
+        entry.bank = -1;
+      }
+      return Status{Status::OUT_OF_MEMORY,
+                    "The tensor " + tensor.name +
+                        " does not fit in any of its memory banks"};
+    }
+
+    PlacementBankUsage &selected = banks[best];
+    selected.bank = best;
+    selected.tensors++;
+    selected.bytes += tensor.size;
+    selected.traffic += tensor.traffic;
+    tensor.bank = best;
+  }
+
+  for (const auto &entry : banks) {
+    if (entry.second.tensors != 0) {
+      usage.push_back(entry.second);
+    }
+  }
+  planned_ = true;
+  return Status{};
+}
+
+Status PlacementPlanner::Allocate(
+    std::shared_ptr<IDataMover> mover,
+    std::vector<std::shared_ptr<IMemory>> &buffers) {
+  buffers.clear();
+  if (!mover) {
+    return Status{Status::INVALID_PARAMETER, "The data mover is null"};
+  }
+
+  if (!planned_) {
+    std::vector<PlacementBankUsage> usage;
+    Status st = this->Plan(usage);
+    if (st.code != Status::OK) {
+      return st;
+    }
+  }
+
+  for (const auto &tensor : tensors_) {
+    std::shared_ptr<IMemory> mem;
+    Status st = mover->AllocateBuffer(tensor.size, mem, tensor.bank,
+                                      tensor.type);
+    if (Status::NOT_IMPLEMENTED == st.code) {
+      mem = mover->GetBuffer(tensor.size, tensor.bank, tensor.type);
+      st = Status{};
+    }
+    if (st.code != Status::OK) {
+      buffers.clear();
+      st.msg = "Cannot allocate the tensor " + tensor.name + ": " + st.msg;
+      return st;
+    }
+    buffers.push_back(mem);
+  }
+  return Status{};
+}
+
+const std::vector<PlacementTensor> &PlacementPlanner::Tensors() const {
+  return tensors_;
+}
+}  // namespace cynq
@@ -0,0 +1,78 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <cynq/execution-trace.hpp>
+#include <cynq/transfer-channel.hpp>
+#include <memory>
+
+namespace cynq {
+TransferChannel::TransferChannel(
+    std::shared_ptr<IDataMover> mover, const SyncType type,
+    std::shared_ptr<ExecutionGraphParameters> params)
+    : mover_{mover},
+      type_{type},
+      stream_{IExecutionGraph::Create(IExecutionGraph::Type::STREAM, params)} {
+}
+
+TransferChannel::~TransferChannel() {
+  /* The nodes of the stream refer to the channel */
+  if (stream_) {
+    stream_->Sync();
+  }
+}
+
+SyncType TransferChannel::Type() const { return type_; }
+
+ExecutionFuture TransferChannel::Enqueue(const std::shared_ptr<IMemory> mem,
+                                         const size_t size,
+                                         const size_t offset) {
+  /* The transfer is synchronous within the stream, so the future is ready
+     once it is completed */
+  IExecutionGraph::Function func = [this, mem, size, offset]() -> Status {
+    Status st = SyncType::HostToDevice == type_
+                    ? mover_->Upload(mem, size, offset, ExecutionType::Sync)
+                    : mover_->Download(mem, size, offset, ExecutionType::Sync);
+    if (Status::OK == st.code) {
+      bytes_ += size;
+    }
+    completed_++;
+    pending_--;
+    return st;
+  };
+
+  if (!mover_ || !stream_) {
+    return ExecutionFuture::Submit(nullptr, [] {
+      return Status{Status::INVALID_PARAMETER,
+                    "The channel has no data mover or stream"};
+    });
+  }
+
+  pending_++;
+  ExecutionTrace::Label label{SyncType::HostToDevice == type_
+                                  ? "ChannelUpload"
+                                  : "ChannelDownload"};
+  ExecutionFuture future = ExecutionFuture::Submit(stream_, func);
+  if (future.Node() < 0) {
+    /* It was not added: the future holds the error */
+    pending_--;
+  }
+  return future;
+}
+
+Status TransferChannel::Sync() {
+  if (!stream_) {
+    return Status{Status::INVALID_PARAMETER, "The channel has no stream"};
+  }
+  return stream_->Sync();
+}
+
+size_t TransferChannel::Pending() const { return pending_.load(); }
+
+uint64_t TransferChannel::Completed() const { return completed_.load(); }
+
+uint64_t TransferChannel::Bytes() const { return bytes_.load(); }
+}  // namespace cynq
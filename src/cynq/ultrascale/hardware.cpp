@@ -26,6 +26,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 extern "C" {
 #include <pynq_api.h> /* FIXME: to be removed in future releases */
@@ -428,6 +429,29 @@ std::shared_ptr<IAccelerator> UltraScale::GetAccelerator(
   return nullptr;
 }
 
+Status UltraScale::GetMemoryStatistics(
+    std::vector<MemoryBankStatistics> &stats) {
+  UltraScaleParameters *params =
+      dynamic_cast<UltraScaleParameters *>(this->parameters_.get());
+  if (!params) {
+    return Status{Status::INCOMPATIBLE_PARAMETER,
+                  "Hardware params incompatible"};
+  }
+  params->pool_->GetBankStatistics(stats);
+  return Status{};
+}
+
+Status UltraScale::SetMemoryBudget(const int memory_bank, const size_t bytes) {
+  UltraScaleParameters *params =
+      dynamic_cast<UltraScaleParameters *>(this->parameters_.get());
+  if (!params) {
+    return Status{Status::INCOMPATIBLE_PARAMETER,
+                  "Hardware params incompatible"};
+  }
+  params->pool_->SetBudget(memory_bank, bytes);
+  return Status{};
+}
+
 UltraScale::~UltraScale() {}
 
 }  // namespace cynq
@@ -13,6 +13,7 @@
 #include <xrt/xrt_uuid.h>
 #pragma GCC diagnostic pop
 
+#include <algorithm>
 #include <cynq/accelerator.hpp>
 #include <cynq/alveo/hardware.hpp>
 #include <cynq/enums.hpp>
@@ -22,6 +23,7 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 namespace cynq {
 /**
@@ -35,6 +37,8 @@ struct XRTAcceleratorParameters : public AcceleratorParameters {
   std::weak_ptr<HardwareParameters> hwparams_;
   /** Kernel run wrapper */
   xrt::run run_;
+  /** Kernel name */
+  std::string name_;
   /** Virtual destructor required for the inheritance */
   virtual ~XRTAcceleratorParameters() = default;
 };
@@ -55,6 +59,7 @@ XRTAccelerator::XRTAccelerator(
   }
   /* Create the XRT Kernel */
   params->hwparams_ = xrthwparams;
+  params->name_ = kernelname;
   params->kernel_ =
       xrt::kernel(xrthwparams->device_, xrthwparams->uuid_, kernelname,
                   xrt::kernel::cu_access_mode::exclusive);
@@ -182,7 +187,7 @@ Status XRTAccelerator::Attach(const uint64_t index,
     return Status{Status::INVALID_PARAMETER, "The pointer is null"};
   }
 
-  auto ptr = mem->DeviceAddress<uint8_t>().get();
+  auto ptr = mem->DeviceSpan<uint8_t>().Data();
   if (!ptr) {
     return Status{
         Status::INVALID_PARAMETER,
@@ -202,4 +207,37 @@ int XRTAccelerator::GetMemoryBank(const uint pos) {
   return params->kernel_.group_id(pos);
 }
 
+std::vector<int> XRTAccelerator::GetMemoryBanks(const uint pos) {
+  auto params = dynamic_cast<XRTAcceleratorParameters *>(accel_params_.get());
+  auto hwparams =
+      std::dynamic_pointer_cast<AlveoParameters>(params->hwparams_.lock());
+  std::vector<int> banks;
+
+  /* The xclbin names the kernels without the compute unit (kernel:{cu}) */
+  const std::string name = params->name_.substr(0, params->name_.find(':'));
+  if (hwparams) {
+    try {
+      for (const auto &kernel : hwparams->xclbin_.get_kernels()) {
+        if (kernel.get_name() != name) {
+          continue;
+        }
+        for (const auto &mem : kernel.get_arg(pos).get_mems()) {
+          if (mem.get_used()) {
+            banks.push_back(mem.get_index());
+          }
+        }
+      }
+    } catch (const std::exception &) {
+      banks.clear();
+    }
+  }
+
+  if (banks.empty()) {
+    banks.push_back(this->GetMemoryBank(pos));
+  }
+  std::sort(banks.begin(), banks.end());
+  banks.erase(std::unique(banks.begin(), banks.end()), banks.end());
+  return banks;
+}
+
 }  // namespace cynq
@@ -0,0 +1,385 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <xrt/xrt_bo.h>
+#include <xrt/xrt_device.h>
+
+#include <algorithm>
+#include <cynq/xrt/buffer-pool.hpp>
+#include <exception>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cynq {
+XRTBufferPool::XRTBufferPool(const size_t limit) : limit_{limit}, stats_{} {
+  stats_.limit = limit;
+}
+
+size_t XRTBufferPool::SizeClass(const size_t size) {
+  if (size <= kMinimumClass) {
+    return kMinimumClass;
+  }
+
+  /* Four classes per power of two: the waste is below 25% */
+  size_t power = kMinimumClass;
+  while ((power << 1) < size) {
+    power <<= 1;
+  }
+  const size_t step = power >> 2;
+  return ((size + step - 1) / step) * step;
+}
+
+xrt::bo::flags XRTBufferPool::Flags(const MemoryType type) {
+  switch (type) {
+    case MemoryType::Cacheable:
+      return xrt::bo::flags::cacheable;
+    case MemoryType::Device:
+      return xrt::bo::flags::device_only;
+    case MemoryType::Host:
+      return xrt::bo::flags::host_only;
+    default:
+      return xrt::bo::flags::normal;
+  }
+}
+
+Status XRTBufferPool::Acquire(const xrt::device &device, const size_t size,
+                              const int bank, const MemoryType type,
+                              std::shared_ptr<xrt::bo> &bo) {
+  const size_t bytes = SizeClass(size);
+  const Key key{bytes, bank, type};
+  HostMemoryOptions options;
+  bo = nullptr;
+
+  {
+    std::scoped_lock<std::mutex> lk(mutex_);
+    MemoryBankStatistics &account = Account(bank);
+    auto it = buffers_.find(key);
+    if (it != buffers_.end() && !it->second.empty()) {
+      bo = std::move(it->second.back());
+      it->second.pop_back();
+      stats_.hits++;
+      stats_.cached_buffers--;
+      stats_.cached_bytes -= bytes;
+      account.cached_bytes -= bytes;
+      account.requested_bytes += size;
+      return Status{};
+    }
+
+    /* Fail fast before reaching XRT. The idle buffers of the bank are
+       reclaimed first */
+    if (account.budget != 0 &&
+        account.allocated_bytes + bytes > account.budget) {
+      const size_t target = account.budget > bytes ? account.budget - bytes : 0;
+      ReclaimLocked(bank, target);
+      if (account.allocated_bytes + bytes > account.budget) {
+        account.failures++;
+        return Status{Status::OUT_OF_MEMORY,
+                      "The allocation exceeds the memory budget of the bank"};
+      }
+    }
+
+    /* The bytes are reserved so that concurrent allocations see them */
+    stats_.misses++;
+    account.allocated_bytes += bytes;
+    account.requested_bytes += size;
+    account.buffers++;
+    account.type_bytes.at(static_cast<size_t>(type)) += bytes;
+    account.peak_bytes =
+        std::max(account.peak_bytes, account.allocated_bytes);
+    options = host_options_;
+  }
+
+  /* The allocations are done without the lock since they go to the kernel.
+     The host memory is only placed by hand if requested */
+  Status st{};
+  bool fallback = false;
+  if ((MemoryType::Host == type || MemoryType::Dual == type) &&
+      (options.numa_node >= 0 ||
+       options.page_size != HostMemoryOptions::kDefaultPage)) {
+    st = AllocateHost(device, bytes, bank, type, options, bo, fallback);
+  }
+
+  if (!bo && Status::OK == st.code) {
+    try {
+      const xrt::memory_group group = (xrt::memory_group)(bank);
+      bo = std::make_shared<xrt::bo>(device, bytes, Flags(type), group);
+    } catch (const std::exception &e) {
+      st = Status{Status::OUT_OF_MEMORY,
+                  std::string("Cannot allocate the buffer: ") + e.what()};
+    }
+  }
+
+  if (!bo || fallback) {
+    std::scoped_lock<std::mutex> lk(mutex_);
+    if (fallback) {
+      stats_.host_fallbacks++;
+    }
+    if (!bo) {
+      Account(bank).requested_bytes -= size;
+      Account(bank).failures++;
+      FreedLocked(key);
+      return st;
+    }
+  }
+  return Status{};
+}
+
+Status XRTBufferPool::AllocateHost(const xrt::device &device,
+                                   const size_t size, const int bank,
+                                   const MemoryType type,
+                                   const HostMemoryOptions &options,
+                                   std::shared_ptr<xrt::bo> &bo,
+                                   bool &fallback) {
+  const size_t system_page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  bo = nullptr;
+  fallback = false;
+
+  /* Page sizes to try, from the requested one down to the system page. The
+     buffers smaller than a huge page use the largest page that fits them */
+  std::vector<size_t> pages;
+  if (options.page_size >= HostMemoryOptions::kHugePage1G) {
+    pages.push_back(HostMemoryOptions::kHugePage1G);
+  }
+  if (options.page_size >= HostMemoryOptions::kHugePage2M) {
+    pages.push_back(HostMemoryOptions::kHugePage2M);
+  }
+  pages.push_back(system_page);
+  while (pages.size() > 1 && pages.front() > size) {
+    pages.erase(pages.begin());
+  }
+  if (options.strict) {
+    pages.resize(1);
+  }
+
+  /* The NUMA policy of the thread is changed while mapping, so the huge
+     pages are reserved and faulted (MAP_POPULATE) in the node. Otherwise,
+     a missing huge page would fault later with SIGBUS */
+  constexpr size_t kBits = 8 * sizeof(unsigned long);  // NOLINT
+  unsigned long old_mask[kMaxNumaNodes / kBits] = {0};  // NOLINT
+  int old_mode = MPOL_DEFAULT;
+  bool bound = false;
+  if (options.numa_node >= 0) {
+    unsigned long mask[kMaxNumaNodes / kBits] = {0};  // NOLINT
+    mask[options.numa_node / kBits] = 1ul << (options.numa_node % kBits);
+    /* The kernel expects the number of bits plus one */
+    if (0 == syscall(SYS_get_mempolicy, &old_mode, old_mask,
+                     kMaxNumaNodes + 1, nullptr, 0)) {
+      const int mode = options.strict ? MPOL_BIND : MPOL_PREFERRED;
+      bound = 0 == syscall(SYS_set_mempolicy, mode, mask, kMaxNumaNodes + 1);
+    }
+    if (!bound && options.strict) {
+      return Status{Status::CONFIGURATION_ERROR,
+                    "Cannot bind the host memory to the NUMA node"};
+    }
+    fallback = !bound;
+  }
+
+  void *ptr = MAP_FAILED;
+  size_t length = 0;
+  for (size_t i = 0; i < pages.size() && MAP_FAILED == ptr; ++i) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE;
+    if (pages[i] != system_page) {
+      flags |= MAP_HUGETLB | (__builtin_ctzl(pages[i]) << MAP_HUGE_SHIFT);
+    }
+    length = ((size + pages[i] - 1) / pages[i]) * pages[i];
+    ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+    fallback = fallback || (MAP_FAILED == ptr);
+  }
+
+  if (bound) {
+    syscall(SYS_set_mempolicy, old_mode, old_mask, kMaxNumaNodes + 1);
+  }
+  if (MAP_FAILED == ptr) {
+    if (options.strict) {
+      fallback = false;
+      return Status{Status::OUT_OF_MEMORY,
+                    "The requested pages are not available"};
+    }
+    return Status{};
+  }
+
+  /* Wrap the pages into a user-pointer buffer object. The pages are
+     unmapped once the buffer object is destroyed */
+  std::unique_ptr<xrt::bo> object;
+  try {
+    const xrt::memory_group group = (xrt::memory_group)(bank);
+    object = std::make_unique<xrt::bo>(device, ptr, size, Flags(type), group);
+  } catch (const std::exception &e) {
+    munmap(ptr, length);
+    fallback = !options.strict;
+    if (options.strict) {
+      return Status{Status::CONFIGURATION_ERROR,
+                    std::string("Cannot import the host memory: ") + e.what()};
+    }
+    return Status{};
+  }
+
+  bo = std::shared_ptr<xrt::bo>(object.release(), [ptr, length](xrt::bo *b) {
+    delete b;
+    munmap(ptr, length);
+  });
+  return Status{};
+}
+
+void XRTBufferPool::Release(std::shared_ptr<xrt::bo> bo, const size_t size,
+                            const int bank, const MemoryType type) {
+  if (!bo) {
+    return;
+  }
+
+  const size_t bytes = SizeClass(size);
+  std::shared_ptr<xrt::bo> evicted;
+  {
+    std::scoped_lock<std::mutex> lk(mutex_);
+    MemoryBankStatistics &account = Account(bank);
+    account.requested_bytes -= size;
+    if (bo.use_count() > 1) {
+      /* Still referenced (i.e. by a transfer in flight or a view): it is
+         not recycled and it is freed by its last owner */
+      FreedLocked(Key{bytes, bank, type});
+      evicted = std::move(bo);
+    } else if (stats_.cached_bytes + bytes > limit_) {
+      stats_.evicted++;
+      FreedLocked(Key{bytes, bank, type});
+      /* Freed out of the lock */
+      evicted = std::move(bo);
+    } else {
+      buffers_[Key{bytes, bank, type}].push_back(std::move(bo));
+      stats_.recycled++;
+      stats_.cached_buffers++;
+      stats_.cached_bytes += bytes;
+      stats_.peak_cached_bytes =
+          std::max(stats_.peak_cached_bytes, stats_.cached_bytes);
+      account.cached_bytes += bytes;
+    }
+  }
+}
+
+void XRTBufferPool::SetLimit(const size_t limit) {
+  std::scoped_lock<std::mutex> lk(mutex_);
+  limit_ = limit;
+  stats_.limit = limit;
+  TrimLocked(limit);
+}
+
+size_t XRTBufferPool::Trim(const size_t target) {
+  std::scoped_lock<std::mutex> lk(mutex_);
+  return TrimLocked(target);
+}
+
+size_t XRTBufferPool::TrimLocked(const size_t target) {
+  size_t freed = 0;
+
+  /* The keys are sorted by size class, so the largest buffers go first */
+  for (auto it = buffers_.rbegin();
+       it != buffers_.rend() && stats_.cached_bytes > target; ++it) {
+    const size_t bytes = std::get<0>(it->first);
+    auto &list = it->second;
+    while (!list.empty() && stats_.cached_bytes > target) {
+      EvictLocked(it->first, list);
+      freed += bytes;
+    }
+  }
+  return freed;
+}
+
+size_t XRTBufferPool::ReclaimLocked(const int bank, const size_t target) {
+  MemoryBankStatistics &account = Account(bank);
+  size_t freed = 0;
+
+  /* Same as TrimLocked() but restricted to the bank */
+  for (auto it = buffers_.rbegin();
+       it != buffers_.rend() && account.allocated_bytes > target; ++it) {
+    if (std::get<1>(it->first) != bank) {
+      continue;
+    }
+    const size_t bytes = std::get<0>(it->first);
+    auto &list = it->second;
+    while (!list.empty() && account.allocated_bytes > target) {
+      EvictLocked(it->first, list);
+      freed += bytes;
+    }
+  }
+  return freed;
+}
+
+MemoryBankStatistics &XRTBufferPool::Account(const int bank) {
+  MemoryBankStatistics &account = banks_[bank];
+  account.bank = bank;
+  return account;
+}
+
+void XRTBufferPool::EvictLocked(const Key &key,
+                                std::vector<std::shared_ptr<xrt::bo>> &list) {
+  const size_t bytes = std::get<0>(key);
+  list.pop_back();
+  stats_.evicted++;
+  stats_.cached_buffers--;
+  stats_.cached_bytes -= bytes;
+  Account(std::get<1>(key)).cached_bytes -= bytes;
+  FreedLocked(key);
+}
+
+void XRTBufferPool::FreedLocked(const Key &key) {
+  const size_t bytes = std::get<0>(key);
+  MemoryBankStatistics &account = Account(std::get<1>(key));
+  account.allocated_bytes -= bytes;
+  account.buffers--;
+  account.type_bytes.at(static_cast<size_t>(std::get<2>(key))) -= bytes;
+}
+
+void XRTBufferPool::GetStatistics(BufferPoolStatistics &stats) {
+  std::scoped_lock<std::mutex> lk(mutex_);
+  stats = stats_;
+}
+
+void XRTBufferPool::SetBudget(const int bank, const size_t budget) {
+  std::scoped_lock<std::mutex> lk(mutex_);
+  Account(bank).budget = budget;
+  if (budget != 0) {
+    ReclaimLocked(bank, budget);
+  }
+}
+
+void XRTBufferPool::SetHostOptions(const HostMemoryOptions &options) {
+  std::scoped_lock<std::mutex> lk(mutex_);
+  host_options_ = options;
+
+  /* The cached buffers follow the previous placement */
+  for (auto &entry : buffers_) {
+    const MemoryType type = std::get<2>(entry.first);
+    if (MemoryType::Host != type && MemoryType::Dual != type) {
+      continue;
+    }
+    while (!entry.second.empty()) {
+      EvictLocked(entry.first, entry.second);
+    }
+  }
+}
+
+void XRTBufferPool::GetBankStatistics(
+    std::vector<MemoryBankStatistics> &stats) {
+  std::scoped_lock<std::mutex> lk(mutex_);
+  stats.clear();
+  for (const auto &entry : banks_) {
+    MemoryBankStatistics account = entry.second;
+    if (account.allocated_bytes != 0) {
+      account.fragmentation =
+          1.f - static_cast<float>(account.requested_bytes) /
+                    static_cast<float>(account.allocated_bytes);
+    }
+    stats.push_back(account);
+  }
+}
+}  // namespace cynq
@@ -11,18 +11,47 @@
 #include <cynq/alveo/hardware.hpp>
 #include <cynq/datamover.hpp>
 #include <cynq/enums.hpp>
+#include <cynq/execution-future.hpp>
+#include <cynq/execution-graph.hpp>
 #include <cynq/hardware.hpp>
 #include <cynq/memory.hpp>
 #include <cynq/status.hpp>
 #include <cynq/xrt/datamover.hpp>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace cynq {
+/**
+ * @brief Transfers in flight of one direction
+ */
+struct XRTTransferQueue {
+  /** Waits for each transfer and returns its status, oldest first */
+  std::deque<std::function<Status()>> transfers;
+  /** First error of the transfers waited before the next Sync() */
+  Status error;
+  /** Guards the queue. It is not held while waiting */
+  std::mutex mutex;
+};
+
 /**
  * @brief Define the specialisation of the data mover with the XRT engine
  * and XRT
  */
 struct XRTDataMoverParameters : public DataMoverParameters {
+  /** Pool of buffer objects shared with the memories */
+  std::shared_ptr<XRTBufferPool> pool_;
+  /** Transfers in flight: uploads (0) and downloads (1) */
+  XRTTransferQueue queues_[2];
+  /** Workers of the transfers when XRT cannot synchronise the buffer
+      objects asynchronously. Created on the first asynchronous transfer */
+  std::shared_ptr<IExecutionGraph> workers_;
+  /** Guards the creation of the workers */
+  std::mutex workers_mutex_;
   /** Virtual destructor required for the inheritance */
   virtual ~XRTDataMoverParameters() = default;
 };
@@ -34,59 +63,256 @@ XRTDataMover::XRTDataMover(const uint64_t /* addr */,
   auto params =
       dynamic_cast<XRTDataMoverParameters *>(data_mover_params_.get());
   params->hw_params_ = hwparams;
+
+  /* The pool is shared by the data movers of the hardware, so the memory
+     accounting covers all of them */
+  auto hw_params = dynamic_cast<AlveoParameters *>(hwparams.get());
+  params->pool_ = hw_params ? hw_params->pool_
+                            : std::make_shared<XRTBufferPool>();
 }
 
 std::shared_ptr<IMemory> XRTDataMover::GetBuffer(const size_t size,
                                                  const int memory_bank,
                                                  const MemoryType type) {
-  const xrt::memory_group group = (xrt::memory_group)(memory_bank);
+  std::shared_ptr<IMemory> mem;
+  Status st = this->AllocateBuffer(size, mem, memory_bank, type);
+  if (st.code != Status::OK) {
+    throw std::runtime_error(st.msg);
+  }
+  return mem;
+}
+
+Status XRTDataMover::AllocateBuffer(const size_t size,
+                                    std::shared_ptr<IMemory> &mem,
+                                    const int memory_bank,
+                                    const MemoryType type) {
+  mem = nullptr;
 
   /* The assumption is that at this point, it is ok */
   auto hw_params_ =
       dynamic_cast<AlveoParameters *>(data_mover_params_->hw_params_.get());
   if (!hw_params_) {
-    throw std::runtime_error("Hardware params are incompatible");
-  }
-
-  xrt::bo::flags flags;
-  switch (type) {
-    case MemoryType::Cacheable:
-      flags = xrt::bo::flags::cacheable;
-      break;
-    case MemoryType::Device:
-      flags = xrt::bo::flags::device_only;
-      break;
-    case MemoryType::Host:
-      flags = xrt::bo::flags::host_only;
-      break;
-    default:
-      flags = xrt::bo::flags::normal;
-      break;
-  }
-
-  /* Create the buffer object and encapsulate it into the meta. The meta is FULL
-   * TRANSFER */
-  auto buffer_object =
-      std::make_shared<xrt::bo>(hw_params_->device_, size, flags, group);
+    return Status{Status::INCOMPATIBLE_PARAMETER,
+                  "Hardware params are incompatible"};
+  }
+
+  auto params =
+      dynamic_cast<XRTDataMoverParameters *>(data_mover_params_.get());
+
+  /* Get the buffer object from the pool and encapsulate it into the meta.
+   * The meta is FULL TRANSFER. The buffer returns to the pool once the memory
+   * is released */
+  std::shared_ptr<xrt::bo> buffer_object;
+  Status st = params->pool_->Acquire(hw_params_->device_, size, memory_bank,
+                                     type, buffer_object);
+  if (st.code != Status::OK) {
+    return st;
+  }
   XRTDataMoverMeta *meta = new XRTDataMoverMeta;
   meta->bo_ = buffer_object;
   meta->type_ = type;
+  meta->bank_ = memory_bank;
+  meta->pool_ = params->pool_;
+
+  mem = IMemory::Create(IMemory::XRT, size, nullptr, nullptr,
+                        reinterpret_cast<void *>(meta));
+  return Status{};
+}
+
+Status XRTDataMover::ImportBuffer(void *ptr, const size_t size,
+                                std::shared_ptr<IMemory> &mem,
+                                const int memory_bank) {
+  mem = nullptr;
+
+  if (!ptr || 0 == size) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The allocation is null or has zero size"};
+  }
+  if (reinterpret_cast<uintptr_t>(ptr) % ImportAlignment() != 0) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The allocation is not aligned to the page size"};
+  }
+
+  /* The assumption is that at this point, it is ok */
+  auto hw_params_ = dynamic_cast<AlveoParameters *>(
+      data_mover_params_->hw_params_.get());
+  if (!hw_params_) {
+    return Status{Status::INCOMPATIBLE_PARAMETER,
+                  "Hardware params are incompatible"};
+  }
+
+  /* Wrap the allocation into a user-pointer buffer object. It is not
+   * returned to the pool since the allocation belongs to the caller */
+  std::shared_ptr<xrt::bo> buffer_object;
+  try {
+    buffer_object = std::make_shared<xrt::bo>(
+        hw_params_->device_, ptr, size, (xrt::memory_group)(memory_bank));
+  } catch (const std::exception &e) {
+    return Status{Status::CONFIGURATION_ERROR,
+                  std::string("Cannot import the allocation: ") + e.what()};
+  }
+
+  XRTDataMoverMeta *meta = new XRTDataMoverMeta;
+  meta->bo_ = buffer_object;
+  meta->type_ = MemoryType::Dual;
+  meta->bank_ = memory_bank;
 
-  return IMemory::Create(IMemory::XRT, size, nullptr, nullptr,
-                         reinterpret_cast<void *>(meta));
+  mem = IMemory::Create(IMemory::XRT, size, nullptr, nullptr,
+                        reinterpret_cast<void *>(meta));
+  return Status{};
 }
 
 DeviceStatus XRTDataMover::GetStatus() { return DeviceStatus::Idle; }
 
-XRTDataMover::~XRTDataMover() {}
+Status XRTDataMover::GetBufferPoolStatistics(BufferPoolStatistics &stats) {
+  auto params =
+      dynamic_cast<XRTDataMoverParameters *>(data_mover_params_.get());
+  params->pool_->GetStatistics(stats);
+  return Status{};
+}
+
+Status XRTDataMover::SetBufferPoolLimit(const size_t bytes) {
+  auto params =
+      dynamic_cast<XRTDataMoverParameters *>(data_mover_params_.get());
+  params->pool_->SetLimit(bytes);
+  return Status{};
+}
+
+Status XRTDataMover::TrimBufferPool(const size_t bytes) {
+  auto params =
+      dynamic_cast<XRTDataMoverParameters *>(data_mover_params_.get());
+  params->pool_->Trim(bytes);
+  return Status{};
+}
+
+Status XRTDataMover::GetMemoryStatistics(
+    std::vector<MemoryBankStatistics> &stats) {
+  auto params =
+      dynamic_cast<XRTDataMoverParameters *>(data_mover_params_.get());
+  params->pool_->GetBankStatistics(stats);
+  return Status{};
+}
+
+Status XRTDataMover::SetMemoryBudget(const int memory_bank,
+                                     const size_t bytes) {
+  auto params =
+      dynamic_cast<XRTDataMoverParameters *>(data_mover_params_.get());
+  params->pool_->SetBudget(memory_bank, bytes);
+  return Status{};
+}
+
+Status XRTDataMover::SetHostMemoryOptions(const HostMemoryOptions &options) {
+  if (options.page_size != HostMemoryOptions::kDefaultPage &&
+      options.page_size != HostMemoryOptions::kHugePage2M &&
+      options.page_size != HostMemoryOptions::kHugePage1G) {
+    return Status{Status::INVALID_PARAMETER, "Unsupported page size"};
+  }
+  if (options.numa_node >= XRTBufferPool::kMaxNumaNodes) {
+    return Status{Status::INVALID_PARAMETER, "Invalid NUMA node"};
+  }
+
+  auto params =
+      dynamic_cast<XRTDataMoverParameters *>(data_mover_params_.get());
+  params->pool_->SetHostOptions(options);
+  return Status{};
+}
+
+XRTDataMover::~XRTDataMover() {
+  /* The transfers in flight refer to the workers and the buffer objects */
+  this->Sync(SyncType::HostToDevice);
+  this->Sync(SyncType::DeviceToHost);
+}
+
+/* Synchronises a buffer object, turning the XRT exceptions into a status */
+static Status SyncBufferObject(xrt::bo &bo, const xclBOSyncDirection dir,
+                               const size_t size, const size_t offset) {
+  try {
+    bo.sync(dir, size, offset);
+  } catch (const std::exception &e) {
+    return Status{Status::EXECUTION_FAILED,
+                  std::string("Cannot synchronise the buffer: ") + e.what()};
+  }
+  return Status{};
+}
+
+/* Starts the synchronisation of a buffer object and returns the function
+   that waits for it. The function keeps the memory alive, so its buffer
+   object does not return to the pool while it is in flight */
+static std::function<Status()> StartTransfer(
+    XRTDataMoverParameters *params, std::shared_ptr<IMemory> mem,
+    std::shared_ptr<xrt::bo> bo, const xclBOSyncDirection dir,
+    const size_t size, const size_t offset) {
+#ifdef CYNQ_XRT_ASYNC_BO
+  /* XRT runs the synchronisation by itself */
+  (void)params;
+  try {
+    xrt::bo::async_handle handle = bo->async(dir, size, offset);
+    return [mem, bo, handle]() mutable -> Status {
+      try {
+        handle.wait();
+      } catch (const std::exception &e) {
+        return Status{Status::EXECUTION_FAILED,
+                      std::string("Cannot synchronise the buffer: ") +
+                          e.what()};
+      }
+      return Status{};
+    };
+  } catch (const std::exception &e) {
+    Status st{Status::EXECUTION_FAILED,
+              std::string("Cannot start the synchronisation: ") + e.what()};
+    return [st]() { return st; };
+  }
+#else
+  /* Run the blocking synchronisation in a bounded set of workers. The nodes
+     have no dependencies, so they run concurrently */
+  {
+    std::lock_guard<std::mutex> lock{params->workers_mutex_};
+    if (!params->workers_) {
+      auto graph_params = std::make_shared<ExecutionGraphParameters>();
+      graph_params->name = "XRTDataMover";
+      graph_params->workers = XRTDataMover::kMaxTransfersInFlight;
+      params->workers_ =
+          IExecutionGraph::Create(IExecutionGraph::Type::GRAPH, graph_params);
+    }
+  }
+  IExecutionGraph::Function transfer = [bo, dir, size, offset]() {
+    return SyncBufferObject(*bo, dir, size, offset);
+  };
+  ExecutionFuture future = ExecutionFuture::Submit(params->workers_, transfer);
+  return [mem, future]() { return future.Get(); };
+#endif
+}
 
-/* TODO: All implementations below can be implemented cleverly. However, it
-   was out from the scope of this release. In next releases, we can have a
-   concept similar to work streams or queues */
+/* Queues an asynchronous transfer. If the direction is full, it waits for
+   the oldest transfer first, so the transfers in flight are bounded */
+static Status EnqueueTransfer(XRTDataMoverParameters *params,
+                              const SyncType type,
+                              std::shared_ptr<IMemory> mem,
+                              std::shared_ptr<xrt::bo> bo,
+                              const xclBOSyncDirection dir, const size_t size,
+                              const size_t offset) {
+  XRTTransferQueue &queue =
+      params->queues_[SyncType::HostToDevice == type ? 0 : 1];
+
+  std::unique_lock<std::mutex> lock{queue.mutex};
+  while (queue.transfers.size() >= XRTDataMover::kMaxTransfersInFlight) {
+    std::function<Status()> oldest = std::move(queue.transfers.front());
+    queue.transfers.pop_front();
+    lock.unlock();
+    Status st = oldest();
+    lock.lock();
+    /* Reported by the next Sync() */
+    if (Status::OK != st.code && Status::OK == queue.error.code) {
+      queue.error = st;
+    }
+  }
+  queue.transfers.push_back(StartTransfer(params, mem, bo, dir, size, offset));
+  return Status{};
+}
 
 Status XRTDataMover::Upload(const std::shared_ptr<IMemory> mem,
                             const size_t size, const size_t offset,
-                            const ExecutionType /* exetype */) {
+                            const ExecutionType exetype) {
   /* Get device pointer */
   if (!mem) {
     return Status{Status::INVALID_PARAMETER, "Memory pointer is null"};
@@ -101,16 +327,24 @@ Status XRTDataMover::Upload(const std::shared_ptr<IMemory> mem,
   }
 
   auto meta = (XRTDataMoverMeta *)(xrtmem->mover_ptr_);  // NOLINT
-  if (meta) {
-    meta->bo_->sync(XCL_BO_SYNC_BO_TO_DEVICE, size, offset);
+  if (!meta) {
+    return Status{};
   }
 
-  return Status{};
+  if (ExecutionType::Sync == exetype) {
+    return SyncBufferObject(*meta->bo_, XCL_BO_SYNC_BO_TO_DEVICE, size,
+                            offset);
+  }
+
+  auto params =
+      dynamic_cast<XRTDataMoverParameters *>(data_mover_params_.get());
+  return EnqueueTransfer(params, SyncType::HostToDevice, mem, meta->bo_,
+                         XCL_BO_SYNC_BO_TO_DEVICE, size, offset);
 }
 
 Status XRTDataMover::Download(const std::shared_ptr<IMemory> mem,
                               const size_t size, const size_t offset,
-                              const ExecutionType /* exetype */) {
+                              const ExecutionType exetype) {
   /* Get device pointer */
   if (!mem) {
     return Status{Status::INVALID_PARAMETER, "Memory pointer is null"};
@@ -125,17 +359,43 @@ Status XRTDataMover::Download(const std::shared_ptr<IMemory> mem,
   }
 
   auto meta = (XRTDataMoverMeta *)(xrtmem->mover_ptr_);  // NOLINT
-  if (meta) {
-    meta->bo_->sync(XCL_BO_SYNC_BO_FROM_DEVICE, size, offset);
+  if (!meta) {
+    return Status{};
   }
 
-  return Status{};
+  if (ExecutionType::Sync == exetype) {
+    return SyncBufferObject(*meta->bo_, XCL_BO_SYNC_BO_FROM_DEVICE, size,
+                            offset);
+  }
+
+  auto params =
+      dynamic_cast<XRTDataMoverParameters *>(data_mover_params_.get());
+  return EnqueueTransfer(params, SyncType::DeviceToHost, mem, meta->bo_,
+                         XCL_BO_SYNC_BO_FROM_DEVICE, size, offset);
 }
 
-Status XRTDataMover::Sync(const SyncType /* type */) {
-  /* TODO: not implemented. We must find a way to synchronise in another
-     fashion. An idea is to launch std::async jobs and wait until its
-     synchronisation */
-  return Status{};
+Status XRTDataMover::Sync(const SyncType type) {
+  auto params =
+      dynamic_cast<XRTDataMoverParameters *>(data_mover_params_.get());
+  XRTTransferQueue &queue =
+      params->queues_[SyncType::HostToDevice == type ? 0 : 1];
+
+  /* Only the transfers of the direction issued so far are waited. The
+     queue is released, so new transfers can be issued meanwhile */
+  std::deque<std::function<Status()>> transfers;
+  Status st{};
+  {
+    std::lock_guard<std::mutex> lock{queue.mutex};
+    transfers.swap(queue.transfers);
+    std::swap(st, queue.error);
+  }
+
+  for (auto &transfer : transfers) {
+    Status transfer_st = transfer();
+    if (Status::OK == st.code) {
+      st = transfer_st;
+    }
+  }
+  return st;
 }
 }  // namespace cynq
@@ -10,7 +10,11 @@
 
 #include <xrt/xrt_bo.h>
 
+#include <algorithm>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+#include <vector>
 
 #include "cynq/dma/datamover.hpp"
 #include "cynq/enums.hpp"
@@ -20,13 +24,64 @@
 namespace cynq {
 XRTMemory::XRTMemory(const std::size_t size, uint8_t *hostptr, uint8_t *devptr,
                      void *moverptr)
-    : size_{size}, host_ptr_{hostptr}, dev_ptr_{devptr}, mover_ptr_{moverptr} {}
+    : size_{size}, host_ptr_{hostptr}, dev_ptr_{devptr}, mover_ptr_{moverptr} {
+  if (!mover_ptr_) {
+    return;
+  }
+
+  /* The addresses of the buffer object are cached, so getting them does not
+     go through XRT each time */
+  auto meta = reinterpret_cast<DMADataMoverMeta *>(mover_ptr_);
+  if (!meta->bo_) {
+    host_ptr_ = nullptr;
+    dev_ptr_ = nullptr;
+    return;
+  }
+
+  host_ptr_ = meta->type_ == MemoryType::Device ? nullptr
+                                                : meta->bo_->map<uint8_t *>();
+  dev_ptr_ = meta->type_ == MemoryType::Host
+                 ? nullptr
+                 : reinterpret_cast<uint8_t *>(meta->bo_->address());
+}
+
+/** Granularity of the dirty regions */
+static constexpr size_t kCacheLine = 64;
+/** Maximum number of dirty regions before merging all of them */
+static constexpr size_t kMaxDirtyRegions = 32;
 
 Status XRTMemory::Sync(const SyncType type) {
+  if (!dirty_tracking_ || type != SyncType::HostToDevice) {
+    return this->Sync(type, size_, 0);
+  }
+
+  /* Flush only the dirty regions */
+  std::vector<std::pair<size_t, size_t>> regions;
+  {
+    std::scoped_lock<std::mutex> lk(dirty_mutex_);
+    regions.swap(dirty_);
+  }
+
+  for (const auto &region : regions) {
+    Status st = this->Sync(type, region.second - region.first, region.first);
+    if (st.code != Status::OK) {
+      return st;
+    }
+  }
+  return Status{};
+}
+
+Status XRTMemory::Sync(const SyncType type, const size_t size,
+                       const size_t offset) {
   if (!mover_ptr_) {
     return Status{Status::NOT_IMPLEMENTED, "Don't know how to synchronise"};
   }
 
+  if (offset > size_ || size > size_ - offset) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The offset and size exceeds the memory size"};
+  }
+
   /* Determine the direction */
   auto meta = reinterpret_cast<DMADataMoverMeta *>(mover_ptr_);
   xclBOSyncDirection dir = type == SyncType::HostToDevice
@@ -37,61 +92,129 @@ Status XRTMemory::Sync(const SyncType type) {
     return Status{Status::MEMBER_ABSENT, "Cannot find a valid BO"};
   }
 
-  /* Synchronise */
-  meta->bo_->sync(dir);
+  if (0 == size) {
+    return Status{};
+  }
+
+  /* Synchronise only the region. The buffer object can be larger than the
+     memory since it comes from a size class of the pool */
+  meta->bo_->sync(dir, size, offset);
 
   return Status{};
 }
 
-size_t XRTMemory::Size() { return size_; }
+Status XRTMemory::SetDirtyTracking(const bool enable) {
+  std::scoped_lock<std::mutex> lk(dirty_mutex_);
+  dirty_tracking_ = enable;
+  dirty_.clear();
+  return Status{};
+}
 
-std::shared_ptr<uint8_t> XRTMemory::GetHostAddress() {
-  /* Relevant: the returning shared pointer has no deleter since it is not
-   * transfer full */
-  if (!mover_ptr_) {
-    return std::shared_ptr<uint8_t>(host_ptr_, [](uint8_t *) {});
-  } else {
-    auto meta = reinterpret_cast<DMADataMoverMeta *>(mover_ptr_);
+Status XRTMemory::MarkDirty(const size_t offset, const size_t size) {
+  if (offset > size_ || size > size_ - offset) {
+    return Status{Status::INVALID_PARAMETER,
+                  "The offset and size exceeds the memory size"};
+  }
 
-    if (meta->type_ == MemoryType::Device) {
-      return nullptr;
-    }
+  std::scoped_lock<std::mutex> lk(dirty_mutex_);
+  if (!dirty_tracking_ || 0 == size) {
+    return Status{};
+  }
+
+  /* Extend the region to whole cache lines */
+  size_t begin = offset & ~(kCacheLine - 1);
+  size_t end = std::min(size_, (offset + size + kCacheLine - 1) &
+                                   ~(kCacheLine - 1));
+
+  /* Merge with the overlapping and adjacent regions */
+  auto it = std::lower_bound(
+      dirty_.begin(), dirty_.end(), begin,
+      [](const std::pair<size_t, size_t> &region, const size_t value) {
+        return region.second < value;
+      });
+  auto last = it;
+  while (last != dirty_.end() && last->first <= end) {
+    begin = std::min(begin, last->first);
+    end = std::max(end, last->second);
+    ++last;
+  }
+  it = dirty_.erase(it, last);
+  dirty_.insert(it, {begin, end});
+
+  /* Bound the cost of the synchronisation calls */
+  if (dirty_.size() > kMaxDirtyRegions) {
+    const std::pair<size_t, size_t> all{dirty_.front().first,
+                                        dirty_.back().second};
+    dirty_.clear();
+    dirty_.push_back(all);
+  }
+  return Status{};
+}
 
-    if (!meta->bo_) {
+size_t XRTMemory::Size() { return size_; }
+
+std::shared_ptr<IMemory> XRTMemory::Slice(const size_t offset,
+                                          const size_t size) {
+  if (0 == size || offset > size_ || size > size_ - offset) {
+    return nullptr;
+  }
+
+  /* The views refer to the memory that owns the allocation, so the views of
+     a view do not nest sub-buffers */
+  std::shared_ptr<XRTMemory> root = parent_ ? parent_ : shared_from_this();
+  const size_t root_offset = offset_ + offset;
+  std::shared_ptr<XRTMemory> view;
+
+  if (!root->mover_ptr_) {
+    uint8_t *hostptr =
+        root->host_ptr_ ? root->host_ptr_ + root_offset : nullptr;
+    uint8_t *devptr = root->dev_ptr_ ? root->dev_ptr_ + root_offset : nullptr;
+    view = std::make_shared<XRTMemory>(size, hostptr, devptr, nullptr);
+  } else {
+    auto root_meta = reinterpret_cast<DMADataMoverMeta *>(root->mover_ptr_);
+    if (!root_meta->bo_) {
       return nullptr;
     }
 
-    return std::shared_ptr<uint8_t>(meta->bo_->map<uint8_t *>(),
-                                    [](uint8_t *) {});
+    /* The sub-buffer shares the allocation. It is not returned to the pool
+       since the allocation belongs to the root */
+    DMADataMoverMeta *meta = new DMADataMoverMeta;
+    meta->bo_ = std::make_shared<xrt::bo>(*root_meta->bo_, size, root_offset);
+    meta->type_ = root_meta->type_;
+    meta->bank_ = root_meta->bank_;
+    view = std::make_shared<XRTMemory>(size, nullptr, nullptr,
+                                       reinterpret_cast<void *>(meta));
   }
+
+  view->parent_ = root;
+  view->offset_ = root_offset;
+  return view;
 }
 
-std::shared_ptr<uint8_t> XRTMemory::GetDeviceAddress() {
+std::shared_ptr<uint8_t> XRTMemory::GetHostAddress() {
   /* Relevant: the returning shared pointer has no deleter since it is not
    * transfer full */
-  if (!mover_ptr_) {
-    return std::shared_ptr<uint8_t>(dev_ptr_, [](uint8_t *) {});
-  } else {
-    auto meta = reinterpret_cast<DMADataMoverMeta *>(mover_ptr_);
+  return std::shared_ptr<uint8_t>(host_ptr_, [](uint8_t *) {});
+}
 
-    if (meta->type_ == MemoryType::Host) {
-      return nullptr;
-    }
+std::shared_ptr<uint8_t> XRTMemory::GetDeviceAddress() {
+  /* Relevant: the returning shared pointer has no deleter since it is not
+   * transfer full */
+  return std::shared_ptr<uint8_t>(dev_ptr_, [](uint8_t *) {});
+}
 
-    if (!meta->bo_) {
-      return nullptr;
-    }
+uint8_t *XRTMemory::GetHostPointer() { return host_ptr_; }
 
-    /* Construct the pointer */
-    uint64_t addr = meta->bo_->address();
-    uint8_t *ptr = reinterpret_cast<uint8_t *>(addr);
-    return std::shared_ptr<uint8_t>(ptr, [](uint8_t *) {});
-  }
-}
+uint8_t *XRTMemory::GetDevicePointer() { return dev_ptr_; }
 
 XRTMemory::~XRTMemory() {
   if (mover_ptr_) {
     auto meta = reinterpret_cast<DMADataMoverMeta *>(mover_ptr_);
+    /* Return the buffer object to the pool of the data mover */
+    if (meta->pool_) {
+      meta->pool_->Release(std::move(meta->bo_), size_, meta->bank_,
+                           meta->type_);
+    }
     delete meta;
   }
 }
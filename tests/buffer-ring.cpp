@@ -0,0 +1,100 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cynq/buffer-ring.hpp>
+#include <cynq/execution-graph.hpp>
+#include <memory>
+#include <vector>
+
+using namespace cynq;  // NOLINT
+
+/* Ring without buffers: the tests only exercise the slot life cycle */
+static std::shared_ptr<BufferRing> CreateRing(
+    std::shared_ptr<IExecutionGraph> graph, const size_t slots) {
+  std::vector<std::vector<std::shared_ptr<IMemory>>> buffers(slots);
+  return std::make_shared<BufferRing>(graph, buffers);
+}
+
+TEST(BufferRing, SynchronousStages) {
+  auto ring = CreateRing(nullptr, 2);
+  EXPECT_EQ(2u, ring->Slots());
+  EXPECT_EQ(nullptr, ring->AcquireRead(false));
+
+  BufferRingSlot *slot = ring->AcquireWrite();
+  ASSERT_NE(nullptr, slot);
+  Status st = ring->Submit(slot, [](BufferRingSlot &) { return Status{}; });
+  EXPECT_EQ(Status::OK, st.code);
+
+  BufferRingSlot *read = ring->AcquireRead();
+  ASSERT_EQ(slot, read);
+  EXPECT_EQ(0u, read->sequence);
+  EXPECT_EQ(Status::OK, ring->Release(read).code);
+}
+
+TEST(BufferRing, SlotsAreReadInSubmissionOrder) {
+  auto params = std::make_shared<ExecutionGraphParameters>();
+  auto graph = IExecutionGraph::Create(IExecutionGraph::Type::STREAM, params);
+  auto ring = CreateRing(graph, 3);
+
+  for (int frame = 0; frame < 30; ++frame) {
+    BufferRingSlot *slot = ring->AcquireWrite();
+    ASSERT_NE(nullptr, slot);
+    ASSERT_EQ(Status::OK,
+              ring->Submit(slot, [frame](BufferRingSlot &) {
+                    return frame % 7 == 6
+                               ? Status{Status::EXECUTION_FAILED, "Frame"}
+                               : Status{};
+                  }).code);
+
+    /* Keep up to two frames in flight */
+    if (frame >= 1) {
+      BufferRingSlot *read = ring->AcquireRead();
+      ASSERT_NE(nullptr, read);
+      const int expected = frame - 1;
+      EXPECT_EQ(static_cast<uint64_t>(expected), read->sequence);
+      EXPECT_EQ(expected % 7 == 6 ? Status::EXECUTION_FAILED : Status::OK,
+                read->result.code);
+      EXPECT_EQ(Status::OK, ring->Release(read).code);
+    }
+  }
+
+  BufferRingSlot *last = ring->AcquireRead();
+  ASSERT_NE(nullptr, last);
+  EXPECT_EQ(29u, last->sequence);
+  ring->Release(last);
+  EXPECT_EQ(nullptr, ring->AcquireRead());
+}
+
+TEST(BufferRing, RejectsSlotsNotOwned) {
+  auto ring = CreateRing(nullptr, 2);
+  BufferRingSlot *slot = ring->AcquireWrite();
+  ASSERT_NE(nullptr, slot);
+
+  /* The producer owns the slot: it cannot be released yet */
+  EXPECT_EQ(Status::INVALID_PARAMETER, ring->Release(slot).code);
+  EXPECT_EQ(Status::INVALID_PARAMETER,
+            ring->Submit(nullptr, [](BufferRingSlot &) { return Status{}; })
+                .code);
+
+  ring->Submit(slot, [](BufferRingSlot &) { return Status{}; });
+  EXPECT_EQ(Status::INVALID_PARAMETER,
+            ring->Submit(slot, [](BufferRingSlot &) { return Status{}; })
+                .code);
+}
+
+TEST(BufferRing, AcquireWriteWithoutWaiting) {
+  auto ring = CreateRing(nullptr, 1);
+  BufferRingSlot *slot = ring->AcquireWrite(false);
+  ASSERT_NE(nullptr, slot);
+  EXPECT_EQ(nullptr, ring->AcquireWrite(false));
+
+  ring->Submit(slot, [](BufferRingSlot &) { return Status{}; });
+  ring->Release(ring->AcquireRead());
+  EXPECT_NE(nullptr, ring->AcquireWrite(false));
+}
@@ -0,0 +1,137 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cynq/dma/descriptor-ring.hpp>
+#include <vector>
+
+using namespace cynq;  // NOLINT
+
+/* Words of a descriptor (PG021) */
+static constexpr size_t kWords =
+    DMADescriptorRing::kDescriptorSize / sizeof(uint32_t);
+static constexpr size_t kNextDescriptor = 0;
+static constexpr size_t kBufferAddress = 2;
+static constexpr size_t kControl = 6;
+static constexpr size_t kStatus = 7;
+static constexpr uint64_t kDevice = 0x10000000;
+
+/* Descriptor memory of the tests, filled by the ring */
+class DMADescriptorRingTest : public ::testing::Test {
+ protected:
+  static constexpr size_t kDescriptors = 4;
+
+  DMADescriptorRingTest()
+      : memory_(kDescriptors * kWords, 0xFFFFFFFF),
+        ring_{reinterpret_cast<uint8_t *>(memory_.data()), kDevice,
+              kDescriptors} {}
+
+  uint32_t *Descriptor(const size_t index) {
+    return memory_.data() + index * kWords;
+  }
+
+  /* Emulates the engine completing a descriptor */
+  void Complete(const size_t index, const uint32_t errors = 0) {
+    Descriptor(index)[kStatus] = (1u << 31) | errors;
+  }
+
+  std::vector<uint32_t> memory_;
+  DMADescriptorRing ring_;
+};
+
+TEST_F(DMADescriptorRingTest, ChainsTheDescriptors) {
+  EXPECT_EQ(kDescriptors, ring_.Capacity());
+  EXPECT_EQ(0u, ring_.Pending());
+  EXPECT_EQ(kDescriptors, ring_.Available());
+  EXPECT_EQ(kDevice, ring_.Head());
+
+  for (size_t i = 0; i < kDescriptors; ++i) {
+    const uint64_t next =
+        kDevice + ((i + 1) % kDescriptors) * DMADescriptorRing::kDescriptorSize;
+    EXPECT_EQ(static_cast<uint32_t>(next), Descriptor(i)[kNextDescriptor]);
+    EXPECT_EQ(0u, Descriptor(i)[kStatus]);
+  }
+}
+
+TEST_F(DMADescriptorRingTest, PushFillsTheDescriptor) {
+  TransferSegment segment{};
+  ASSERT_EQ(Status::OK,
+            ring_.Push(0x2000, 256, true, false, segment).code);
+  EXPECT_EQ(0x2000u, Descriptor(0)[kBufferAddress]);
+  EXPECT_EQ(256u | (1u << 27), Descriptor(0)[kControl]);
+  EXPECT_EQ(1u, ring_.Pending());
+  EXPECT_EQ(kDevice, ring_.Tail());
+
+  ASSERT_EQ(Status::OK, ring_.Push(0x3000, 64, false, true, segment).code);
+  EXPECT_EQ(64u | (1u << 26), Descriptor(1)[kControl]);
+  EXPECT_EQ(kDevice + DMADescriptorRing::kDescriptorSize, ring_.Tail());
+}
+
+TEST_F(DMADescriptorRingTest, RejectsInvalidPushes) {
+  TransferSegment segment{};
+  EXPECT_EQ(Status::INVALID_PARAMETER,
+            ring_.Push(0x2000, 0, true, true, segment).code);
+  EXPECT_EQ(Status::INVALID_PARAMETER,
+            ring_.Push(0x2000, 1ul << DMADescriptorRing::kMaxLengthWidth,
+                       true, true, segment)
+                .code);
+
+  for (size_t i = 0; i < kDescriptors; ++i) {
+    ASSERT_EQ(Status::OK, ring_.Push(0x2000, 16, true, true, segment).code);
+  }
+  EXPECT_EQ(0u, ring_.Available());
+  EXPECT_EQ(Status::INVALID_PARAMETER,
+            ring_.Push(0x2000, 16, true, true, segment).code);
+}
+
+TEST_F(DMADescriptorRingTest, ReapsInOrderAndWrapsAround) {
+  TransferSegment segment{};
+  std::vector<TransferSegment> reaped;
+
+  for (size_t round = 0; round < 3; ++round) {
+    const size_t head = (round * 3) % kDescriptors;
+    for (size_t i = 0; i < 3; ++i) {
+      ASSERT_EQ(Status::OK, ring_.Push(0x2000, 16, true, true, segment).code);
+    }
+
+    /* The descriptors after a pending one are not reaped */
+    Complete(head);
+    Complete((head + 2) % kDescriptors);
+    EXPECT_EQ(Status::OK, ring_.Reap(reaped).code);
+    EXPECT_EQ(2u, ring_.Pending());
+
+    Complete((head + 1) % kDescriptors);
+    EXPECT_EQ(Status::OK, ring_.Reap(reaped).code);
+    EXPECT_EQ(0u, ring_.Pending());
+    EXPECT_EQ(kDevice + ((head + 3) % kDescriptors) *
+                            DMADescriptorRing::kDescriptorSize,
+              ring_.Head());
+  }
+
+  /* The segments without memory are not reported */
+  EXPECT_TRUE(reaped.empty());
+}
+
+TEST_F(DMADescriptorRingTest, ReportsEngineErrors) {
+  TransferSegment segment{};
+  ring_.Push(0x2000, 16, true, true, segment);
+  std::vector<TransferSegment> reaped;
+  Complete(0, 1u << 28);
+  EXPECT_EQ(Status::REGISTER_IO_ERROR, ring_.Reap(reaped).code);
+  EXPECT_EQ(0u, ring_.Pending());
+}
+
+TEST_F(DMADescriptorRingTest, ResetRewindsTheRing) {
+  TransferSegment segment{};
+  ring_.Push(0x2000, 16, true, true, segment);
+  ring_.Push(0x2000, 16, true, true, segment);
+  ring_.Reset();
+  EXPECT_EQ(0u, ring_.Pending());
+  EXPECT_EQ(kDevice, ring_.Head());
+}
@@ -0,0 +1,181 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cynq/execution-event.hpp>
+#include <cynq/execution-graph.hpp>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+using namespace cynq;  // NOLINT
+
+static std::shared_ptr<IExecutionGraph> CreateGraph(
+    const uint64_t workers, const uint64_t capacity = 1024) {
+  auto params = std::make_shared<ExecutionGraphParameters>();
+  params->workers = workers;
+  params->capacity = capacity;
+  return IExecutionGraph::Create(IExecutionGraph::Type::GRAPH, params);
+}
+
+TEST(ExecutionGraph, RespectsTheDependencies) {
+  auto graph = CreateGraph(4);
+  std::mutex mutex;
+  std::vector<int> order;
+  auto record = [&](const int value) -> IExecutionGraph::Function {
+    return [&, value]() -> Status {
+      std::this_thread::sleep_for(std::chrono::milliseconds(value));
+      std::scoped_lock<std::mutex> lk(mutex);
+      order.push_back(value);
+      return Status{};
+    };
+  };
+
+  /* Diamond: 30 -> (20, 10) -> 1 */
+  auto top = graph->Add(record(30));
+  auto left = graph->Add(record(20), {top});
+  auto right = graph->Add(record(10), {top});
+  auto bottom = graph->Add(record(1), {left, right});
+  ASSERT_GE(bottom, 0);
+  EXPECT_EQ(Status::OK, graph->Sync().code);
+
+  ASSERT_EQ(4u, order.size());
+  EXPECT_EQ(30, order.front());
+  EXPECT_EQ(1, order.back());
+}
+
+TEST(ExecutionGraph, RunsIndependentNodesConcurrently) {
+  auto graph = CreateGraph(2);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 2; ++i) {
+    graph->Add([]() -> Status {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+      return Status{};
+    });
+  }
+  graph->Sync();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_LT(elapsed, std::chrono::milliseconds(190));
+}
+
+TEST(ExecutionGraph, RejectsUnknownDependencies) {
+  auto graph = CreateGraph(1);
+  EXPECT_EQ(-1, graph->Add([]() { return Status{}; }, {5}));
+  EXPECT_EQ(-1, graph->Add([]() { return Status{}; }, {-2}));
+  EXPECT_EQ(Status::INVALID_PARAMETER, graph->Sync(10).code);
+}
+
+TEST(ExecutionGraph, KeepsTheLastError) {
+  auto graph = CreateGraph(1);
+  std::atomic<bool> child{false};
+  auto failing = graph->Add([]() {
+    return Status{Status::EXECUTION_FAILED, "Failure"};
+  });
+  graph->Add(
+      [&]() {
+        child = true;
+        return Status{};
+      },
+      {failing});
+  graph->Sync();
+  EXPECT_EQ(Status::EXECUTION_FAILED, graph->GetLastError().code);
+  EXPECT_TRUE(child);
+}
+
+TEST(ExecutionGraph, DoesNotBlockOnABusySlot) {
+  /* The first node waits for an event recorded by a later node. With two
+     slots, the record must take the slot released by the second node */
+  auto graph = CreateGraph(2, 2);
+  auto gate = ExecutionEvent::Create();
+  const uint64_t generation = gate->Arm();
+  graph->Add([gate, generation]() { return gate->Wait(generation); });
+  graph->Add([]() { return Status{}; });
+  graph->Add([]() { return Status{}; });
+  graph->Add([gate, generation]() {
+    gate->Signal(generation);
+    return Status{};
+  });
+  EXPECT_EQ(Status::OK, graph->Sync().code);
+}
+
+TEST(ExecutionGraph, LaunchKeepsTheCapturedParallelism) {
+  auto graph = CreateGraph(2);
+  auto event = ExecutionEvent::Create();
+  std::atomic<int> runs{0};
+  auto sleep = [&]() -> Status {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    runs++;
+    return Status{};
+  };
+
+  ASSERT_EQ(Status::OK, graph->BeginCapture().code);
+  auto a = graph->Add(sleep);
+  auto b = graph->Add(sleep);
+  graph->RecordEvent(event, {a, b});
+  auto exec = graph->EndCapture();
+  ASSERT_NE(nullptr, exec);
+  EXPECT_EQ(3u, exec->Size());
+  EXPECT_EQ(1u, exec->Events());
+
+  /* Each launch completes a new record of the event */
+  for (int i = 1; i <= 3; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_GE(graph->Launch(exec), 0);
+    EXPECT_EQ(Status::OK, event->Synchronize().code);
+    EXPECT_EQ(2 * i, runs.load());
+    EXPECT_LT(std::chrono::steady_clock::now() - start,
+              std::chrono::milliseconds(190));
+  }
+
+  /* The launch holds the captured graph */
+  graph->Launch(exec);
+  exec.reset();
+  EXPECT_EQ(Status::OK, graph->Sync().code);
+  EXPECT_EQ(8, runs.load());
+}
+
+TEST(ExecutionGraph, UpdateRejectsEventNodes) {
+  auto graph = CreateGraph(1);
+  auto event = ExecutionEvent::Create();
+  graph->BeginCapture();
+  auto node = graph->Add([]() { return Status{}; });
+  auto record = graph->RecordEvent(event);
+  auto exec = graph->EndCapture();
+  ASSERT_NE(nullptr, exec);
+  EXPECT_EQ(Status::OK,
+            exec->Update(node, []() { return Status{}; }).code);
+  EXPECT_EQ(Status::INVALID_PARAMETER,
+            exec->Update(record, []() { return Status{}; }).code);
+  EXPECT_EQ(nullptr, graph->EndCapture());
+}
+
+TEST(ExecutionEvent, EachRecordKeepsItsOutcome) {
+  auto event = ExecutionEvent::Create();
+  const uint64_t first = event->Arm();
+  event->Signal(first);
+  const uint64_t second = event->Arm();
+  event->Abort(second);
+  const uint64_t third = event->Arm();
+  event->Signal(third);
+
+  EXPECT_EQ(Status::OK, event->Wait(first).code);
+  EXPECT_EQ(Status::EXECUTION_FAILED, event->Wait(second).code);
+  EXPECT_EQ(Status::OK, event->Wait(third).code);
+  EXPECT_EQ(Status::OK, event->Query().code);
+
+  /* Discarding a record also discards the earlier pending ones */
+  const uint64_t fourth = event->Arm();
+  const uint64_t fifth = event->Arm();
+  event->Abort(fifth);
+  EXPECT_EQ(Status::EXECUTION_FAILED, event->Wait(fourth).code);
+  EXPECT_EQ(Status::EXECUTION_FAILED, event->Query().code);
+  EXPECT_EQ(Status::OK, event->Wait(third).code);
+}
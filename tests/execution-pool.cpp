@@ -0,0 +1,192 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <condition_variable>  // NOLINT
+#include <cynq/execution-graph.hpp>
+#include <cynq/execution-pool.hpp>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+using namespace cynq;  // NOLINT
+
+/* Task that counts its runs and records the order */
+class CountingTask : public ExecutionPool::Task {
+ public:
+  CountingTask(const int id, const int priority, std::mutex &mutex,
+               std::vector<int> &order)
+      : id_{id}, priority_{priority}, mutex_{mutex}, order_{order} {}
+
+  void Run() override {
+    std::scoped_lock<std::mutex> lk(mutex_);
+    order_.push_back(id_);
+  }
+
+  int Priority() const override { return priority_; }
+
+ private:
+  int id_;
+  int priority_;
+  std::mutex &mutex_;
+  std::vector<int> &order_;
+};
+
+/* Task that blocks the worker until it is opened */
+class GateTask : public ExecutionPool::Task {
+ public:
+  void Run() override {
+    std::unique_lock<std::mutex> lk(mutex_);
+    running_ = true;
+    condition_.notify_all();
+    condition_.wait(lk, [&] { return open_; });
+  }
+
+  void WaitRunning() {
+    std::unique_lock<std::mutex> lk(mutex_);
+    condition_.wait(lk, [&] { return running_; });
+  }
+
+  void Open() {
+    std::scoped_lock<std::mutex> lk(mutex_);
+    open_ = true;
+    condition_.notify_all();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool running_ = false;
+  bool open_ = false;
+};
+
+TEST(ExecutionPool, RunsTheScheduledTasks) {
+  auto pool = ExecutionPool::Create(4);
+  EXPECT_EQ(4u, pool->Workers());
+
+  std::mutex mutex;
+  std::vector<int> order;
+  std::vector<std::unique_ptr<CountingTask>> tasks;
+  for (int i = 0; i < 100; ++i) {
+    tasks.push_back(std::make_unique<CountingTask>(i, 0, mutex, order));
+    pool->Schedule(tasks.back().get());
+  }
+
+  for (int retries = 0; retries < 1000; ++retries) {
+    {
+      std::scoped_lock<std::mutex> lk(mutex);
+      if (order.size() == tasks.size()) {
+        break;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::scoped_lock<std::mutex> lk(mutex);
+  EXPECT_EQ(tasks.size(), order.size());
+}
+
+TEST(ExecutionPool, HighPriorityTasksRunFirst) {
+  auto pool = ExecutionPool::Create(1);
+  GateTask gate;
+  pool->Schedule(&gate);
+  gate.WaitRunning();
+
+  /* The tasks are queued while the only worker is busy */
+  std::mutex mutex;
+  std::vector<int> order;
+  CountingTask low{0, 0, mutex, order};
+  CountingTask high{1, 1, mutex, order};
+  pool->Schedule(&low);
+  pool->Schedule(&high);
+  EXPECT_TRUE(pool->ShouldYield(0));
+  EXPECT_FALSE(pool->ShouldYield(1));
+  gate.Open();
+
+  for (int retries = 0; retries < 1000; ++retries) {
+    {
+      std::scoped_lock<std::mutex> lk(mutex);
+      if (order.size() == 2) {
+        break;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::scoped_lock<std::mutex> lk(mutex);
+  ASSERT_EQ(2u, order.size());
+  EXPECT_EQ(1, order[0]);
+  EXPECT_EQ(0, order[1]);
+}
+
+TEST(ExecutionPool, BackgroundTasksYieldToTheDefaultPriority) {
+  auto pool = ExecutionPool::Create(1);
+  GateTask gate;
+  pool->Schedule(&gate);
+  gate.WaitRunning();
+
+  std::mutex mutex;
+  std::vector<int> order;
+  CountingTask background{0, -1, mutex, order};
+  pool->Schedule(&background);
+  EXPECT_FALSE(pool->ShouldYield(-1));
+  EXPECT_FALSE(pool->ShouldYield(0));
+
+  CountingTask regular{1, 0, mutex, order};
+  pool->Schedule(&regular);
+  EXPECT_TRUE(pool->ShouldYield(-1));
+  EXPECT_FALSE(pool->ShouldYield(0));
+  gate.Open();
+
+  for (int retries = 0; retries < 1000; ++retries) {
+    {
+      std::scoped_lock<std::mutex> lk(mutex);
+      if (order.size() == 2) {
+        break;
+      }
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  std::scoped_lock<std::mutex> lk(mutex);
+  ASSERT_EQ(2u, order.size());
+  EXPECT_EQ(1, order[0]);
+  EXPECT_EQ(0, order[1]);
+}
+
+TEST(ExecutionPool, SharedStreamsKeepTheirOrder) {
+  auto params = std::make_shared<ExecutionGraphParameters>();
+  params->pool = ExecutionPool::Create(2);
+
+  constexpr int kStreams = 8;
+  constexpr int kNodes = 1000;
+  std::vector<std::shared_ptr<IExecutionGraph>> streams;
+  std::vector<std::vector<int>> results(kStreams);
+  for (int s = 0; s < kStreams; ++s) {
+    streams.push_back(IExecutionGraph::Create(
+        IExecutionGraph::Type::SHARED_STREAM, params));
+  }
+
+  for (int i = 0; i < kNodes; ++i) {
+    for (int s = 0; s < kStreams; ++s) {
+      std::vector<int> *result = &results[s];
+      streams[s]->Add([result, i]() {
+        result->push_back(i);
+        return Status{};
+      });
+    }
+  }
+
+  for (int s = 0; s < kStreams; ++s) {
+    EXPECT_EQ(Status::OK, streams[s]->Sync().code);
+    ASSERT_EQ(static_cast<size_t>(kNodes), results[s].size());
+    for (int i = 0; i < kNodes; ++i) {
+      EXPECT_EQ(i, results[s][i]);
+    }
+  }
+}
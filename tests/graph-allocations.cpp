@@ -0,0 +1,194 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cynq/enums.hpp>
+#include <cynq/execution-graph.hpp>
+#include <memory>
+#include <new>
+#include <vector>
+
+/*
+ * Checks the allocation-free enqueue path. It counts the heap allocations of
+ * the process by replacing the global operators new and delete and checks
+ * that, after warming up, adding nodes to the execution graphs does not
+ * allocate. The nodes capture the same kind of values as the asynchronous
+ * overloads of IMemory, IDataMover and IAccelerator (a shared pointer to the
+ * buffer, sizes, offsets and the type of synchronisation).
+ */
+
+using namespace cynq;  // NOLINT
+
+/* Number of heap allocations of the process */
+static std::atomic<uint64_t> allocations{0};
+
+/* Counts and performs an allocation. All the replaced operators allocate
+   through the C allocator, so every delete releases with free() */
+static void *CountedAlloc(std::size_t size, const std::size_t alignment) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  size = size == 0 ? 1 : size;
+  if (alignment <= alignof(std::max_align_t)) {
+    return std::malloc(size);
+  }
+  /* aligned_alloc() requires a multiple of the alignment */
+  size = (size + alignment - 1) / alignment * alignment;
+  return std::aligned_alloc(alignment, size);
+}
+
+/* Releases an allocation. It is not inlined into the delete operators:
+   otherwise, GCC pairs the free() with the new expressions of the caller
+   and reports a mismatched-new-delete */
+[[gnu::noinline]] static void CountedFree(void *ptr) noexcept {
+  std::free(ptr);
+}
+
+static void *CountedNew(const std::size_t size, const std::size_t alignment) {
+  void *ptr = CountedAlloc(size, alignment);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+/* Replacements of the whole set of global operators, so the allocations and
+   the releases always match */
+void *operator new(std::size_t size) {
+  return CountedNew(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t size) {
+  return CountedNew(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t align) {
+  return CountedNew(size, static_cast<std::size_t>(align));
+}
+
+void *operator new[](std::size_t size, std::align_val_t align) {
+  return CountedNew(size, static_cast<std::size_t>(align));
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAlloc(size, alignof(std::max_align_t));
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+  return CountedAlloc(size, alignof(std::max_align_t));
+}
+
+void *operator new(std::size_t size, std::align_val_t align,
+                   const std::nothrow_t &) noexcept {
+  return CountedAlloc(size, static_cast<std::size_t>(align));
+}
+
+void *operator new[](std::size_t size, std::align_val_t align,
+                     const std::nothrow_t &) noexcept {
+  return CountedAlloc(size, static_cast<std::size_t>(align));
+}
+
+void operator delete(void *ptr) noexcept { CountedFree(ptr); }
+
+void operator delete[](void *ptr) noexcept { CountedFree(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { CountedFree(ptr); }
+
+void operator delete[](void *ptr, std::size_t) noexcept { CountedFree(ptr); }
+
+void operator delete(void *ptr, std::align_val_t) noexcept { CountedFree(ptr); }
+
+void operator delete[](void *ptr, std::align_val_t) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t, std::align_val_t) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t &) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t,
+                     const std::nothrow_t &) noexcept {
+  CountedFree(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t,
+                       const std::nothrow_t &) noexcept {
+  CountedFree(ptr);
+}
+
+/* Mock of a buffer transfer: it captures like IMemory::Sync */
+struct MockBuffer {
+  std::vector<uint8_t> data;
+  uint64_t transfers = 0;
+};
+
+/* Adds a chain of nodes twice and returns the allocations done by Add() in
+   the second round */
+static uint64_t CountAllocations(const IExecutionGraph::Type type,
+                                 const int num_nodes) {
+  auto params = std::make_shared<ExecutionGraphParameters>();
+  params->capacity = 256;
+  params->workers = 2;
+  auto graph = IExecutionGraph::Create(type, params);
+  auto buffer = std::make_shared<MockBuffer>();
+  buffer->data.resize(4096);
+
+  const SyncType sync = SyncType::HostToDevice;
+  const size_t size = buffer->data.size();
+  const size_t offset = 0;
+  std::vector<IExecutionGraph::NodeID> deps(1);
+
+  auto enqueue = [&](const int nodes) -> uint64_t {
+    IExecutionGraph::NodeID last = -1;
+    const uint64_t before = allocations.load();
+    for (int i = 0; i < nodes; ++i) {
+      IExecutionGraph::Function func = [buffer, sync, size,
+                                        offset]() -> Status {
+        if (sync == SyncType::HostToDevice && size > offset) {
+          buffer->transfers++;
+        }
+        return Status{};
+      };
+      if (last < 0) {
+        last = graph->Add(func);
+      } else {
+        deps[0] = last;
+        last = graph->Add(func, deps);
+      }
+    }
+    const uint64_t count = allocations.load() - before;
+    graph->Sync();
+    return count;
+  };
+
+  /* Warm up: it fills the arena and the vectors of the nodes */
+  enqueue(num_nodes);
+  const uint64_t count = enqueue(num_nodes);
+  EXPECT_EQ(static_cast<uint64_t>(2 * num_nodes), buffer->transfers);
+  return count;
+}
+
+TEST(GraphAllocations, StreamEnqueueDoesNotAllocate) {
+  EXPECT_EQ(0u, CountAllocations(IExecutionGraph::Type::STREAM, 10000));
+}
+
+TEST(GraphAllocations, GraphEnqueueDoesNotAllocate) {
+  EXPECT_EQ(0u, CountAllocations(IExecutionGraph::Type::GRAPH, 10000));
+}
@@ -0,0 +1,93 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cynq/inline-function.hpp>
+#include <functional>
+#include <memory>
+#include <type_traits>
+
+using namespace cynq;  // NOLINT
+
+typedef InlineFunction<int(), 32> SmallFunction;
+
+TEST(InlineFunction, EmptyByDefault) {
+  SmallFunction func;
+  EXPECT_FALSE(func);
+  EXPECT_THROW(func(), std::bad_function_call);
+
+  SmallFunction null_func = nullptr;
+  EXPECT_FALSE(null_func);
+
+  int (*null_pointer)() = nullptr;
+  SmallFunction from_pointer = null_pointer;
+  EXPECT_FALSE(from_pointer);
+}
+
+TEST(InlineFunction, InvokesTheCallable) {
+  int value = 3;
+  SmallFunction func = [value]() { return value * 2; };
+  ASSERT_TRUE(func);
+  EXPECT_EQ(6, func());
+}
+
+TEST(InlineFunction, CopyAndMove) {
+  auto counter = std::make_shared<int>(0);
+  SmallFunction func = [counter]() { return ++(*counter); };
+  EXPECT_EQ(2, counter.use_count());
+
+  SmallFunction copy = func;
+  EXPECT_EQ(3, counter.use_count());
+  EXPECT_EQ(1, copy());
+  EXPECT_EQ(2, func());
+
+  SmallFunction moved = std::move(copy);
+  EXPECT_FALSE(copy);  // NOLINT
+  EXPECT_EQ(3, counter.use_count());
+  EXPECT_EQ(3, moved());
+
+  /* Releasing the functions releases the captured values */
+  func = nullptr;
+  moved = nullptr;
+  EXPECT_EQ(1, counter.use_count());
+}
+
+TEST(InlineFunction, ReassignReleasesThePreviousCallable) {
+  auto first = std::make_shared<int>(1);
+  auto second = std::make_shared<int>(2);
+  SmallFunction func = [first]() { return *first; };
+  func = [second]() { return *second; };
+  EXPECT_EQ(1, first.use_count());
+  EXPECT_EQ(2, func());
+}
+
+TEST(InlineFunction, FromStdFunction) {
+  std::function<int()> std_func = []() { return 7; };
+  SmallFunction func = std_func;
+  EXPECT_EQ(7, func());
+}
+
+TEST(InlineFunction, MovesDoNotThrow) {
+  EXPECT_TRUE(std::is_nothrow_move_constructible_v<SmallFunction>);
+  EXPECT_TRUE(std::is_nothrow_move_assignable_v<SmallFunction>);
+}
+
+TEST(InlineFunction, AllocatedCallablesAreCopiedDeeply) {
+  std::array<int, 32> values{};
+  values[31] = 5;
+  SmallFunction func =
+      SmallFunction::Allocate([values]() mutable { return ++values[31]; });
+  SmallFunction copy = func;
+  EXPECT_EQ(6, func());
+  EXPECT_EQ(7, func());
+  EXPECT_EQ(6, copy());
+
+  SmallFunction moved = std::move(func);
+  EXPECT_EQ(8, moved());
+}
@@ -0,0 +1,94 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cynq/execution-graph/node-queue.hpp>
+#include <thread>  // NOLINT
+#include <vector>
+
+using namespace cynq;  // NOLINT
+
+TEST(NodeQueue, FifoOrder) {
+  NodeQueue<int> queue{8};
+  for (int i = 0; i < 5; ++i) {
+    const size_t ticket = queue.Push([i](int &item, size_t) { item = i; });
+    EXPECT_EQ(static_cast<size_t>(i), ticket);
+  }
+
+  ASSERT_NE(nullptr, queue.Front());
+  EXPECT_EQ(0, *queue.Front());
+  for (int i = 0; i < 5; ++i) {
+    int item = -1;
+    ASSERT_TRUE(queue.Pop(item));
+    EXPECT_EQ(i, item);
+  }
+
+  int item = -1;
+  EXPECT_FALSE(queue.Pop(item));
+  EXPECT_EQ(nullptr, queue.Front());
+}
+
+TEST(NodeQueue, TryPushFailsWhenFull) {
+  NodeQueue<int> queue{4};
+  size_t ticket = 0;
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.TryPush([i](int &item, size_t) { item = i; }, ticket));
+  }
+  EXPECT_FALSE(queue.TryPush([](int &item, size_t) { item = 4; }, ticket));
+
+  /* Popping releases a slot */
+  int item = -1;
+  ASSERT_TRUE(queue.Pop(item));
+  EXPECT_TRUE(queue.TryPush([](int &item, size_t) { item = 4; }, ticket));
+  EXPECT_EQ(4u, ticket);
+}
+
+TEST(NodeQueue, WrapsAround) {
+  NodeQueue<size_t> queue{2};
+  for (size_t i = 0; i < 100; ++i) {
+    const size_t ticket =
+        queue.Push([](size_t &item, size_t pos) { item = pos; });
+    size_t item = 0;
+    ASSERT_TRUE(queue.Pop(item));
+    EXPECT_EQ(ticket, item);
+  }
+}
+
+TEST(NodeQueue, ConcurrentProducers) {
+  constexpr int kProducers = 4;
+  constexpr int kItems = 10000;
+  NodeQueue<int> queue{64};
+
+  std::vector<std::thread> producers;
+  for (int p = 0; p < kProducers; ++p) {
+    producers.emplace_back([&queue, p]() {
+      for (int i = 0; i < kItems; ++i) {
+        queue.Push([p, i](int &item, size_t) { item = p * kItems + i; });
+      }
+    });
+  }
+
+  /* The items of each producer keep their order */
+  std::vector<int> last(kProducers, -1);
+  int popped = 0;
+  while (popped < kProducers * kItems) {
+    int item = 0;
+    if (!queue.Pop(item)) {
+      std::this_thread::yield();
+      continue;
+    }
+    const int producer = item / kItems;
+    EXPECT_LT(last[producer], item % kItems);
+    last[producer] = item % kItems;
+    ++popped;
+  }
+
+  for (auto &producer : producers) {
+    producer.join();
+  }
+}
@@ -0,0 +1,50 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cynq/placement.hpp>
+#include <vector>
+
+using namespace cynq;  // NOLINT
+
+TEST(PlacementPlanner, SpreadsTheTraffic) {
+  PlacementPlanner planner;
+  planner.AddTensor("a", 1024, std::vector<int>{0, 1}, 4096);
+  planner.AddTensor("b", 1024, std::vector<int>{1, 0}, 2048);
+  planner.AddTensor("c", 1024, std::vector<int>{0, 1, 1}, 1024);
+
+  std::vector<PlacementBankUsage> usage;
+  ASSERT_EQ(Status::OK, planner.Plan(usage).code);
+  ASSERT_EQ(2u, usage.size());
+  EXPECT_EQ(0, planner.Tensors()[0].bank);
+  EXPECT_EQ(1, planner.Tensors()[1].bank);
+  EXPECT_EQ(1, planner.Tensors()[2].bank);
+  EXPECT_EQ(2u, planner.Tensors()[2].candidates.size());
+}
+
+TEST(PlacementPlanner, HonoursTheBankCapacity) {
+  PlacementPlanner planner;
+  planner.AddTensor("a", 1024, std::vector<int>{0, 1}, 4096);
+  planner.AddTensor("b", 1024, std::vector<int>{0, 1}, 2048);
+  planner.SetBankCapacity(1, 512);
+
+  std::vector<PlacementBankUsage> usage;
+  ASSERT_EQ(Status::OK, planner.Plan(usage).code);
+  ASSERT_EQ(1u, usage.size());
+  EXPECT_EQ(0, usage[0].bank);
+  EXPECT_EQ(2048u, usage[0].bytes);
+
+  planner.SetBankCapacity(0, 1536);
+  EXPECT_EQ(Status::OUT_OF_MEMORY, planner.Plan(usage).code);
+  EXPECT_TRUE(usage.empty());
+  EXPECT_EQ(-1, planner.Tensors()[0].bank);
+
+  planner.SetBankCapacity(1, 0);
+  ASSERT_EQ(Status::OK, planner.Plan(usage).code);
+  EXPECT_EQ(2u, usage.size());
+}
@@ -0,0 +1,102 @@
+/*
+ * See LICENSE for more information about licensing
+ *
+ * Copyright 2024
+ * Author: Luis G. Leon-Vega <luis.leon@ieee.org>
+ *
+ */
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cynq/memory.hpp>
+#include <cynq/tensor.hpp>
+#include <memory>
+#include <vector>
+
+using namespace cynq;  // NOLINT
+
+/* Host-only memory to back the tensors */
+class MockMemory : public IMemory {
+ public:
+  explicit MockMemory(const size_t size)
+      : data_{new uint8_t[size](), std::default_delete<uint8_t[]>()},
+        size_{size} {}
+  Status Sync(const SyncType) override { return Status{}; }
+  size_t Size() override { return size_; }
+  std::shared_ptr<uint8_t> GetHostAddress() override { return data_; }
+  std::shared_ptr<uint8_t> GetDeviceAddress() override { return nullptr; }
+
+ private:
+  std::shared_ptr<uint8_t> data_;
+  size_t size_;
+};
+
+TEST(TensorSegments, ContiguousTensorIsASingleSegment) {
+  auto mem = std::make_shared<MockMemory>(4 * 8 * sizeof(float));
+  Tensor<float, 2> tensor{mem, {4, 8}};
+  auto segments = tensor.Segments();
+  ASSERT_EQ(1u, segments.size());
+  EXPECT_EQ(mem, segments[0].mem);
+  EXPECT_EQ(4 * 8 * sizeof(float), segments[0].size);
+  EXPECT_EQ(0u, segments[0].offset);
+}
+
+TEST(TensorSegments, SliceOfColumnsHasOneSegmentPerRow) {
+  auto mem = std::make_shared<MockMemory>(4 * 8 * sizeof(float));
+  Tensor<float, 2> tensor{mem, {4, 8}};
+  auto segments = tensor.Slice(1, 2, 6).Segments();
+  ASSERT_EQ(4u, segments.size());
+  for (size_t row = 0; row < segments.size(); ++row) {
+    EXPECT_EQ(4 * sizeof(float), segments[row].size);
+    EXPECT_EQ((row * 8 + 2) * sizeof(float), segments[row].offset);
+  }
+}
+
+TEST(TensorSegments, SliceOfRowsIsContiguous) {
+  auto mem = std::make_shared<MockMemory>(4 * 8 * sizeof(float));
+  Tensor<float, 2> tensor{mem, {4, 8}};
+  auto segments = tensor.Slice(0, 1, 3).Segments();
+  ASSERT_EQ(1u, segments.size());
+  EXPECT_EQ(2 * 8 * sizeof(float), segments[0].size);
+  EXPECT_EQ(8 * sizeof(float), segments[0].offset);
+}
+
+TEST(TensorSegments, SelectOfAColumnHasOneElementPerSegment) {
+  auto mem = std::make_shared<MockMemory>(3 * 5 * sizeof(uint16_t));
+  Tensor<uint16_t, 2> tensor{mem, {3, 5}};
+  auto segments = tensor.Select(1, 4).Segments();
+  ASSERT_EQ(3u, segments.size());
+  for (size_t row = 0; row < segments.size(); ++row) {
+    EXPECT_EQ(sizeof(uint16_t), segments[row].size);
+    EXPECT_EQ((row * 5 + 4) * sizeof(uint16_t), segments[row].offset);
+  }
+}
+
+TEST(TensorSegments, EmptyTensorHasNoSegments) {
+  auto mem = std::make_shared<MockMemory>(4 * 8 * sizeof(float));
+  Tensor<float, 2> tensor{mem, {4, 8}};
+  EXPECT_TRUE(tensor.Slice(1, 3, 3).Segments().empty());
+}
+
+TEST(Tensor, SelectOutOfRangeIsNotValid) {
+  auto mem = std::make_shared<MockMemory>(4 * 8 * sizeof(float));
+  Tensor<float, 2> tensor{mem, {4, 8}};
+  EXPECT_TRUE(tensor.Select(0, 3).Valid());
+  EXPECT_FALSE(tensor.Select(0, 4).Valid());
+  EXPECT_FALSE(tensor.Select(2, 0).Valid());
+  EXPECT_TRUE(tensor.Select(0, 4).Segments().empty());
+}
+
+TEST(Tensor, TransfersRejectInvalidTensors) {
+  auto mem = std::make_shared<MockMemory>(4 * sizeof(float));
+  Tensor<float, 1> tensor{mem, {8}};
+  EXPECT_FALSE(tensor.Valid());
+  EXPECT_EQ(Status::INVALID_PARAMETER,
+            tensor.Sync(SyncType::HostToDevice).code);
+  EXPECT_EQ(Status::INVALID_PARAMETER, tensor.Upload(nullptr).code);
+  EXPECT_EQ(Status::INVALID_PARAMETER, tensor.Download(nullptr).code);
+
+  Tensor<float, 1> empty;
+  EXPECT_EQ(Status::INVALID_PARAMETER,
+            empty.Sync(SyncType::DeviceToHost).code);
+}